@@ -3,18 +3,66 @@
 module shake_sha2_ip_v1_0_S00_AXI #
 (
     // Users to add parameters here
-
+    // 1: M00_AXI goes to the ACP (coherent), 0: to an HP port
+    parameter integer C_M00_AXI_COHERENT = 0,
+    // Width of M00_AXI address bus
+    parameter integer C_M00_AXI_ADDR_WIDTH = 32,
+    // Width of M00_AXI data bus
+    parameter integer C_M00_AXI_DATA_WIDTH = 32,
+    // Keccak rounds per clock: 1, 2, 3, 4, 6, 8, 12 or 24
+    parameter integer C_KECCAK_ROUNDS_PER_CYCLE = 1,
+    // SHA-2 rounds per clock: 1, 2 or 4
+    parameter integer C_SHA2_ROUNDS_PER_CYCLE = 1,
+    // 1: hash core on its own clock (core_clk) behind CDC FIFOs, 0: on S_AXI_ACLK
+    parameter integer C_CORE_ASYNC_CLOCK = 0,
     // User parameters ends
     // Do not modify the parameters beyond this line
 
     // Width of S_AXI data bus
     parameter integer C_S_AXI_DATA_WIDTH = 32,
     // Width of S_AXI address bus
-    parameter integer C_S_AXI_ADDR_WIDTH = 8
+    parameter integer C_S_AXI_ADDR_WIDTH = 9
 )
 (
     // Users to add ports here
-
+    // AXI4 master of the descriptor-ring engine (shake_sha2_dma)
+    output wire [C_M00_AXI_ADDR_WIDTH-1 : 0] m00_axi_awaddr,
+    output wire [7 : 0] m00_axi_awlen,
+    output wire [2 : 0] m00_axi_awsize,
+    output wire [1 : 0] m00_axi_awburst,
+    output wire  m00_axi_awlock,
+    output wire [3 : 0] m00_axi_awcache,
+    output wire [2 : 0] m00_axi_awprot,
+    output wire [3 : 0] m00_axi_awqos,
+    output wire [4 : 0] m00_axi_awuser,
+    output wire  m00_axi_awvalid,
+    input wire  m00_axi_awready,
+    output wire [C_M00_AXI_DATA_WIDTH-1 : 0] m00_axi_wdata,
+    output wire [C_M00_AXI_DATA_WIDTH/8-1 : 0] m00_axi_wstrb,
+    output wire  m00_axi_wlast,
+    output wire  m00_axi_wvalid,
+    input wire  m00_axi_wready,
+    input wire [1 : 0] m00_axi_bresp,
+    input wire  m00_axi_bvalid,
+    output wire  m00_axi_bready,
+    output wire [C_M00_AXI_ADDR_WIDTH-1 : 0] m00_axi_araddr,
+    output wire [7 : 0] m00_axi_arlen,
+    output wire [2 : 0] m00_axi_arsize,
+    output wire [1 : 0] m00_axi_arburst,
+    output wire  m00_axi_arlock,
+    output wire [3 : 0] m00_axi_arcache,
+    output wire [2 : 0] m00_axi_arprot,
+    output wire [3 : 0] m00_axi_arqos,
+    output wire [4 : 0] m00_axi_aruser,
+    output wire  m00_axi_arvalid,
+    input wire  m00_axi_arready,
+    input wire [C_M00_AXI_DATA_WIDTH-1 : 0] m00_axi_rdata,
+    input wire [1 : 0] m00_axi_rresp,
+    input wire  m00_axi_rlast,
+    input wire  m00_axi_rvalid,
+    output wire  m00_axi_rready,
+    // Hash core clock, used when C_CORE_ASYNC_CLOCK = 1
+    input wire  core_clk,
     // User ports ends
     // Do not modify the ports beyond this line
 
@@ -98,11 +146,11 @@ reg  axi_rvalid;
 // ADDR_LSB = 2 for 32 bits (n downto 2)
 // ADDR_LSB = 3 for 64 bits (n downto 3)
 localparam integer ADDR_LSB = (C_S_AXI_DATA_WIDTH/32) + 1;
-localparam integer OPT_MEM_ADDR_BITS = 5;
+localparam integer OPT_MEM_ADDR_BITS = 6;
 //----------------------------------------------
 //-- Signals for user logic register space example
 //------------------------------------------------
-//-- Number of Slave Registers 52
+//-- Number of Slave Registers 58
 reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg0;  // Control: algo_mode, start, hold
 reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg1;  // SHAKE din_i low 32-bit
 reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg2;  // SHAKE din_i high 32-bit
@@ -114,6 +162,34 @@ reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg7;  // Status: state, valid, busy, ready, ov
 reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg8;  // SHA2 oid (read-only)
 reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg9;  // SHA2 olen low (read-only)
 reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg10; // SHA2 olen high (read-only)
+reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg64; // DMA ring base (64-byte aligned)
+reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg65; // DMA control: enable, log2 ring entries [11:8]
+reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg66; // DMA producer index (doorbell)
+reg [C_S_AXI_DATA_WIDTH-1:0] slv_reg68; // DMA completion write-back address (0: none)
+wire [15:0] dma_cons_idx;               // DMA consumer index (read-only)
+wire dma_busy;                          // DMA status (read-only): busy, error, error code
+wire dma_error;
+wire [2:0] dma_error_code;
+// SHA2 completion FIFO (0x48-0x5F): tagged results, head entry readable
+localparam SHA2_CMPL_DEPTH = 4;
+reg [31:0]  sha2_cmpl_oid [0:SHA2_CMPL_DEPTH-1];
+reg [31:0]  sha2_cmpl_len [0:SHA2_CMPL_DEPTH-1];
+reg [511:0] sha2_cmpl_sha [0:SHA2_CMPL_DEPTH-1];
+reg [1:0]   sha2_cmpl_wr;
+reg [1:0]   sha2_cmpl_rd;
+reg [2:0]   sha2_cmpl_count;
+reg         sha2_cmpl_overflow;
+reg         sha2_cmpl_pop;          // write 0x4B bit0, one clock
+reg         sha2_cmpl_flush;        // write 0x4B bit1, one clock
+wire [511:0] sha2_cmpl_head = sha2_cmpl_sha[sha2_cmpl_rd];
+// Performance counters (0x35-0x3F): free-running, read through a snapshot
+localparam PERF_COUNT = 10;
+reg [31:0]  perf_live [0:PERF_COUNT-1];
+reg [31:0]  perf_shadow [0:PERF_COUNT-1];
+reg [31:0]  perf_dout_pending;      // dout_ready wait not yet ended by a request
+reg         perf_dout_ready_d;
+reg         perf_snapshot;          // write 0x35 bit0, one clock
+reg         perf_clear;             // write 0x35 bit1, one clock
 
  // Result registers (42 registers for 1344 bits)
     reg [C_S_AXI_DATA_WIDTH-1:0] result_regs [0:41];
@@ -237,8 +313,20 @@ begin
       slv_reg4 <= 0;
       slv_reg5 <= 0;
       slv_reg6 <= 0;
+      slv_reg64 <= 0;
+      slv_reg65 <= 0;
+      slv_reg66 <= 0;
+      slv_reg68 <= 0;
+      sha2_cmpl_pop <= 0;
+      sha2_cmpl_flush <= 0;
+      perf_snapshot <= 0;
+      perf_clear <= 0;
     end 
   else begin
+    sha2_cmpl_pop <= 1'b0;
+    sha2_cmpl_flush <= 1'b0;
+    perf_snapshot <= 1'b0;
+    perf_clear <= 1'b0;
     if (slv_reg_wren)
       begin
         case ( axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] )
@@ -285,6 +373,42 @@ begin
                 // SHA2 tvalid, tlast
                 slv_reg6[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
               end  
+          6'h35:
+            begin
+              // Performance counters: snapshot, clear
+              perf_snapshot <= S_AXI_WDATA[0];
+              perf_clear <= S_AXI_WDATA[1];
+            end
+          7'h40:
+            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                // DMA ring base
+                slv_reg64[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+              end  
+          7'h41:
+            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                // DMA control
+                slv_reg65[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+              end  
+          7'h42:
+            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                // DMA producer index
+                slv_reg66[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+              end  
+          7'h44:
+            for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+              if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                // DMA completion address
+                slv_reg68[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+              end  
+          7'h4B:
+            begin
+              // SHA2 completion FIFO: pop, flush
+              sha2_cmpl_pop <= S_AXI_WDATA[0];
+              sha2_cmpl_flush <= S_AXI_WDATA[1];
+            end
           default : begin
                       slv_reg0 <= slv_reg0;
                       slv_reg1 <= slv_reg1;
@@ -293,6 +417,10 @@ begin
                       slv_reg4 <= slv_reg4;
                       slv_reg5 <= slv_reg5;
                       slv_reg6 <= slv_reg6;
+                      slv_reg64 <= slv_reg64;
+                      slv_reg65 <= slv_reg65;
+                      slv_reg66 <= slv_reg66;
+                      slv_reg68 <= slv_reg68;
                     end
         endcase
       end
@@ -412,10 +540,26 @@ begin
         6'h08   : reg_data_out <= slv_reg8;
         6'h09   : reg_data_out <= slv_reg9;
         6'h0A   : reg_data_out <= slv_reg10;
+        7'h40   : reg_data_out <= slv_reg64;
+        7'h41   : reg_data_out <= slv_reg65;
+        7'h42   : reg_data_out <= slv_reg66;
+        7'h43   : reg_data_out <= {16'h0, dma_cons_idx};
+        7'h44   : reg_data_out <= slv_reg68;
+        7'h45   : reg_data_out <= {25'h0, dma_error_code, 2'b0, dma_error, dma_busy};
+        7'h48   : reg_data_out <= {22'h0, sha2_cmpl_overflow, 6'h0, sha2_cmpl_count};
+        7'h49   : reg_data_out <= sha2_cmpl_oid[sha2_cmpl_rd];
+        7'h4A   : reg_data_out <= sha2_cmpl_len[sha2_cmpl_rd];
           default : begin
                 if (axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] >= 6'h0B && 
                     axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] <= 6'h34) begin 
                     reg_data_out <= result_regs[axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] - 6'h0B];
+                end else if (axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] >= 6'h36 &&
+                             axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] <= 6'h3F) begin
+                    reg_data_out <= perf_shadow[axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] - 6'h36];
+                end else if (axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] >= 7'h50 &&
+                             axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] <= 7'h5F) begin
+                    // Digest word k, first byte in the MSB of word 0
+                    reg_data_out <= sha2_cmpl_head[(4'd15 - axi_araddr[ADDR_LSB+3:ADDR_LSB])*32 +: 32];
                 end else begin
                     reg_data_out <= 0;
                 end
@@ -462,6 +606,23 @@ wire dout_valid;
 wire sha2_ovalid;
 wire [31:0] sha2_oid;
 wire [60:0] sha2_olen;
+wire shake_din_ready;     // From module
+wire cmd_overflow;        // CDC command FIFO overrun (sticky)
+wire res_overflow;        // CDC result FIFO overrun (sticky)
+wire [2:0] keccak_perms;  // Keccak-f permutations started this clock
+
+// Descriptor-ring engine; owns the core inputs while dma_busy
+wire [3:0] dma_algo_mode;
+wire dma_sha2_tvalid;
+wire dma_sha2_tlast;
+wire [31:0] dma_sha2_tid;
+wire [7:0] dma_sha2_tdata;
+wire dma_shake_start;
+wire [63:0] dma_shake_din;
+wire dma_shake_din_valid;
+wire dma_shake_last_din;
+wire [3:0] dma_shake_last_din_byte;
+wire dma_shake_dout_ready;
 
 // Internal signals
 reg [2:0] current_state;  // Simplified state tracking
@@ -474,22 +635,22 @@ reg [31:0] sha2_olen_low;       // Low 32-bit of sha2_olen
 reg [28:0] sha2_olen_high;      // High 29-bit (61-bit total)
 integer i;
 
-// Extract control signals from AXI registers
-assign algo_mode = slv_reg0[3:0];  // algo_mode [3:0]
-assign shake_start_i = slv_reg0[4];  // Start pulse
-assign shake_hold = slv_reg0[5];     // Hold
-assign shake_din_i = {slv_reg2, slv_reg1};  // 64-bit input data
-assign shake_last_din_i = slv_reg3[0];
-assign shake_last_din_byte_i = slv_reg3[4:1];
-assign shake_din_valid_i = slv_reg3[5];  // Valid signal
-assign shake_dout_ready_i = slv_reg3[6]; // Ready request
+// Extract control signals from AXI registers (or the DMA engine while it runs a job)
+assign algo_mode = dma_busy ? dma_algo_mode : slv_reg0[3:0];  // algo_mode [3:0]
+assign shake_start_i = dma_busy ? dma_shake_start : slv_reg0[4];  // Start pulse
+assign shake_hold = dma_busy ? 1'b0 : slv_reg0[5];     // Hold
+assign shake_din_i = dma_busy ? dma_shake_din : {slv_reg2, slv_reg1};  // 64-bit input data
+assign shake_last_din_i = dma_busy ? dma_shake_last_din : slv_reg3[0];
+assign shake_last_din_byte_i = dma_busy ? dma_shake_last_din_byte : slv_reg3[4:1];
+assign shake_din_valid_i = dma_busy ? dma_shake_din_valid : slv_reg3[5];  // Valid signal
+assign shake_dout_ready_i = dma_busy ? dma_shake_dout_ready : slv_reg3[6]; // Ready request
 
 // SHA2 signals from regs (assuming 3 bytes input)
-assign sha2_tdata = slv_reg4[7:0];   // First byte
+assign sha2_tdata = dma_busy ? dma_sha2_tdata : slv_reg4[7:0];   // First byte
 // Second and third bytes in slv_reg4[23:8], but since small input, simulate single write
-assign sha2_tid = slv_reg5;          // tid [31:0]
-assign sha2_tvalid = slv_reg6[0];    // tvalid
-assign sha2_tlast = slv_reg6[1];     // tlast
+assign sha2_tid = dma_busy ? dma_sha2_tid : slv_reg5;          // tid [31:0]
+assign sha2_tvalid = dma_busy ? dma_sha2_tvalid : slv_reg6[0];    // tvalid
+assign sha2_tlast = dma_busy ? dma_sha2_tlast : slv_reg6[1];     // tlast
 
 // Status register update (slv_reg7 for status, slv_reg8-10 for sha2_olen, slv_reg11-52 for dout)
 always @(posedge S_AXI_ACLK) begin
@@ -526,7 +687,9 @@ always @(posedge S_AXI_ACLK) begin
         slv_reg7[5] <= result_ready_flag;     // Result ready
         slv_reg7[6] <= sha2_tready;           // SHA2 tready
         slv_reg7[7] <= sha2_ovalid;           // SHA2 ovalid
-        slv_reg7[31:8] <= 24'h0;              // Reserved
+        slv_reg7[8] <= cmd_overflow;          // CDC command overrun
+        slv_reg7[9] <= res_overflow;          // CDC result overrun
+        slv_reg7[31:10] <= 22'h0;             // Reserved
         
         // SHA2 oid and olen to regs - read-only
         slv_reg8 <= sha2_oid_reg;             // sha2_oid
@@ -535,6 +698,83 @@ always @(posedge S_AXI_ACLK) begin
     end
 end
 
+// SHA2 completion FIFO: every SHA2 result outside the DMA engine is queued
+// with its oid, so several tagged messages can be in flight; a result that
+// finds the FIFO full is dropped and sets the overflow flag
+wire sha2_cmpl_take = sha2_cmpl_pop && sha2_cmpl_count != 0;
+wire sha2_cmpl_push = sha2_ovalid && !dma_busy &&
+                      (sha2_cmpl_count != SHA2_CMPL_DEPTH || sha2_cmpl_take);
+
+always @(posedge S_AXI_ACLK) begin
+    if (S_AXI_ARESETN == 1'b0 || sha2_cmpl_flush) begin
+        sha2_cmpl_wr <= 2'd0;
+        sha2_cmpl_rd <= 2'd0;
+        sha2_cmpl_count <= 3'd0;
+        sha2_cmpl_overflow <= 1'b0;
+    end else begin
+        if (sha2_cmpl_push) begin
+            sha2_cmpl_oid[sha2_cmpl_wr] <= sha2_oid;
+            sha2_cmpl_len[sha2_cmpl_wr] <= sha2_olen[31:0];
+            sha2_cmpl_sha[sha2_cmpl_wr] <= dout[1343 -: 512];
+            sha2_cmpl_wr <= sha2_cmpl_wr + 2'd1;
+        end else if (sha2_ovalid && !dma_busy) begin
+            sha2_cmpl_overflow <= 1'b1;
+        end
+        if (sha2_cmpl_take)
+            sha2_cmpl_rd <= sha2_cmpl_rd + 2'd1;
+        sha2_cmpl_count <= sha2_cmpl_count + {2'd0, sha2_cmpl_push} - {2'd0, sha2_cmpl_take};
+    end
+end
+
+// Performance counters, for telling how much of the time the core works and
+// how much it waits on software. Snapshot copies the live counts to the
+// registers read at 0x36-0x3F; clear zeroes the live counts after that copy.
+//   0 busy clocks (busy flag or DMA engine)   5 S_AXI read beats
+//   1 idle clocks                             6 clocks a SHAKE output waits for dout_ready
+//   2 Keccak-f permutations                   7 busy clocks the core takes no input
+//   3 SHA-2 blocks                            8 M00_AXI read beats
+//   4 S_AXI write beats                       9 M00_AXI write beats
+// The dout_ready wait counts from dout_valid to the next dout_ready request;
+// the wait after the last block, which nothing requests, is dropped at start.
+wire perf_busy = busy_flag | dma_busy;
+wire perf_dout_wait = algo_mode[3] & dout_valid & ~shake_dout_ready_i;
+wire perf_dout_req = shake_dout_ready_i & ~perf_dout_ready_d;
+wire [31:0] perf_sha2_blocks = algo_mode[0] ? (sha2_olen[31:0] + 32'd144) >> 7 :
+                                              (sha2_olen[31:0] + 32'd72) >> 6;
+wire [31:0] perf_inc [0:PERF_COUNT-1];
+assign perf_inc[0] = {31'd0, perf_busy};
+assign perf_inc[1] = {31'd0, ~perf_busy};
+assign perf_inc[2] = {29'd0, keccak_perms};
+assign perf_inc[3] = sha2_ovalid ? perf_sha2_blocks : 32'd0;
+assign perf_inc[4] = {31'd0, slv_reg_wren};
+assign perf_inc[5] = {31'd0, slv_reg_rden};
+assign perf_inc[6] = perf_dout_req ? perf_dout_pending : 32'd0;
+assign perf_inc[7] = {31'd0, perf_busy & (algo_mode[3] ? ~shake_din_ready : ~sha2_tready)};
+assign perf_inc[8] = {31'd0, m00_axi_rvalid & m00_axi_rready};
+assign perf_inc[9] = {31'd0, m00_axi_wvalid & m00_axi_wready};
+
+always @(posedge S_AXI_ACLK) begin
+    if (S_AXI_ARESETN == 1'b0) begin
+        perf_dout_pending <= 32'h0;
+        perf_dout_ready_d <= 1'b0;
+        for (i = 0; i < PERF_COUNT; i = i + 1) begin
+            perf_live[i] <= 32'h0;
+            perf_shadow[i] <= 32'h0;
+        end
+    end else begin
+        perf_dout_ready_d <= shake_dout_ready_i;
+        if (shake_start_i || perf_dout_req)
+            perf_dout_pending <= 32'h0;
+        else if (perf_dout_wait)
+            perf_dout_pending <= perf_dout_pending + 32'd1;
+        for (i = 0; i < PERF_COUNT; i = i + 1) begin
+            if (perf_snapshot)
+                perf_shadow[i] <= perf_live[i];
+            perf_live[i] <= (perf_clear ? 32'h0 : perf_live[i]) + perf_inc[i];
+        end
+    end
+end
+
 // Update result registers when output is valid - only first output (read-only)
 always @(posedge S_AXI_ACLK) begin
     if (S_AXI_ARESETN == 1'b0) begin
@@ -549,28 +789,142 @@ always @(posedge S_AXI_ACLK) begin
     end
 end
 
-// SHAKE/SHA2 top module instantiation
-shake_sha2_top u_shake_sha2_top (
+// SHAKE/SHA2 top module instantiation, directly on S_AXI_ACLK or behind the
+// CDC FIFOs on core_clk
+generate
+if (C_CORE_ASYNC_CLOCK) begin: core_async
+    shake_sha2_cdc #(
+        .KECCAK_ROUNDS_PER_CYCLE(C_KECCAK_ROUNDS_PER_CYCLE),
+        .SHA2_ROUNDS_PER_CYCLE(C_SHA2_ROUNDS_PER_CYCLE)
+    ) u_shake_sha2_cdc (
+        .clk(S_AXI_ACLK),
+        .rstn(S_AXI_ARESETN),
+        .algo_mode(algo_mode),
+        .sha2_tvalid(sha2_tvalid),
+        .sha2_tready(sha2_tready),
+        .sha2_tlast(sha2_tlast),
+        .sha2_tid(sha2_tid),
+        .sha2_tdata(sha2_tdata),
+        .shake_start_i(shake_start_i),
+        .shake_din_i(shake_din_i),
+        .shake_din_valid_i(shake_din_valid_i),
+        .shake_last_din_i(shake_last_din_i),
+        .shake_last_din_byte_i(shake_last_din_byte_i),
+        .shake_dout_ready_i(shake_dout_ready_i),
+        .shake_hold(shake_hold),
+        .dout(dout),
+        .dout_valid(dout_valid),
+        .sha2_ovalid(sha2_ovalid),
+        .sha2_oid(sha2_oid),
+        .sha2_olen(sha2_olen),
+        .shake_din_ready(shake_din_ready),
+        .cmd_overflow(cmd_overflow),
+        .res_overflow(res_overflow),
+        .keccak_perms(keccak_perms),
+        .core_clk(core_clk)
+    );
+end else begin: core_sync
+    wire keccak_perm;
+    shake_sha2_top #(
+        .KECCAK_ROUNDS_PER_CYCLE(C_KECCAK_ROUNDS_PER_CYCLE),
+        .SHA2_ROUNDS_PER_CYCLE(C_SHA2_ROUNDS_PER_CYCLE)
+    ) u_shake_sha2_top (
+        .clk(S_AXI_ACLK),
+        .rstn(S_AXI_ARESETN),
+        .algo_mode(algo_mode),
+        .sha2_tvalid(sha2_tvalid),
+        .sha2_tready(sha2_tready),
+        .sha2_tlast(sha2_tlast),
+        .sha2_tid(sha2_tid),
+        .sha2_tdata(sha2_tdata),
+        .shake_start_i(shake_start_i),
+        .shake_din_i(shake_din_i),
+        .shake_din_valid_i(shake_din_valid_i),
+        .shake_last_din_i(shake_last_din_i),
+        .shake_last_din_byte_i(shake_last_din_byte_i),
+        .shake_dout_ready_i(shake_dout_ready_i),
+        .shake_hold(shake_hold),
+        .dout(dout),
+        .dout_valid(dout_valid),
+        .sha2_ovalid(sha2_ovalid),
+        .sha2_oid(sha2_oid),
+        .sha2_olen(sha2_olen),
+        .shake_din_ready(shake_din_ready),
+        .keccak_perm(keccak_perm)
+    );
+    assign cmd_overflow = 1'b0;
+    assign res_overflow = 1'b0;
+    assign keccak_perms = {2'b0, keccak_perm};
+end
+endgenerate
+
+// Descriptor-ring engine (registers 0x40-0x45)
+shake_sha2_dma #(
+    .C_M_AXI_ADDR_WIDTH(C_M00_AXI_ADDR_WIDTH),
+    .C_M_AXI_DATA_WIDTH(C_M00_AXI_DATA_WIDTH),
+    .C_M_AXI_COHERENT(C_M00_AXI_COHERENT)
+) u_shake_sha2_dma (
     .clk(S_AXI_ACLK),
     .rstn(S_AXI_ARESETN),
-    .algo_mode(algo_mode),
-    .sha2_tvalid(sha2_tvalid),
-    .sha2_tready(sha2_tready),
-    .sha2_tlast(sha2_tlast),
-    .sha2_tid(sha2_tid),
-    .sha2_tdata(sha2_tdata),
-    .shake_start_i(shake_start_i),
-    .shake_din_i(shake_din_i),
-    .shake_din_valid_i(shake_din_valid_i),
-    .shake_last_din_i(shake_last_din_i),
-    .shake_last_din_byte_i(shake_last_din_byte_i),
-    .shake_dout_ready_i(shake_dout_ready_i),
-    .shake_hold(shake_hold),
-    .dout(dout),
-    .dout_valid(dout_valid),
-    .sha2_ovalid(sha2_ovalid),
-    .sha2_oid(sha2_oid),
-    .sha2_olen(sha2_olen)
+    .enable(slv_reg65[0]),
+    .ring_base(slv_reg64),
+    .ring_order(slv_reg65[11:8]),
+    .prod_idx(slv_reg66[15:0]),
+    .cmpl_addr(slv_reg68),
+    .cons_idx(dma_cons_idx),
+    .busy(dma_busy),
+    .error(dma_error),
+    .error_code(dma_error_code),
+    .core_algo_mode(dma_algo_mode),
+    .core_sha2_tvalid(dma_sha2_tvalid),
+    .core_sha2_tlast(dma_sha2_tlast),
+    .core_sha2_tid(dma_sha2_tid),
+    .core_sha2_tdata(dma_sha2_tdata),
+    .core_sha2_tready(sha2_tready),
+    .core_shake_start(dma_shake_start),
+    .core_shake_din(dma_shake_din),
+    .core_shake_din_valid(dma_shake_din_valid),
+    .core_shake_last_din(dma_shake_last_din),
+    .core_shake_last_din_byte(dma_shake_last_din_byte),
+    .core_shake_dout_ready(dma_shake_dout_ready),
+    .core_shake_din_ready(shake_din_ready),
+    .core_dout(dout),
+    .core_dout_valid(dout_valid),
+    .m_axi_awaddr(m00_axi_awaddr),
+    .m_axi_awlen(m00_axi_awlen),
+    .m_axi_awsize(m00_axi_awsize),
+    .m_axi_awburst(m00_axi_awburst),
+    .m_axi_awlock(m00_axi_awlock),
+    .m_axi_awcache(m00_axi_awcache),
+    .m_axi_awprot(m00_axi_awprot),
+    .m_axi_awqos(m00_axi_awqos),
+    .m_axi_awuser(m00_axi_awuser),
+    .m_axi_awvalid(m00_axi_awvalid),
+    .m_axi_awready(m00_axi_awready),
+    .m_axi_wdata(m00_axi_wdata),
+    .m_axi_wstrb(m00_axi_wstrb),
+    .m_axi_wlast(m00_axi_wlast),
+    .m_axi_wvalid(m00_axi_wvalid),
+    .m_axi_wready(m00_axi_wready),
+    .m_axi_bresp(m00_axi_bresp),
+    .m_axi_bvalid(m00_axi_bvalid),
+    .m_axi_bready(m00_axi_bready),
+    .m_axi_araddr(m00_axi_araddr),
+    .m_axi_arlen(m00_axi_arlen),
+    .m_axi_arsize(m00_axi_arsize),
+    .m_axi_arburst(m00_axi_arburst),
+    .m_axi_arlock(m00_axi_arlock),
+    .m_axi_arcache(m00_axi_arcache),
+    .m_axi_arprot(m00_axi_arprot),
+    .m_axi_arqos(m00_axi_arqos),
+    .m_axi_aruser(m00_axi_aruser),
+    .m_axi_arvalid(m00_axi_arvalid),
+    .m_axi_arready(m00_axi_arready),
+    .m_axi_rdata(m00_axi_rdata),
+    .m_axi_rresp(m00_axi_rresp),
+    .m_axi_rlast(m00_axi_rlast),
+    .m_axi_rvalid(m00_axi_rvalid),
+    .m_axi_rready(m00_axi_rready)
 );
 
 // Simplified state tracking (expand as needed)
@@ -7,10 +7,70 @@ proc init_gui { IPINST } {
   ipgui::add_param $IPINST -name "C_S00_AXI_ADDR_WIDTH" -parent ${Page_0}
   ipgui::add_param $IPINST -name "C_S00_AXI_BASEADDR" -parent ${Page_0}
   ipgui::add_param $IPINST -name "C_S00_AXI_HIGHADDR" -parent ${Page_0}
+  ipgui::add_param $IPINST -name "C_M00_AXI_COHERENT" -parent ${Page_0} -widget comboBox
+  ipgui::add_param $IPINST -name "C_M00_AXI_ADDR_WIDTH" -parent ${Page_0}
+  ipgui::add_param $IPINST -name "C_M00_AXI_DATA_WIDTH" -parent ${Page_0} -widget comboBox
+  ipgui::add_param $IPINST -name "C_KECCAK_ROUNDS_PER_CYCLE" -parent ${Page_0} -widget comboBox
+  ipgui::add_param $IPINST -name "C_SHA2_ROUNDS_PER_CYCLE" -parent ${Page_0} -widget comboBox
+  ipgui::add_param $IPINST -name "C_CORE_ASYNC_CLOCK" -parent ${Page_0} -widget comboBox
 
 
 }
 
+proc update_PARAM_VALUE.C_M00_AXI_COHERENT { PARAM_VALUE.C_M00_AXI_COHERENT } {
+	# Procedure called to update C_M00_AXI_COHERENT when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.C_M00_AXI_COHERENT { PARAM_VALUE.C_M00_AXI_COHERENT } {
+	# Procedure called to validate C_M00_AXI_COHERENT
+	return true
+}
+
+proc update_PARAM_VALUE.C_M00_AXI_ADDR_WIDTH { PARAM_VALUE.C_M00_AXI_ADDR_WIDTH } {
+	# Procedure called to update C_M00_AXI_ADDR_WIDTH when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.C_M00_AXI_ADDR_WIDTH { PARAM_VALUE.C_M00_AXI_ADDR_WIDTH } {
+	# Procedure called to validate C_M00_AXI_ADDR_WIDTH
+	return true
+}
+
+proc update_PARAM_VALUE.C_M00_AXI_DATA_WIDTH { PARAM_VALUE.C_M00_AXI_DATA_WIDTH } {
+	# Procedure called to update C_M00_AXI_DATA_WIDTH when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.C_M00_AXI_DATA_WIDTH { PARAM_VALUE.C_M00_AXI_DATA_WIDTH } {
+	# Procedure called to validate C_M00_AXI_DATA_WIDTH
+	return true
+}
+
+proc update_PARAM_VALUE.C_KECCAK_ROUNDS_PER_CYCLE { PARAM_VALUE.C_KECCAK_ROUNDS_PER_CYCLE } {
+	# Procedure called to update C_KECCAK_ROUNDS_PER_CYCLE when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.C_KECCAK_ROUNDS_PER_CYCLE { PARAM_VALUE.C_KECCAK_ROUNDS_PER_CYCLE } {
+	# Procedure called to validate C_KECCAK_ROUNDS_PER_CYCLE
+	return true
+}
+
+proc update_PARAM_VALUE.C_SHA2_ROUNDS_PER_CYCLE { PARAM_VALUE.C_SHA2_ROUNDS_PER_CYCLE } {
+	# Procedure called to update C_SHA2_ROUNDS_PER_CYCLE when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.C_SHA2_ROUNDS_PER_CYCLE { PARAM_VALUE.C_SHA2_ROUNDS_PER_CYCLE } {
+	# Procedure called to validate C_SHA2_ROUNDS_PER_CYCLE
+	return true
+}
+
+proc update_PARAM_VALUE.C_CORE_ASYNC_CLOCK { PARAM_VALUE.C_CORE_ASYNC_CLOCK } {
+	# Procedure called to update C_CORE_ASYNC_CLOCK when any of the dependent parameters in the arguments change
+}
+
+proc validate_PARAM_VALUE.C_CORE_ASYNC_CLOCK { PARAM_VALUE.C_CORE_ASYNC_CLOCK } {
+	# Procedure called to validate C_CORE_ASYNC_CLOCK
+	return true
+}
+
 proc update_PARAM_VALUE.C_S00_AXI_DATA_WIDTH { PARAM_VALUE.C_S00_AXI_DATA_WIDTH } {
 	# Procedure called to update C_S00_AXI_DATA_WIDTH when any of the dependent parameters in the arguments change
 }
@@ -58,3 +118,33 @@ proc update_MODELPARAM_VALUE.C_S00_AXI_ADDR_WIDTH { MODELPARAM_VALUE.C_S00_AXI_A
 	set_property value [get_property value ${PARAM_VALUE.C_S00_AXI_ADDR_WIDTH}] ${MODELPARAM_VALUE.C_S00_AXI_ADDR_WIDTH}
 }
 
+proc update_MODELPARAM_VALUE.C_M00_AXI_COHERENT { MODELPARAM_VALUE.C_M00_AXI_COHERENT PARAM_VALUE.C_M00_AXI_COHERENT } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.C_M00_AXI_COHERENT}] ${MODELPARAM_VALUE.C_M00_AXI_COHERENT}
+}
+
+proc update_MODELPARAM_VALUE.C_M00_AXI_ADDR_WIDTH { MODELPARAM_VALUE.C_M00_AXI_ADDR_WIDTH PARAM_VALUE.C_M00_AXI_ADDR_WIDTH } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.C_M00_AXI_ADDR_WIDTH}] ${MODELPARAM_VALUE.C_M00_AXI_ADDR_WIDTH}
+}
+
+proc update_MODELPARAM_VALUE.C_M00_AXI_DATA_WIDTH { MODELPARAM_VALUE.C_M00_AXI_DATA_WIDTH PARAM_VALUE.C_M00_AXI_DATA_WIDTH } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.C_M00_AXI_DATA_WIDTH}] ${MODELPARAM_VALUE.C_M00_AXI_DATA_WIDTH}
+}
+
+proc update_MODELPARAM_VALUE.C_KECCAK_ROUNDS_PER_CYCLE { MODELPARAM_VALUE.C_KECCAK_ROUNDS_PER_CYCLE PARAM_VALUE.C_KECCAK_ROUNDS_PER_CYCLE } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.C_KECCAK_ROUNDS_PER_CYCLE}] ${MODELPARAM_VALUE.C_KECCAK_ROUNDS_PER_CYCLE}
+}
+
+proc update_MODELPARAM_VALUE.C_SHA2_ROUNDS_PER_CYCLE { MODELPARAM_VALUE.C_SHA2_ROUNDS_PER_CYCLE PARAM_VALUE.C_SHA2_ROUNDS_PER_CYCLE } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.C_SHA2_ROUNDS_PER_CYCLE}] ${MODELPARAM_VALUE.C_SHA2_ROUNDS_PER_CYCLE}
+}
+
+proc update_MODELPARAM_VALUE.C_CORE_ASYNC_CLOCK { MODELPARAM_VALUE.C_CORE_ASYNC_CLOCK PARAM_VALUE.C_CORE_ASYNC_CLOCK } {
+	# Procedure called to set VHDL generic/Verilog parameter value(s) based on TCL parameter value
+	set_property value [get_property value ${PARAM_VALUE.C_CORE_ASYNC_CLOCK}] ${MODELPARAM_VALUE.C_CORE_ASYNC_CLOCK}
+}
+
@@ -0,0 +1,93 @@
+`timescale 1 ns / 1 ps
+//--------------------------------------------------------------------------------------------------------
+// Module  : async_fifo
+// Type    : synthesizable
+// Standard: Verilog 2001 (IEEE1364-2001)
+// Function: Dual-clock FIFO of 2^ADDR_BITS entries. Gray-coded pointers cross the clock domains
+//           through two-flop synchronizers, so wr_full/wr_free and rd_empty are pessimistic by the
+//           synchronizer delay but never wrong. rd_data shows the head entry while rd_empty is low.
+//--------------------------------------------------------------------------------------------------------
+
+module async_fifo #(
+    parameter integer WIDTH     = 8,
+    parameter integer ADDR_BITS = 4
+)(
+    // Write side
+    input  wire                      wr_clk,
+    input  wire                      wr_rstn,
+    input  wire                      wr_en,
+    input  wire  [WIDTH-1:0]         wr_data,
+    output wire                      wr_full,
+    output wire  [ADDR_BITS:0]       wr_free,       // free entries
+
+    // Read side
+    input  wire                      rd_clk,
+    input  wire                      rd_rstn,
+    input  wire                      rd_en,
+    output wire  [WIDTH-1:0]         rd_data,
+    output wire                      rd_empty
+);
+
+function [ADDR_BITS:0] gray2bin;
+    input [ADDR_BITS:0] g;
+    integer b;
+    begin
+        gray2bin[ADDR_BITS] = g[ADDR_BITS];
+        for (b = ADDR_BITS-1; b >= 0; b = b - 1)
+            gray2bin[b] = gray2bin[b+1] ^ g[b];
+    end
+endfunction
+
+reg     [WIDTH-1:0]     mem [0:(1<<ADDR_BITS)-1];
+
+reg     [ADDR_BITS:0]   wr_bin, wr_gray;
+reg     [ADDR_BITS:0]   rd_bin, rd_gray;
+(* ASYNC_REG = "TRUE" *) reg [ADDR_BITS:0] rd_gray_w1, rd_gray_w2;   // rd_gray in the write domain
+(* ASYNC_REG = "TRUE" *) reg [ADDR_BITS:0] wr_gray_r1, wr_gray_r2;   // wr_gray in the read domain
+
+wire    [ADDR_BITS:0]   wr_bin_next = wr_bin + 1'b1;
+wire    [ADDR_BITS:0]   rd_bin_next = rd_bin + 1'b1;
+
+assign wr_free  = (1 << ADDR_BITS) - (wr_bin - gray2bin(rd_gray_w2));
+assign wr_full  = wr_free == 0;
+assign rd_empty = rd_gray == wr_gray_r2;
+assign rd_data  = mem[rd_bin[ADDR_BITS-1:0]];
+
+always @(posedge wr_clk)
+if(!wr_rstn) begin
+  wr_bin     <= 0;
+  wr_gray    <= 0;
+  rd_gray_w1 <= 0;
+  rd_gray_w2 <= 0;
+end
+else begin
+  rd_gray_w1 <= rd_gray;
+  rd_gray_w2 <= rd_gray_w1;
+  if(wr_en & ~wr_full) begin
+    wr_bin  <= wr_bin_next;
+    wr_gray <= wr_bin_next ^ (wr_bin_next >> 1);
+  end
+end
+
+// Storage, no reset
+always @(posedge wr_clk)
+if(wr_en & ~wr_full)
+  mem[wr_bin[ADDR_BITS-1:0]] <= wr_data;
+
+always @(posedge rd_clk)
+if(!rd_rstn) begin
+  rd_bin     <= 0;
+  rd_gray    <= 0;
+  wr_gray_r1 <= 0;
+  wr_gray_r2 <= 0;
+end
+else begin
+  wr_gray_r1 <= wr_gray;
+  wr_gray_r2 <= wr_gray_r1;
+  if(rd_en & ~rd_empty) begin
+    rd_bin  <= rd_bin_next;
+    rd_gray <= rd_bin_next ^ (rd_bin_next >> 1);
+  end
+end
+
+endmodule
@@ -4,9 +4,13 @@
 // Standard: Verilog 2001 (IEEE1364-2001)
 // Function: SHA-256 Hash Calculator with AXI-Stream Interface
 //           Converted from SystemVerilog to Verilog
+//           ROUNDS_PER_CYCLE (1, 2 or 4) compression rounds per clock: 64, 32
+//           or 16 clocks per block once the last byte is buffered
 //--------------------------------------------------------------------------------------------------------
 
-module sha256(
+module sha256 #(
+    parameter ROUNDS_PER_CYCLE = 1
+)(
     input  wire         rstn,
     input  wire         clk,
     input  wire         tvalid,
@@ -57,6 +61,42 @@ function [31:0] BSIG1;
     end
 endfunction
 
+// Carry-save adder: a + b + c = CSA_S + CSA_C
+function [31:0] CSA_S;
+    input [31:0] a, b, c;
+    begin
+        CSA_S = a ^ b ^ c;
+    end
+endfunction
+
+function [31:0] CSA_C;
+    input [31:0] a, b, c;
+    begin
+        CSA_C = ((a & b) | (a & c) | (b & c)) << 1;
+    end
+endfunction
+
+// One round on {a,b,c,d,e,f,g,h}, hk = h + K[t] + W[t]. T1 stays in
+// carry-save form, so each of e' and a' takes a single carry-propagate add.
+function [255:0] ROUND;
+    input [255:0] s;
+    input [31:0]  hk;
+    reg   [31:0]  a, b, c, d, e, f, g;
+    reg   [31:0]  t1s, t1c, es, ec, as, ac;
+    begin
+        {a,b,c,d,e,f,g} = s[255:32];
+        t1s = CSA_S(hk, BSIG1(e), (e & f) ^ (~e & g));
+        t1c = CSA_C(hk, BSIG1(e), (e & f) ^ (~e & g));
+        es  = CSA_S(d, t1s, t1c);
+        ec  = CSA_C(d, t1s, t1c);
+        as  = CSA_S(t1s, t1c, BSIG0(a));
+        ac  = CSA_C(t1s, t1c, BSIG0(a));
+        ROUND = {CSA_S(as, ac, (a & b) ^ (a & c) ^ (b & c)) +
+                 CSA_C(as, ac, (a & b) ^ (a & c) ^ (b & c)),
+                 a, b, c, es + ec, e, f, g};
+    end
+endfunction
+
 // K constants (64 x 32-bit)
 wire [31:0] k [0:63];
 assign k[ 0] = 32'h428a2f98;
@@ -142,6 +182,21 @@ assign hinit[7] = 32'h5be0cd19;
 reg [31:0] w [0:15];
 reg [ 7:0] buff [0:63];
 
+// Last mcnt of a block
+localparam [5:0] LAST_CNT = 64/ROUNDS_PER_CYCLE - 1;
+
+// LAST_CNT is only exact for 1, 2 or 4 rounds per clock; stop elaboration otherwise
+// (Verilator resolves cells in untaken branches too, so there it stops at time 0)
+generate
+    if(ROUNDS_PER_CYCLE != 1 && ROUNDS_PER_CYCLE != 2 && ROUNDS_PER_CYCLE != 4) begin : bad_rounds_per_cycle
+`ifdef VERILATOR
+        initial $fatal(1, "sha256: ROUNDS_PER_CYCLE must be 1, 2 or 4");
+`else
+        sha256_ROUNDS_PER_CYCLE_must_be_1_2_or_4 bad_parameter();
+`endif
+    end
+endgenerate
+
 // State machine and counters
 reg  [2:0] status;
 reg  [60:0] cnt;
@@ -176,17 +231,19 @@ reg [31:0] wid;
 reg [60:0] wlen;
 reg        wstart;
 reg        wfinal;
-reg [31:0] wadder;
+reg [32*ROUNDS_PER_CYCLE-1:0] wadder;  // K[t+r] at [32*r +: 32]
 reg        wkinit;
 reg        wken;
 reg        wklast;
 reg [31:0] wkid;
 reg [60:0] wklen;
 reg        wkstart;
-reg [31:0] wk;
+reg [32*ROUNDS_PER_CYCLE-1:0] wk;      // W[t+r] + K[t+r] at [32*r +: 32]
 
-// Temporary variables for hash computation
-reg [31:0] t1, t2;
+// Temporary variables for the schedule and hash computation
+reg [31:0]  wx [0:15+ROUNDS_PER_CYCLE];  // W[t-16] .. W[t+ROUNDS_PER_CYCLE-1]
+reg [ 5:0]  widx;
+reg [255:0] hround;
 
 // Control signals
 assign tready = (status==IDLE) || (status==RUN);
@@ -196,7 +253,7 @@ assign iinit  = (status==IDLE) & tvalid_posedge;
 assign tvalid_posedge = tvalid & ~tvalid_d;
 
 // Initialize registers
-integer i;
+integer i, r;
 initial begin
     status = IDLE;
     cnt = 61'd0;
@@ -366,7 +423,7 @@ always @ (posedge clk or negedge rstn)
             mlen  <= ilen;
             mcnt  <= 6'd0;
         end else begin
-            if(mcnt==6'h3f) begin
+            if(mcnt==LAST_CNT) begin
                 men   <= 1'b0;
                 mlast <= 1'b0;
             end
@@ -390,23 +447,28 @@ always @ (posedge clk or negedge rstn)
     end else begin
         winit  <= minit;
         wen    <= men;
-        wlast  <= mlast & (mcnt==6'h3f);
+        wlast  <= mlast & (mcnt==LAST_CNT);
         wid    <= mid;
         wlen   <= mlen;
         wstart <= men & (mcnt==6'h00);
-        wfinal <= men & (mcnt==6'h3f);
-        wadder <= k[mcnt];
-        if(mcnt<6'd16) begin
-            // Load W from buffer
-            w[0] <= {buff[{mcnt[3:0],2'd0}],
-                     buff[{mcnt[3:0],2'd1}],
-                     buff[{mcnt[3:0],2'd2}],
-                     buff[{mcnt[3:0],2'd3}]};
-        end else begin
-            // Calculate W from previous values
-            w[0] <= SSIG1(w[1]) + w[6] + SSIG0(w[14]) + w[15];
+        wfinal <= men & (mcnt==LAST_CNT);
+        // W[t+r], t = ROUNDS_PER_CYCLE*mcnt, goes to wx[16+r]; w[0] is the newest
+        for(i=0; i<16; i=i+1) wx[i] = w[15-i];
+        for(r=0; r<ROUNDS_PER_CYCLE; r=r+1) begin
+            widx = ROUNDS_PER_CYCLE*mcnt + r;
+            wadder[32*r +: 32] <= k[widx];
+            if(widx<6'd16) begin
+                // Load W from buffer
+                wx[16+r] = {buff[{widx[3:0],2'd0}],
+                            buff[{widx[3:0],2'd1}],
+                            buff[{widx[3:0],2'd2}],
+                            buff[{widx[3:0],2'd3}]};
+            end else begin
+                // Calculate W from previous values
+                wx[16+r] = SSIG1(wx[14+r]) + wx[9+r] + SSIG0(wx[1+r]) + wx[r];
+            end
         end
-        for(i=1; i<16; i=i+1) w[i] <= w[i-1];
+        for(i=0; i<16; i=i+1) w[i] <= wx[15+ROUNDS_PER_CYCLE-i];
     end
 
 // Pipeline stage: Add K constant
@@ -426,7 +488,8 @@ always @ (posedge clk or negedge rstn)
         wkid   <= wid;
         wklen  <= wlen;
         wkstart <= wstart;
-        wk <= w[0] + wadder;
+        for(r=0; r<ROUNDS_PER_CYCLE; r=r+1)
+            wk[32*r +: 32] <= w[ROUNDS_PER_CYCLE-1-r] + wadder[32*r +: 32];
     end
 
 // Save hash values at block start
@@ -458,16 +521,12 @@ always @ (posedge clk or negedge rstn)
         if(wkinit) begin
             for(i=0; i<8; i=i+1) h[i] <= hinit[i];
         end else if(wken) begin
-            t1 = h[7] + BSIG1(h[4]) + ((h[4] &  h[5]) ^ (~h[4] & h[6])) + wk;
-            t2 = BSIG0(h[0]) + ((h[0] & h[1]) ^ (h[0] & h[2]) ^ (h[1] & h[2]));
-            h[7] <= hadder[7] + h[6];
-            h[6] <= hadder[6] + h[5];
-            h[5] <= hadder[5] + h[4];
-            h[4] <= hadder[4] + h[3] + t1;
-            h[3] <= hadder[3] + h[2];
-            h[2] <= hadder[2] + h[1];
-            h[1] <= hadder[1] + h[0];
-            h[0] <= hadder[0] + t1 + t2;
+            // Round r takes h[7-r] as its h, so every h + K + W is formed
+            // from registers, beside the BSIG1/Ch logic of round 0
+            hround = {h[0],h[1],h[2],h[3],h[4],h[5],h[6],h[7]};
+            for(r=0; r<ROUNDS_PER_CYCLE; r=r+1)
+                hround = ROUND(hround, h[7-r] + wk[32*r +: 32]);
+            for(i=0; i<8; i=i+1) h[i] <= hadder[i] + hround[32*(7-i) +: 32];
         end
     end
 
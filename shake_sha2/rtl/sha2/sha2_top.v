@@ -6,10 +6,12 @@
 //           Supports mode selection via 'mode' signal
 //           mode = 1'b0: SHA-256 (256-bit output)
 //           mode = 1'b1: SHA-512 (512-bit output)
+//           ROUNDS_PER_CYCLE (1, 2 or 4) sets the compression rounds per clock
 //--------------------------------------------------------------------------------------------------------
 
 module sha2_top #(
-    parameter MODE_WIDTH = 1  // 0=SHA-256, 1=SHA-512
+    parameter MODE_WIDTH = 1, // 0=SHA-256, 1=SHA-512
+    parameter ROUNDS_PER_CYCLE = 1
 )(
     input  wire        rstn,
     input  wire        clk,
@@ -67,7 +69,9 @@ wire sha512_tvalid = tvalid && mode_reg;
 //--------------------------------------------------------------------------------------------------------
 // SHA-256 Instance
 //--------------------------------------------------------------------------------------------------------
-sha256 u_sha256 (
+sha256 #(
+    .ROUNDS_PER_CYCLE ( ROUNDS_PER_CYCLE )
+) u_sha256 (
     .rstn   ( rstn           ),
     .clk    ( clk            ),
     .tvalid ( sha256_tvalid  ),
@@ -84,7 +88,9 @@ sha256 u_sha256 (
 //--------------------------------------------------------------------------------------------------------
 // SHA-512 Instance
 //--------------------------------------------------------------------------------------------------------
-sha512 u_sha512 (
+sha512 #(
+    .ROUNDS_PER_CYCLE ( ROUNDS_PER_CYCLE )
+) u_sha512 (
     .rstn   ( rstn           ),
     .clk    ( clk            ),
     .tvalid ( sha512_tvalid  ),
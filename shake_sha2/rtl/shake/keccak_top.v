@@ -2,7 +2,8 @@ module keccak_top
 #(
     parameter N = 64,
     parameter IN_BUF_SIZE = 200,
-    parameter OUT_BUF_SIZE = 200
+    parameter OUT_BUF_SIZE = 200,
+    parameter ROUNDS_PER_CYCLE = 1      //Rounds per clock: 1, 2, 3, 4, 6, 8, 12 or 24 (divides 24)
 )
 (
     input                             Clock,       //System clock
@@ -18,13 +19,27 @@ module keccak_top
 
 
 reg  [4:0]       counter_nr_rounds;
-wire [N-1:0]    Round_constant_signal;
+wire [N*ROUNDS_PER_CYCLE-1:0] Round_constant_signal;
 wire [1599:0]   state_in;
 wire [1599:0]   state_out;
 reg  [1599:0]    reg_data;
 wire [1599:0]   swap_data_in, swap_data_out;
 wire [1599:0]  Round_in, Round_out;
 
+//A factor that does not divide 24 never reaches the last round; stop elaboration
+//(Verilator resolves cells in untaken branches too, so there it stops at time 0)
+generate
+    if (ROUNDS_PER_CYCLE < 1 || 24 % ROUNDS_PER_CYCLE != 0)
+    begin: bad_rounds_per_cycle
+
+`ifdef VERILATOR
+      initial $fatal(1, "keccak_top: ROUNDS_PER_CYCLE must divide 24");
+`else
+      keccak_top_ROUNDS_PER_CYCLE_must_divide_24 bad_parameter();
+`endif
+    end
+endgenerate
+
 
 //Swapped input endiannes, byte streams to 64 bit data
 genvar i;
@@ -46,15 +61,32 @@ assign state_in  = reg_data;
 // assign Round_in  = bit_to_state(state_in);
 assign Round_in  = state_in;
 
-keccak_round 
-keccak_round_i
-    (
-    .Round_in               (Round_in),
-    .Round_constant_signal  (Round_constant_signal),
-    .Round_out              (Round_out)
-    );
+//ROUNDS_PER_CYCLE rounds chained combinationally, round r uses constant r
+wire [1599:0]  round_chain [0:ROUNDS_PER_CYCLE];
+
+assign round_chain[0] = Round_in;
+
+genvar r;
+generate
+    for (r=0; r < ROUNDS_PER_CYCLE; r=r+1)
+    begin: round_unroll
+
+      keccak_round 
+      keccak_round_i
+          (
+          .Round_in               (round_chain[r]),
+          .Round_constant_signal  (Round_constant_signal[N*r +: N]),
+          .Round_out              (round_chain[r+1])
+          );
+    end
+endgenerate
+
+assign Round_out = round_chain[ROUNDS_PER_CYCLE];
 
 keccak_round_constants_gen 
+#(
+    .ROUNDS(ROUNDS_PER_CYCLE)
+)
 keccak_round_constants_gen_i
     (
     .round_number(counter_nr_rounds),
@@ -102,11 +134,11 @@ always @ (posedge Clock or posedge Reset) begin
     end else if((Start | Req_more) & Ready) begin
         counter_nr_rounds       <= 0;
         Ready                   <= 0;
-    end else if(counter_nr_rounds == 23 & ~Hold) begin  // 只有在Hold为低时才完成计算
+    end else if(counter_nr_rounds == 24 - ROUNDS_PER_CYCLE & ~Hold) begin  // 只有在Hold为低时才完成计算
         counter_nr_rounds       <= 0;
         Ready                   <= 1;
     end else if(~Ready & ~Hold) begin  // 只有在Hold为低时才递增计数器
-        counter_nr_rounds       <= counter_nr_rounds + 1;
+        counter_nr_rounds       <= counter_nr_rounds + ROUNDS_PER_CYCLE;
     end
 end
 
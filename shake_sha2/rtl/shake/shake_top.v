@@ -1,5 +1,8 @@
 // ģ鶨壺SHAKE㷨ģ
 module shake_top
+#(
+  parameter KECCAK_ROUNDS_PER_CYCLE = 1  //Keccak rounds per clock, see keccak_top
+)
 (
   // ʱź
   input                     clk_i,              //system clock
@@ -25,7 +28,9 @@ module shake_top
   // RλݣSHAKE128p1344λģʽʹøRλ
   output  [1343:0]          dout_full_o,        //full R-bit output (1344 bits for SHAKE128, use high R bits for other modes)
   // Чź
-  output                    dout_full_valid_o   //full output valid signal
+  output                    dout_full_valid_o,  //full output valid signal
+  output                    din_ready_o,        //data input accepted on the next din_valid_i rising edge
+  output                    perm_o              //a Keccak-f permutation starts, 1 clock pulse
 );
 
 // ģʽ
@@ -88,8 +93,6 @@ reg     [3:0]   last_din_byte;
 reg     [2:0]   mode_reg;  // Registered mode signal
 
 // ڲźƳĶ˅
-// ź
-wire            din_ready_o;    // ڲdin_readyź
 // 64λŅ
 wire    [63:0]  dout_o;         // ڲ64λŅ
 // Чź
@@ -360,6 +363,9 @@ assign keccak_start = (state==S_FULL | state==S_LAST_FULL) & keccak_ready & !sha
 assign keccak_squeeze = state==S_SQUEEZE & keccak_ready & 
                        (~dout_buf_available | last_dout_buf & dout_ready_i) & !sha3_hold;
 
+// keccak_top runs one permutation per Start or Req_more taken while Ready
+assign perm_o = keccak_start | keccak_squeeze;
+
 // ģʽKeccak״
 // SHAKE128״Ņ
 wire [1599:0] keccak_state_in_shake128;
@@ -449,7 +455,9 @@ assign dout_full_o = (dout_valid_rising_edge & !sha3_hold) ? data_buf : 1344'h0;
 assign dout_full_valid_o = dout_valid_rising_edge & !sha3_hold;
 
 // Keccakģʵ
-keccak_top keccak_top (
+keccak_top #(
+    .ROUNDS_PER_CYCLE (KECCAK_ROUNDS_PER_CYCLE)
+) keccak_top (
     .Clock    (clk_i            ),  // ʱź
     .Reset    (~rst_ni | start_i),  // λźţЧλʱЧ
     .Start    (keccak_start     ),  // ź
@@ -0,0 +1,309 @@
+`timescale 1 ns / 1 ps
+//--------------------------------------------------------------------------------------------------------
+// Module  : shake_sha2_cdc
+// Type    : synthesizable
+// Standard: Verilog 2001 (IEEE1364-2001)
+// Function: shake_sha2_top on its own clock (core_clk), with the same ports on the AXI clock (clk).
+//
+//           Inputs: every change of the core input signals (mode, SHA-2 stream, SHAKE data and
+//           control) is pushed as one snapshot into a command FIFO. The core side applies the
+//           snapshots in order, one per core clock, and holds the last one. A snapshot that raises
+//           sha2_tvalid or shake_din_valid is held back until the core is ready for it, so on the
+//           AXI side sha2_tready and shake_din_ready only mean "room for another word": the register
+//           and DMA front ends keep their protocol, and the cores see the same edges as before.
+//
+//           Outputs: each SHA-2 result, and the first SHAKE output block after a start, go through
+//           a result FIFO. On the AXI side sha2_ovalid pulses for one clock per SHA-2 result, and
+//           dout_valid rises with each result and stays high until the next start or tvalid, like
+//           the SHAKE core's. Later SHAKE blocks squeezed while shake_dout_ready stays high are not
+//           forwarded; the front ends only read the first.
+//
+//           A change that finds the command FIFO full waits there and sets cmd_overflow, since a
+//           pulse that ends before it is pushed is lost. A result that finds the result FIFO full is
+//           dropped and sets res_overflow; the AXI side pops one result per clock, so this takes a
+//           core_clk well above clk. Both are sticky until rstn, which is synchronized into core_clk.
+//
+//           Keccak-f permutations are counted on core_clk in a 3-bit Gray counter; keccak_perms
+//           gives the number that started since the last AXI clock, a few clocks late.
+//--------------------------------------------------------------------------------------------------------
+
+module shake_sha2_cdc #(
+    parameter KECCAK_ROUNDS_PER_CYCLE = 1,
+    parameter SHA2_ROUNDS_PER_CYCLE = 1,
+    parameter integer CMD_ADDR_BITS = 4,        // command FIFO of 2^CMD_ADDR_BITS snapshots
+    parameter integer RES_ADDR_BITS = 2         // result FIFO of 2^RES_ADDR_BITS results
+)(
+    // AXI side
+    input  wire              clk,
+    input  wire              rstn,
+    input  wire  [3:0]       algo_mode,
+    input  wire              sha2_tvalid,
+    output wire              sha2_tready,
+    input  wire              sha2_tlast,
+    input  wire  [31:0]      sha2_tid,
+    input  wire  [7:0]       sha2_tdata,
+    output reg               sha2_ovalid,
+    output reg   [31:0]      sha2_oid,
+    output reg   [60:0]      sha2_olen,
+    input  wire              shake_start_i,
+    input  wire  [63:0]      shake_din_i,
+    input  wire              shake_din_valid_i,
+    input  wire              shake_last_din_i,
+    input  wire  [3:0]       shake_last_din_byte_i,
+    input  wire              shake_dout_ready_i,
+    input  wire              shake_hold,
+    output reg   [1343:0]    dout,
+    output reg               dout_valid,
+    output wire              shake_din_ready,
+    output reg               cmd_overflow,      // sticky until rstn
+    output wire              res_overflow,      // sticky until rstn
+    output reg   [2:0]       keccak_perms,      // permutations started, per clock
+
+    // Core clock
+    input  wire              core_clk
+);
+
+// Command snapshot
+localparam CMD_W = 4 + 1 + 1 + 32 + 8 + 1 + 64 + 1 + 1 + 4 + 1 + 1;
+// Result: sha2 flag, oid, olen, dout
+localparam RES_W = 1 + 32 + 61 + 1344;
+
+// Snapshots a word needs: data, valid rise, valid fall; keep one spare
+localparam CMD_ROOM = 4;
+
+//--------------------------------------------------------------------------------------------------------
+// AXI side
+//--------------------------------------------------------------------------------------------------------
+wire [CMD_W-1:0]  cmd = {algo_mode, sha2_tvalid, sha2_tlast, sha2_tid, sha2_tdata,
+                         shake_start_i, shake_din_i, shake_din_valid_i, shake_last_din_i,
+                         shake_last_din_byte_i, shake_dout_ready_i, shake_hold};
+reg  [CMD_W-1:0]  cmd_sent;     // last snapshot pushed; all-zero matches the inputs after reset
+wire              cmd_full;
+wire [CMD_ADDR_BITS:0] cmd_free;
+wire              cmd_push = cmd != cmd_sent;
+
+wire [RES_W-1:0]  res_head;
+wire              res_empty;
+
+assign sha2_tready     = cmd_free >= CMD_ROOM;
+assign shake_din_ready = cmd_free >= CMD_ROOM;
+
+always @(posedge clk)
+if(!rstn) begin
+  cmd_sent     <= 0;
+  cmd_overflow <= 1'b0;
+end
+else if(cmd_push) begin
+  if(!cmd_full)
+    cmd_sent     <= cmd;
+  else
+    cmd_overflow <= 1'b1;
+end
+
+always @(posedge clk)
+if(!rstn) begin
+  dout_valid  <= 1'b0;
+  sha2_ovalid <= 1'b0;
+  sha2_oid    <= 32'd0;
+  sha2_olen   <= 61'd0;
+  dout        <= 1344'd0;
+end
+else begin
+  sha2_ovalid <= ~res_empty & res_head[RES_W-1];
+  if(!res_empty) begin
+    dout_valid  <= 1'b1;
+    {sha2_oid, sha2_olen, dout} <= res_head[RES_W-2:0];
+  end
+  else if(cmd_push & (shake_start_i | sha2_tvalid))
+    dout_valid  <= 1'b0;
+end
+
+//--------------------------------------------------------------------------------------------------------
+// Core side
+//--------------------------------------------------------------------------------------------------------
+(* ASYNC_REG = "TRUE" *) reg [1:0] core_rst_sync;
+wire core_rstn = core_rst_sync[1];
+
+always @(posedge core_clk or negedge rstn)
+if(!rstn)
+  core_rst_sync <= 2'b00;
+else
+  core_rst_sync <= {core_rst_sync[0], 1'b1};
+
+wire [CMD_W-1:0]  cmd_head;
+wire              cmd_empty;
+reg  [CMD_W-1:0]  cur;          // snapshot applied to the core
+
+wire [3:0]        c_algo_mode;
+wire              c_sha2_tvalid, c_sha2_tlast;
+wire [31:0]       c_sha2_tid;
+wire [7:0]        c_sha2_tdata;
+wire              c_shake_start;
+wire [63:0]       c_shake_din;
+wire              c_shake_din_valid, c_shake_last_din;
+wire [3:0]        c_shake_last_din_byte;
+wire              c_shake_dout_ready, c_shake_hold;
+
+assign {c_algo_mode, c_sha2_tvalid, c_sha2_tlast, c_sha2_tid, c_sha2_tdata,
+        c_shake_start, c_shake_din, c_shake_din_valid, c_shake_last_din,
+        c_shake_last_din_byte, c_shake_dout_ready, c_shake_hold} = cur;
+
+// Bit positions of the two valids in a snapshot
+localparam CMD_TVALID    = CMD_W - 5;
+localparam CMD_DIN_VALID = 7;
+
+wire              core_sha2_tready;
+wire              core_shake_din_ready;
+wire              core_keccak_perm;
+wire              core_sha2_ovalid;
+wire [31:0]       core_sha2_oid;
+wire [60:0]       core_sha2_olen;
+wire [1343:0]     core_dout;
+wire              core_dout_valid;
+
+wire              head_ok  = ~(cmd_head[CMD_TVALID] & ~c_sha2_tvalid & ~core_sha2_tready) &
+                             ~(cmd_head[CMD_DIN_VALID] & ~c_shake_din_valid & ~core_shake_din_ready);
+wire              cmd_pop  = ~cmd_empty & head_ok;
+
+always @(posedge core_clk)
+if(!core_rstn)
+  cur <= 0;
+else if(cmd_pop)
+  cur <= cmd_head;
+
+// One result per SHA-2 message; one per SHAKE start
+reg               shake_armed;
+wire              res_push = core_sha2_ovalid |
+                             (shake_armed & ~c_shake_start & c_algo_mode[3] & core_dout_valid);
+
+always @(posedge core_clk)
+if(!core_rstn)
+  shake_armed <= 1'b0;
+else if(c_shake_start)
+  shake_armed <= 1'b1;
+else if(res_push)
+  shake_armed <= 1'b0;
+
+shake_sha2_top #(
+    .KECCAK_ROUNDS_PER_CYCLE(KECCAK_ROUNDS_PER_CYCLE),
+    .SHA2_ROUNDS_PER_CYCLE(SHA2_ROUNDS_PER_CYCLE)
+) u_shake_sha2_top (
+    .clk(core_clk),
+    .rstn(core_rstn),
+    .algo_mode(c_algo_mode),
+    .sha2_tvalid(c_sha2_tvalid),
+    .sha2_tready(core_sha2_tready),
+    .sha2_tlast(c_sha2_tlast),
+    .sha2_tid(c_sha2_tid),
+    .sha2_tdata(c_sha2_tdata),
+    .shake_start_i(c_shake_start),
+    .shake_din_i(c_shake_din),
+    .shake_din_valid_i(c_shake_din_valid),
+    .shake_last_din_i(c_shake_last_din),
+    .shake_last_din_byte_i(c_shake_last_din_byte),
+    .shake_dout_ready_i(c_shake_dout_ready),
+    .shake_hold(c_shake_hold),
+    .dout(core_dout),
+    .dout_valid(core_dout_valid),
+    .sha2_ovalid(core_sha2_ovalid),
+    .sha2_oid(core_sha2_oid),
+    .sha2_olen(core_sha2_olen),
+    .shake_din_ready(core_shake_din_ready),
+    .keccak_perm(core_keccak_perm)
+);
+
+//--------------------------------------------------------------------------------------------------------
+// Result FIFO overrun, sticky on core_clk and synchronized into clk
+//--------------------------------------------------------------------------------------------------------
+wire              res_full;
+reg               res_lost;     // core_clk
+(* ASYNC_REG = "TRUE" *) reg [1:0] res_lost_sync;
+
+always @(posedge core_clk)
+if(!core_rstn)
+  res_lost <= 1'b0;
+else if(res_push & res_full)
+  res_lost <= 1'b1;
+
+always @(posedge clk)
+if(!rstn)
+  res_lost_sync <= 2'b00;
+else
+  res_lost_sync <= {res_lost_sync[0], res_lost};
+
+assign res_overflow = res_lost_sync[1];
+
+//--------------------------------------------------------------------------------------------------------
+// Permutation count
+//--------------------------------------------------------------------------------------------------------
+reg  [2:0]        perm_bin;     // core_clk
+reg  [2:0]        perm_gray;
+(* ASYNC_REG = "TRUE" *) reg [2:0] perm_gray_s1, perm_gray_s2;
+reg  [2:0]        perm_seen;    // clk, binary
+wire [2:0]        perm_bin_next = perm_bin + 3'd1;
+wire [2:0]        perm_sync = {perm_gray_s2[2], perm_gray_s2[2] ^ perm_gray_s2[1],
+                               perm_gray_s2[2] ^ perm_gray_s2[1] ^ perm_gray_s2[0]};
+
+always @(posedge core_clk)
+if(!core_rstn) begin
+  perm_bin  <= 3'd0;
+  perm_gray <= 3'd0;
+end
+else if(core_keccak_perm) begin
+  perm_bin  <= perm_bin_next;
+  perm_gray <= perm_bin_next ^ (perm_bin_next >> 1);
+end
+
+always @(posedge clk)
+if(!rstn) begin
+  perm_gray_s1 <= 3'd0;
+  perm_gray_s2 <= 3'd0;
+  perm_seen    <= 3'd0;
+  keccak_perms <= 3'd0;
+end
+else begin
+  perm_gray_s1 <= perm_gray;
+  perm_gray_s2 <= perm_gray_s1;
+  perm_seen    <= perm_sync;
+  keccak_perms <= perm_sync - perm_seen;
+end
+
+//--------------------------------------------------------------------------------------------------------
+// FIFOs
+//--------------------------------------------------------------------------------------------------------
+async_fifo #(
+    .WIDTH(CMD_W),
+    .ADDR_BITS(CMD_ADDR_BITS)
+) u_cmd_fifo (
+    .wr_clk(clk),
+    .wr_rstn(rstn),
+    .wr_en(cmd_push),
+    .wr_data(cmd),
+    .wr_full(cmd_full),
+    .wr_free(cmd_free),
+    .rd_clk(core_clk),
+    .rd_rstn(core_rstn),
+    .rd_en(cmd_pop),
+    .rd_data(cmd_head),
+    .rd_empty(cmd_empty)
+);
+
+// A result that finds the FIFO full is dropped and sets res_overflow
+async_fifo #(
+    .WIDTH(RES_W),
+    .ADDR_BITS(RES_ADDR_BITS)
+) u_res_fifo (
+    .wr_clk(core_clk),
+    .wr_rstn(core_rstn),
+    .wr_en(res_push),
+    .wr_data({core_sha2_ovalid, core_sha2_oid, core_sha2_olen, core_dout}),
+    .wr_full(res_full),
+    .wr_free(),
+    .rd_clk(clk),
+    .rd_rstn(rstn),
+    .rd_en(~res_empty),
+    .rd_data(res_head),
+    .rd_empty(res_empty)
+);
+
+endmodule
@@ -0,0 +1,496 @@
+`timescale 1 ns / 1 ps
+//--------------------------------------------------------------------------------------------------------
+// Module  : shake_sha2_dma
+// Type    : synthesizable
+// Standard: Verilog 2001 (IEEE1364-2001)
+// Function: Descriptor-ring front end for shake_sha2_top. Fetches hash jobs from a ring of 64-byte
+//           descriptors in memory over an AXI4 master, streams prefix || tweak || input into the core
+//           and writes the digest and then the consumer index back to memory, so that the CPU only
+//           writes one doorbell per batch instead of one register per byte/word.
+//
+//           Descriptor (16 little-endian words, 64-byte aligned):
+//             w0     [3:0] algo_mode (as shake_sha2_top), [15:8] output bytes (1..64),
+//                    [23:16] tweak bytes (0..32)
+//             w1     input address           w2  input bytes
+//             w3     output address (any alignment)
+//             w4     prefix address          w5  prefix bytes (0: no prefix)
+//             w6     tag, passed to the SHA-2 core as tid
+//             w7     reserved
+//             w8-15  tweak bytes, inline (e.g. the ADRS of a tweakable hash call)
+//
+//           Ring: entry i lives at ring_base + 64 * (i mod 2^ring_order). The engine runs while
+//           cons_idx != prod_idx. After the output of entry i is written, cons_idx + 1 is written to
+//           cmpl_addr (skipped when cmpl_addr is 0), then cons_idx is advanced.
+//
+//           A bad descriptor or an error response stops the engine with error set; clear it by
+//           writing enable = 0, which also resets cons_idx. A read error in the middle of a SHA-2
+//           message leaves that message open in the core, so the IP needs a reset after it.
+//--------------------------------------------------------------------------------------------------------
+
+module shake_sha2_dma #(
+    parameter integer C_M_AXI_ADDR_WIDTH = 32,
+    parameter integer C_M_AXI_DATA_WIDTH = 32,      // only 32 is supported
+    parameter integer C_M_AXI_COHERENT   = 0        // 1: ACP (coherent), 0: HP (software flushes)
+)(
+    input  wire                              clk,
+    input  wire                              rstn,
+
+    // Control, from the AXI-Lite registers
+    input  wire                              enable,
+    input  wire  [31:0]                      ring_base,
+    input  wire  [3:0]                       ring_order,
+    input  wire  [15:0]                      prod_idx,
+    input  wire  [31:0]                      cmpl_addr,
+    output reg   [15:0]                      cons_idx,
+    output wire                              busy,          // engine owns the core
+    output reg                               error,
+    output reg   [2:0]                       error_code,
+
+    // Core side (shake_sha2_top inputs while busy)
+    output reg   [3:0]                       core_algo_mode,
+    output reg                               core_sha2_tvalid,
+    output reg                               core_sha2_tlast,
+    output wire  [31:0]                      core_sha2_tid,
+    output reg   [7:0]                       core_sha2_tdata,
+    input  wire                              core_sha2_tready,
+    output reg                               core_shake_start,
+    output reg   [63:0]                      core_shake_din,
+    output reg                               core_shake_din_valid,
+    output reg                               core_shake_last_din,
+    output reg   [3:0]                       core_shake_last_din_byte,
+    output reg                               core_shake_dout_ready,
+    input  wire                              core_shake_din_ready,
+    input  wire  [1343:0]                    core_dout,
+    input  wire                              core_dout_valid,
+
+    // AXI4 master
+    output reg   [C_M_AXI_ADDR_WIDTH-1:0]    m_axi_awaddr,
+    output wire  [7:0]                       m_axi_awlen,
+    output wire  [2:0]                       m_axi_awsize,
+    output wire  [1:0]                       m_axi_awburst,
+    output wire                              m_axi_awlock,
+    output wire  [3:0]                       m_axi_awcache,
+    output wire  [2:0]                       m_axi_awprot,
+    output wire  [3:0]                       m_axi_awqos,
+    output wire  [4:0]                       m_axi_awuser,
+    output reg                               m_axi_awvalid,
+    input  wire                              m_axi_awready,
+    output reg   [C_M_AXI_DATA_WIDTH-1:0]    m_axi_wdata,
+    output reg   [C_M_AXI_DATA_WIDTH/8-1:0]  m_axi_wstrb,
+    output wire                              m_axi_wlast,
+    output reg                               m_axi_wvalid,
+    input  wire                              m_axi_wready,
+    input  wire  [1:0]                       m_axi_bresp,
+    input  wire                              m_axi_bvalid,
+    output wire                              m_axi_bready,
+    output reg   [C_M_AXI_ADDR_WIDTH-1:0]    m_axi_araddr,
+    output reg   [7:0]                       m_axi_arlen,
+    output wire  [2:0]                       m_axi_arsize,
+    output wire  [1:0]                       m_axi_arburst,
+    output wire                              m_axi_arlock,
+    output wire  [3:0]                       m_axi_arcache,
+    output wire  [2:0]                       m_axi_arprot,
+    output wire  [3:0]                       m_axi_arqos,
+    output wire  [4:0]                       m_axi_aruser,
+    output reg                               m_axi_arvalid,
+    input  wire                              m_axi_arready,
+    input  wire  [C_M_AXI_DATA_WIDTH-1:0]    m_axi_rdata,
+    input  wire  [1:0]                       m_axi_rresp,
+    input  wire                              m_axi_rlast,
+    input  wire                              m_axi_rvalid,
+    output wire                              m_axi_rready
+);
+
+// States
+localparam  ST_IDLE   = 4'd0;   // wait for prod_idx != cons_idx
+localparam  ST_AR     = 4'd1;   // read address (descriptor or data burst)
+localparam  ST_R      = 4'd2;   // read data
+localparam  ST_DECODE = 4'd3;   // check the descriptor, select the algorithm
+localparam  ST_START  = 4'd4;   // SHAKE start pulse
+localparam  ST_SEG    = 4'd5;   // next window of message bytes
+localparam  ST_FEED   = 4'd6;   // take one byte from the window
+localparam  ST_PUSH   = 4'd7;   // hand a byte (SHA-2) or a word (SHAKE) to the core
+localparam  ST_WAIT   = 4'd8;   // wait for the digest
+localparam  ST_OUT    = 4'd9;   // next output word, or the completion write
+localparam  ST_W      = 4'd10;  // write address and data
+localparam  ST_B      = 4'd11;  // write response
+localparam  ST_ERROR  = 4'd12;
+
+// Message segments, in feeding order
+localparam  SEG_PREFIX = 2'd0;
+localparam  SEG_TWEAK  = 2'd1;
+localparam  SEG_INPUT  = 2'd2;
+
+// Error codes
+localparam  ERR_DESC_READ = 3'd1;
+localparam  ERR_DESC      = 3'd2;
+localparam  ERR_DATA_READ = 3'd3;
+localparam  ERR_WRITE     = 3'd4;
+
+// AXI attributes: single-beat writes, incrementing 32-bit read bursts. ACP needs a cacheable,
+// shared (AxUSER[0]) access to snoop the L1; HP takes normal non-cacheable bufferable.
+localparam  [3:0] AXI_CACHE = (C_M_AXI_COHERENT != 0) ? 4'b1111 : 4'b0011;
+localparam  [4:0] AXI_USER  = (C_M_AXI_COHERENT != 0) ? 5'b00001 : 5'b00000;
+
+assign m_axi_awlen   = 8'd0;
+assign m_axi_awsize  = 3'b010;
+assign m_axi_awburst = 2'b01;
+assign m_axi_awlock  = 1'b0;
+assign m_axi_awcache = AXI_CACHE;
+assign m_axi_awprot  = 3'b000;
+assign m_axi_awqos   = 4'd0;
+assign m_axi_awuser  = AXI_USER;
+assign m_axi_wlast   = 1'b1;
+assign m_axi_arsize  = 3'b010;
+assign m_axi_arburst = 2'b01;
+assign m_axi_arlock  = 1'b0;
+assign m_axi_arcache = AXI_CACHE;
+assign m_axi_arprot  = 3'b000;
+assign m_axi_arqos   = 4'd0;
+assign m_axi_aruser  = AXI_USER;
+
+reg     [3:0]   state;
+
+// Descriptor and read buffer
+reg     [31:0]  desc [0:15];
+reg     [31:0]  rbuf [0:15];
+reg     [3:0]   beat;
+reg             rd_desc;        // the current burst is a descriptor
+reg             rd_err;
+
+wire    [3:0]   d_mode      = desc[0][3:0];
+wire    [7:0]   d_out_len   = desc[0][15:8];
+wire    [7:0]   d_tweak_len = desc[0][23:16];
+wire            is_shake    = core_algo_mode[3];
+
+assign core_sha2_tid = desc[6];
+
+// Message walk
+reg     [1:0]   seg;
+reg     [31:0]  seg_addr;
+reg     [31:0]  seg_left;       // bytes of the segment not yet fetched
+reg     [31:0]  msg_left;       // bytes of the message not yet fed
+reg     [6:0]   win_pos;        // current window: bytes [win_pos, win_end) of rbuf or the tweak
+reg     [6:0]   win_end;
+reg             win_tweak;
+reg     [63:0]  pack;           // SHAKE word being assembled, first byte highest
+reg     [3:0]   pack_cnt;
+
+// Output
+reg     [511:0] digest;         // first output byte in [511:504]
+reg     [6:0]   out_len;
+reg     [6:0]   out_pos;
+reg             wr_cmpl;        // the current write is the completion index
+
+// Total message length, with a carry to reject wrap-around
+wire    [33:0]  msg_len = {2'b0, desc[5]} + {26'b0, d_tweak_len} + {2'b0, desc[2]};
+
+wire            mode_ok = d_mode == 4'h0 || d_mode == 4'h1 ||
+                          (d_mode[3] && d_mode[2:0] <= 3'd5);
+wire            desc_ok = mode_ok && d_out_len != 8'd0 && d_out_len <= 8'd64 &&
+                          d_tweak_len <= 8'd32 && msg_len[33:32] == 2'b00 &&
+                          (d_mode[3] || msg_len != 34'd0);
+
+// Next read burst of the current segment: whole words from the aligned start, at most 16 beats
+// and never across a 4 KB boundary.
+wire    [32:0]  span_bytes  = {1'b0, seg_left} + {31'b0, seg_addr[1:0]};
+wire    [32:0]  span_words  = (span_bytes + 33'd3) >> 2;
+wire    [10:0]  words_to_4k = 11'd1024 - {1'b0, seg_addr[11:2]};
+wire    [4:0]   beats_max   = (span_words > 33'd16) ? 5'd16 : span_words[4:0];
+wire    [4:0]   rd_beats    = ({6'b0, beats_max} > words_to_4k) ? words_to_4k[4:0] : beats_max;
+wire    [6:0]   rd_bytes    = {rd_beats, 2'b00};
+wire    [6:0]   rd_end      = (span_bytes < {26'b0, rd_bytes}) ? span_bytes[6:0] : rd_bytes;
+wire    [6:0]   rd_take     = rd_end - {5'b0, seg_addr[1:0]};
+
+wire    [15:0]  ring_mask   = (16'd1 << ring_order) - 16'd1;
+
+// Byte at win_pos (little-endian lanes)
+wire    [31:0]  win_word = win_tweak ? desc[{1'b1, win_pos[4:2]}] : rbuf[win_pos[5:2]];
+wire    [7:0]   win_byte = win_word[{win_pos[1:0], 3'b000} +: 8];
+
+// Next output word: bytes out_pos.. of the digest placed at their lanes of out_addr + out_pos
+wire    [31:0]  wr_addr  = desc[3] + {25'b0, out_pos};
+wire    [1:0]   wr_lane  = wr_addr[1:0];
+wire    [6:0]   out_left = out_len - out_pos;
+wire    [2:0]   wr_room  = 3'd4 - {1'b0, wr_lane};
+wire    [2:0]   wr_n     = (out_left < {4'b0, wr_room}) ? out_left[2:0] : wr_room;
+wire    [4:0]   wr_nmask = (5'd1 << wr_n) - 5'd1;
+wire    [511:0] out_sh   = digest << {out_pos, 3'b000};
+wire    [31:0]  out_head = out_sh[511:480];
+reg     [31:0]  wr_data;
+
+always @(*)
+begin
+  case(wr_lane)
+    2'd0: wr_data = {out_head[7:0], out_head[15:8], out_head[23:16], out_head[31:24]};
+    2'd1: wr_data = {out_head[15:8], out_head[23:16], out_head[31:24], 8'h00};
+    2'd2: wr_data = {out_head[23:16], out_head[31:24], 16'h0000};
+    default: wr_data = {out_head[31:24], 24'h000000};
+  endcase
+end
+
+assign busy         = state != ST_IDLE && state != ST_ERROR;
+assign m_axi_rready = state == ST_R;
+assign m_axi_bready = state == ST_B;
+
+integer i;
+
+always @(posedge clk)
+if(!rstn) begin
+  state                    <= ST_IDLE;
+  cons_idx                 <= 16'd0;
+  error                    <= 1'b0;
+  error_code               <= 3'd0;
+  core_algo_mode           <= 4'd0;
+  core_sha2_tvalid         <= 1'b0;
+  core_sha2_tlast          <= 1'b0;
+  core_sha2_tdata          <= 8'd0;
+  core_shake_start         <= 1'b0;
+  core_shake_din           <= 64'd0;
+  core_shake_din_valid     <= 1'b0;
+  core_shake_last_din      <= 1'b0;
+  core_shake_last_din_byte <= 4'd0;
+  core_shake_dout_ready    <= 1'b0;
+  m_axi_awaddr             <= 0;
+  m_axi_awvalid            <= 1'b0;
+  m_axi_wdata              <= 0;
+  m_axi_wstrb              <= 0;
+  m_axi_wvalid             <= 1'b0;
+  m_axi_araddr             <= 0;
+  m_axi_arlen              <= 8'd0;
+  m_axi_arvalid            <= 1'b0;
+  beat                     <= 4'd0;
+  rd_desc                  <= 1'b0;
+  rd_err                   <= 1'b0;
+  seg                      <= SEG_PREFIX;
+  seg_addr                 <= 32'd0;
+  seg_left                 <= 32'd0;
+  msg_left                 <= 32'd0;
+  win_pos                  <= 7'd0;
+  win_end                  <= 7'd0;
+  win_tweak                <= 1'b0;
+  pack                     <= 64'd0;
+  pack_cnt                 <= 4'd0;
+  digest                   <= 512'd0;
+  out_len                  <= 7'd0;
+  out_pos                  <= 7'd0;
+  wr_cmpl                  <= 1'b0;
+  for(i = 0; i < 16; i = i + 1) begin
+    desc[i] <= 32'd0;
+    rbuf[i] <= 32'd0;
+  end
+end
+else begin
+  case(state)
+    ST_IDLE   : begin
+      if(!enable)
+        cons_idx <= 16'd0;
+      else if(prod_idx != cons_idx) begin
+        m_axi_araddr  <= {ring_base[31:6], 6'd0} + {10'd0, cons_idx & ring_mask, 6'd0};
+        m_axi_arlen   <= 8'd15;
+        m_axi_arvalid <= 1'b1;
+        rd_desc       <= 1'b1;
+        rd_err        <= 1'b0;
+        beat          <= 4'd0;
+        state         <= ST_AR;
+      end
+    end
+
+    ST_AR     : if(m_axi_arready) begin
+      m_axi_arvalid <= 1'b0;
+      state         <= ST_R;
+    end
+
+    ST_R      : if(m_axi_rvalid) begin
+      if(rd_desc)
+        desc[beat] <= m_axi_rdata;
+      else
+        rbuf[beat] <= m_axi_rdata;
+      beat <= beat + 4'd1;
+      if(m_axi_rresp[1])
+        rd_err <= 1'b1;
+      if(m_axi_rlast) begin
+        if(rd_err | m_axi_rresp[1]) begin
+          error      <= 1'b1;
+          error_code <= rd_desc ? ERR_DESC_READ : ERR_DATA_READ;
+          state      <= ST_ERROR;
+        end
+        else
+          state <= rd_desc ? ST_DECODE : ST_FEED;
+      end
+    end
+
+    ST_DECODE : if(!desc_ok) begin
+      error      <= 1'b1;
+      error_code <= ERR_DESC;
+      state      <= ST_ERROR;
+    end
+    else begin
+      core_algo_mode <= d_mode;
+      out_len        <= d_out_len[6:0];
+      seg            <= SEG_PREFIX;
+      seg_addr       <= desc[4];
+      seg_left       <= desc[5];
+      msg_left       <= msg_len[31:0];
+      pack           <= 64'd0;
+      pack_cnt       <= 4'd0;
+      state          <= ST_START;
+    end
+
+    // core_algo_mode has settled: SHAKE samples it at start_i, sha2_top registers it
+    ST_START  : if(is_shake & ~core_shake_start)
+      core_shake_start <= 1'b1;
+    else begin
+      core_shake_start <= 1'b0;
+      state            <= ST_SEG;
+    end
+
+    ST_SEG    : if(msg_left == 32'd0)
+      state <= ST_PUSH;                         // empty SHAKE message: one last word, 0 bytes
+    else if(seg_left == 32'd0) begin
+      seg <= seg + 2'd1;
+      if(seg == SEG_PREFIX)
+        seg_left <= {24'd0, d_tweak_len};
+      else if(seg == SEG_TWEAK) begin
+        seg_addr <= desc[1];
+        seg_left <= desc[2];
+      end
+    end
+    else if(seg == SEG_TWEAK) begin
+      win_tweak <= 1'b1;
+      win_pos   <= 7'd0;
+      win_end   <= seg_left[6:0];
+      seg_left  <= 32'd0;
+      state     <= ST_FEED;
+    end
+    else begin
+      m_axi_araddr  <= {seg_addr[31:2], 2'b00};
+      m_axi_arlen   <= {3'd0, rd_beats} - 8'd1;
+      m_axi_arvalid <= 1'b1;
+      rd_desc       <= 1'b0;
+      rd_err        <= 1'b0;
+      beat          <= 4'd0;
+      win_tweak     <= 1'b0;
+      win_pos       <= {5'd0, seg_addr[1:0]};
+      win_end       <= rd_end;
+      seg_addr      <= seg_addr + {25'd0, rd_take};
+      seg_left      <= seg_left - {25'd0, rd_take};
+      state         <= ST_AR;
+    end
+
+    ST_FEED   : if(win_pos == win_end)
+      state <= ST_SEG;
+    else begin
+      win_pos  <= win_pos + 7'd1;
+      msg_left <= msg_left - 32'd1;
+      if(is_shake) begin
+        pack     <= {pack[55:0], win_byte};
+        pack_cnt <= pack_cnt + 4'd1;
+        if(pack_cnt == 4'd7 || msg_left == 32'd1)
+          state <= ST_PUSH;
+      end
+      else begin
+        core_sha2_tdata <= win_byte;
+        core_sha2_tlast <= msg_left == 32'd1;
+        state           <= ST_PUSH;
+      end
+    end
+
+    // Both cores take data on the rising edge of their valid: raise it when the core is ready,
+    // drop it the next cycle. The last SHAKE word carries last_din and its byte count (0..8).
+    ST_PUSH   : if(is_shake) begin
+      if(core_shake_din_valid) begin
+        core_shake_din_valid <= 1'b0;
+        core_shake_last_din  <= 1'b0;
+        pack                 <= 64'd0;
+        pack_cnt             <= 4'd0;
+        if(core_shake_last_din) begin
+          core_shake_dout_ready <= 1'b1;
+          state                 <= ST_WAIT;
+        end
+        else
+          state <= ST_FEED;
+      end
+      else if(core_shake_din_ready) begin
+        core_shake_din           <= pack << {4'd8 - pack_cnt, 3'b000};
+        core_shake_last_din      <= msg_left == 32'd0;
+        core_shake_last_din_byte <= pack_cnt;
+        core_shake_din_valid     <= 1'b1;
+      end
+    end
+    else begin
+      if(core_sha2_tvalid) begin
+        core_sha2_tvalid <= 1'b0;
+        state            <= core_sha2_tlast ? ST_WAIT : ST_FEED;
+      end
+      else if(core_sha2_tready)
+        core_sha2_tvalid <= 1'b1;
+    end
+
+    ST_WAIT   : if(core_dout_valid) begin
+      digest                <= core_dout[1343 -: 512];
+      core_shake_dout_ready <= 1'b0;
+      core_sha2_tlast       <= 1'b0;
+      out_pos               <= 7'd0;
+      wr_cmpl               <= 1'b0;
+      state                 <= ST_OUT;
+    end
+
+    ST_OUT    : begin
+      if(out_pos != out_len) begin
+        m_axi_awaddr <= {wr_addr[31:2], 2'b00};
+        m_axi_wdata  <= wr_data;
+        m_axi_wstrb  <= wr_nmask[3:0] << wr_lane;
+        state        <= ST_W;
+        m_axi_awvalid <= 1'b1;
+        m_axi_wvalid  <= 1'b1;
+      end
+      else if(!wr_cmpl && cmpl_addr != 32'd0) begin
+        m_axi_awaddr  <= {cmpl_addr[31:2], 2'b00};
+        m_axi_wdata   <= {16'd0, cons_idx + 16'd1};
+        m_axi_wstrb   <= 4'hF;
+        m_axi_awvalid <= 1'b1;
+        m_axi_wvalid  <= 1'b1;
+        wr_cmpl       <= 1'b1;
+        state         <= ST_W;
+      end
+      else begin
+        cons_idx <= cons_idx + 16'd1;
+        state    <= ST_IDLE;
+      end
+    end
+
+    ST_W      : begin
+      if(m_axi_awready)
+        m_axi_awvalid <= 1'b0;
+      if(m_axi_wready)
+        m_axi_wvalid <= 1'b0;
+      if((~m_axi_awvalid | m_axi_awready) & (~m_axi_wvalid | m_axi_wready))
+        state <= ST_B;
+    end
+
+    ST_B      : if(m_axi_bvalid) begin
+      if(m_axi_bresp[1]) begin
+        error      <= 1'b1;
+        error_code <= ERR_WRITE;
+        state      <= ST_ERROR;
+      end
+      else begin
+        if(!wr_cmpl)
+          out_pos <= out_pos + {4'd0, wr_n};
+        state <= ST_OUT;
+      end
+    end
+
+    ST_ERROR  : if(!enable) begin
+      error      <= 1'b0;
+      error_code <= 3'd0;
+      cons_idx   <= 16'd0;
+      state      <= ST_IDLE;
+    end
+
+    default   : state <= ST_IDLE;
+  endcase
+end
+
+endmodule
@@ -4,18 +4,64 @@
 	module shake_sha2_ip_v1_0 #
 	(
 		// Users to add parameters here
-
+		// 1: M00_AXI goes to the ACP (coherent), 0: to an HP port
+		parameter integer C_M00_AXI_COHERENT	= 0,
+		parameter integer C_M00_AXI_ADDR_WIDTH	= 32,
+		parameter integer C_M00_AXI_DATA_WIDTH	= 32,
+		// Keccak rounds per clock: 1, 2, 3, 4, 6, 8, 12 or 24
+		parameter integer C_KECCAK_ROUNDS_PER_CYCLE	= 1,
+		// SHA-2 rounds per clock: 1, 2 or 4
+		parameter integer C_SHA2_ROUNDS_PER_CYCLE	= 1,
+		// 1: hash core on core_clk behind CDC FIFOs, 0: on s00_axi_aclk
+		parameter integer C_CORE_ASYNC_CLOCK	= 0,
 		// User parameters ends
 		// Do not modify the parameters beyond this line
 
 
 		// Parameters of Axi Slave Bus Interface S00_AXI
 		parameter integer C_S00_AXI_DATA_WIDTH	= 32,
-		parameter integer C_S00_AXI_ADDR_WIDTH	= 8
+		parameter integer C_S00_AXI_ADDR_WIDTH	= 9
 	)
 	(
 		// Users to add ports here
-
+		// AXI4 master of the descriptor-ring engine (clocked by s00_axi_aclk)
+		output wire [C_M00_AXI_ADDR_WIDTH-1 : 0] m00_axi_awaddr,
+		output wire [7 : 0] m00_axi_awlen,
+		output wire [2 : 0] m00_axi_awsize,
+		output wire [1 : 0] m00_axi_awburst,
+		output wire  m00_axi_awlock,
+		output wire [3 : 0] m00_axi_awcache,
+		output wire [2 : 0] m00_axi_awprot,
+		output wire [3 : 0] m00_axi_awqos,
+		output wire [4 : 0] m00_axi_awuser,
+		output wire  m00_axi_awvalid,
+		input wire  m00_axi_awready,
+		output wire [C_M00_AXI_DATA_WIDTH-1 : 0] m00_axi_wdata,
+		output wire [C_M00_AXI_DATA_WIDTH/8-1 : 0] m00_axi_wstrb,
+		output wire  m00_axi_wlast,
+		output wire  m00_axi_wvalid,
+		input wire  m00_axi_wready,
+		input wire [1 : 0] m00_axi_bresp,
+		input wire  m00_axi_bvalid,
+		output wire  m00_axi_bready,
+		output wire [C_M00_AXI_ADDR_WIDTH-1 : 0] m00_axi_araddr,
+		output wire [7 : 0] m00_axi_arlen,
+		output wire [2 : 0] m00_axi_arsize,
+		output wire [1 : 0] m00_axi_arburst,
+		output wire  m00_axi_arlock,
+		output wire [3 : 0] m00_axi_arcache,
+		output wire [2 : 0] m00_axi_arprot,
+		output wire [3 : 0] m00_axi_arqos,
+		output wire [4 : 0] m00_axi_aruser,
+		output wire  m00_axi_arvalid,
+		input wire  m00_axi_arready,
+		input wire [C_M00_AXI_DATA_WIDTH-1 : 0] m00_axi_rdata,
+		input wire [1 : 0] m00_axi_rresp,
+		input wire  m00_axi_rlast,
+		input wire  m00_axi_rvalid,
+		output wire  m00_axi_rready,
+		// Hash core clock, used when C_CORE_ASYNC_CLOCK = 1
+		input wire  core_clk,
 		// User ports ends
 		// Do not modify the ports beyond this line
 
@@ -45,9 +91,51 @@
 	);
 // Instantiation of Axi Bus Interface S00_AXI
 	shake_sha2_ip_v1_0_S00_AXI # ( 
+		.C_M00_AXI_COHERENT(C_M00_AXI_COHERENT),
+		.C_M00_AXI_ADDR_WIDTH(C_M00_AXI_ADDR_WIDTH),
+		.C_M00_AXI_DATA_WIDTH(C_M00_AXI_DATA_WIDTH),
+		.C_KECCAK_ROUNDS_PER_CYCLE(C_KECCAK_ROUNDS_PER_CYCLE),
+		.C_SHA2_ROUNDS_PER_CYCLE(C_SHA2_ROUNDS_PER_CYCLE),
+		.C_CORE_ASYNC_CLOCK(C_CORE_ASYNC_CLOCK),
 		.C_S_AXI_DATA_WIDTH(C_S00_AXI_DATA_WIDTH),
 		.C_S_AXI_ADDR_WIDTH(C_S00_AXI_ADDR_WIDTH)
 	) shake_sha2_ip_v1_0_S00_AXI_inst (
+		.m00_axi_awaddr(m00_axi_awaddr),
+		.m00_axi_awlen(m00_axi_awlen),
+		.m00_axi_awsize(m00_axi_awsize),
+		.m00_axi_awburst(m00_axi_awburst),
+		.m00_axi_awlock(m00_axi_awlock),
+		.m00_axi_awcache(m00_axi_awcache),
+		.m00_axi_awprot(m00_axi_awprot),
+		.m00_axi_awqos(m00_axi_awqos),
+		.m00_axi_awuser(m00_axi_awuser),
+		.m00_axi_awvalid(m00_axi_awvalid),
+		.m00_axi_awready(m00_axi_awready),
+		.m00_axi_wdata(m00_axi_wdata),
+		.m00_axi_wstrb(m00_axi_wstrb),
+		.m00_axi_wlast(m00_axi_wlast),
+		.m00_axi_wvalid(m00_axi_wvalid),
+		.m00_axi_wready(m00_axi_wready),
+		.m00_axi_bresp(m00_axi_bresp),
+		.m00_axi_bvalid(m00_axi_bvalid),
+		.m00_axi_bready(m00_axi_bready),
+		.m00_axi_araddr(m00_axi_araddr),
+		.m00_axi_arlen(m00_axi_arlen),
+		.m00_axi_arsize(m00_axi_arsize),
+		.m00_axi_arburst(m00_axi_arburst),
+		.m00_axi_arlock(m00_axi_arlock),
+		.m00_axi_arcache(m00_axi_arcache),
+		.m00_axi_arprot(m00_axi_arprot),
+		.m00_axi_arqos(m00_axi_arqos),
+		.m00_axi_aruser(m00_axi_aruser),
+		.m00_axi_arvalid(m00_axi_arvalid),
+		.m00_axi_arready(m00_axi_arready),
+		.m00_axi_rdata(m00_axi_rdata),
+		.m00_axi_rresp(m00_axi_rresp),
+		.m00_axi_rlast(m00_axi_rlast),
+		.m00_axi_rvalid(m00_axi_rvalid),
+		.m00_axi_rready(m00_axi_rready),
+		.core_clk(core_clk),
 		.S_AXI_ACLK(s00_axi_aclk),
 		.S_AXI_ARESETN(s00_axi_aresetn),
 		.S_AXI_AWADDR(s00_axi_awaddr),
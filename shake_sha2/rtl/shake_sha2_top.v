@@ -12,8 +12,10 @@
 //--------------------------------------------------------------------------------------------------------
 
 module shake_sha2_top #(
-    parameter ALGO_WIDTH = 4    // 0-2: Mode selection (SHA2: 0-1, SHAKE: 0-5)
+    parameter ALGO_WIDTH = 4,   // 0-2: Mode selection (SHA2: 0-1, SHAKE: 0-5)
                                  // 3: Algorithm selector (0=SHA2, 1=SHAKE)
+    parameter KECCAK_ROUNDS_PER_CYCLE = 1, // Keccak rounds per clock (divides 24)
+    parameter SHA2_ROUNDS_PER_CYCLE = 1    // SHA-2 rounds per clock: 1, 2 or 4
 )(
     // Clock and reset
     input  wire              clk,
@@ -49,7 +51,13 @@ module shake_sha2_top #(
     
     // Shared Hash Output Interface (no metadata - pure hash data only)
     output wire  [1343:0]    dout,         // Hash output: SHA2 padded to 1344-bit, SHAKE full width
-    output wire              dout_valid    // Hash output valid signal
+    output wire              dout_valid,   // Hash output valid signal
+
+    // SHAKE input flow control: a din_valid rising edge is only taken while high
+    output wire              shake_din_ready,
+
+    // One clock per Keccak-f permutation started (performance counters)
+    output wire              keccak_perm
 );
 
 //--------------------------------------------------------------------------------------------------------
@@ -69,7 +77,9 @@ wire [31:0] sha2_oid_int;
 wire [60:0] sha2_olen_int;
 wire [511:0] sha2_osha;
 
-sha2_top u_sha2_top (
+sha2_top #(
+    .ROUNDS_PER_CYCLE ( SHA2_ROUNDS_PER_CYCLE )
+) u_sha2_top (
     .rstn        ( rstn           ),
     .clk         ( clk            ),
     .mode        ( algo_is_sha512 ),  // 0: SHA-256, 1: SHA-512
@@ -90,7 +100,9 @@ sha2_top u_sha2_top (
 wire        shake_ovalid_int;
 wire [1343:0] shake_odata;
 
-shake_top u_shake_top (
+shake_top #(
+    .KECCAK_ROUNDS_PER_CYCLE ( KECCAK_ROUNDS_PER_CYCLE )
+) u_shake_top (
     .clk_i              ( clk                ),
     .rst_ni             ( rstn               ),
     .mode_i             ( shake_variant      ),
@@ -102,7 +114,9 @@ shake_top u_shake_top (
     .dout_ready_i       ( shake_dout_ready_i ),
     .sha3_hold          ( shake_hold         ),
     .dout_full_o        ( shake_odata        ),
-    .dout_full_valid_o  ( shake_ovalid_int   )
+    .dout_full_valid_o  ( shake_ovalid_int   ),
+    .din_ready_o        ( shake_din_ready    ),
+    .perm_o             ( keccak_perm        )
 );
 
 //--------------------------------------------------------------------------------------------------------
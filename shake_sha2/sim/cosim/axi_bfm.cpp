@@ -0,0 +1,337 @@
+// AXI-Lite bus functional model of the Zynq GP0 master: implements hw_model.h
+// on the Verilated shake_sha2_ip_v1_0, so fpga_sha_driver.c runs against the
+// RTL. One call is one AXI-Lite transaction; the simulation advances one
+// s00_axi_aclk per clock of the handshake and stops between calls. core_clk
+// follows s00_axi_aclk. The M00_AXI port of the descriptor ring is answered
+// from the memory given to hw_model_dma_map(), one read beat per clock after
+// HW_MODEL_DMA_READ_CYCLES and a response HW_MODEL_DMA_WRITE_CYCLES after each
+// write; other addresses answer SLVERR.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "verilated.h"
+#include "Vshake_sha2_ip_v1_0.h"
+
+extern "C" {
+#include "hw_model.h"
+#include "xparameters.h"
+}
+
+#define IP_BASE  XPAR_SHAKE_SHA2_IP_0_S00_AXI_BASEADDR
+#define IP_SPAN  0x200      // C_S00_AXI_ADDR_WIDTH = 9
+
+// Clocks a handshake may take before the simulation is abandoned
+#define HANDSHAKE_TIMEOUT 1000
+
+static Vshake_sha2_ip_v1_0 *top;
+static hw_model_stats stats;
+static uint32_t algo_mode;  // REG0[3:0] as last written
+
+// M00_AXI slave
+#define DMA_WINDOWS 16
+#define AXI_SLVERR  2
+
+static struct {
+    uint32_t addr;
+    size_t len;
+    uint8_t *mem;
+} dma_map[DMA_WINDOWS];
+static unsigned dma_windows;
+
+static struct {
+    bool r;             // read burst in flight
+    uint32_t raddr;
+    unsigned rbeats;    // beats left
+    unsigned rwait;     // clocks to the next beat
+    bool aw, w;         // write address / data taken
+    uint32_t waddr, wdata, wstrb;
+    unsigned bwait;
+} m00;
+
+double sc_time_stamp()
+{
+    return (double)stats.now * 10.0;   // 100MHz
+}
+
+static uint8_t *dma_ptr(uint32_t addr)
+{
+    for (unsigned i = 0; i < dma_windows; i++) {
+        if (addr >= dma_map[i].addr && addr - dma_map[i].addr + 4 <= dma_map[i].len) {
+            return dma_map[i].mem + (addr - dma_map[i].addr);
+        }
+    }
+    return NULL;
+}
+
+static void m00_drive()
+{
+    uint8_t *p;
+
+    top->m00_axi_arready = !m00.r;
+    top->m00_axi_rvalid  = m00.r && m00.rwait == 0;
+    top->m00_axi_rlast   = m00.rbeats == 1;
+    p = dma_ptr(m00.raddr);
+    if (p) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        top->m00_axi_rdata = v;
+    }
+    top->m00_axi_rresp   = p ? 0 : AXI_SLVERR;
+
+    top->m00_axi_awready = !m00.aw;
+    top->m00_axi_wready  = !m00.w;
+    top->m00_axi_bvalid  = m00.aw && m00.w && m00.bwait == 0;
+    top->m00_axi_bresp   = dma_ptr(m00.waddr & ~3u) ? 0 : AXI_SLVERR;
+}
+
+// Handshakes of the clock edge that follows
+static void m00_clock()
+{
+    bool ar = top->m00_axi_arvalid && top->m00_axi_arready;
+    bool r  = top->m00_axi_rvalid && top->m00_axi_rready;
+    bool aw = top->m00_axi_awvalid && top->m00_axi_awready;
+    bool w  = top->m00_axi_wvalid && top->m00_axi_wready;
+    bool b  = top->m00_axi_bvalid && top->m00_axi_bready;
+
+    if (m00.r && m00.rwait) {
+        m00.rwait--;
+    }
+    if (r && --m00.rbeats == 0) {
+        m00.r = false;
+    }
+    else if (r) {
+        m00.raddr += 4;
+    }
+    if (ar) {
+        m00.r = true;
+        m00.raddr = top->m00_axi_araddr;
+        m00.rbeats = top->m00_axi_arlen + 1u;
+        m00.rwait = HW_MODEL_DMA_READ_CYCLES;
+    }
+
+    if (m00.aw && m00.w && m00.bwait) {
+        m00.bwait--;
+    }
+    if (b) {
+        m00.aw = m00.w = false;
+    }
+    if (aw) {
+        m00.aw = true;
+        m00.waddr = top->m00_axi_awaddr;
+    }
+    if (w) {
+        m00.w = true;
+        m00.wdata = top->m00_axi_wdata;
+        m00.wstrb = top->m00_axi_wstrb;
+    }
+    if ((aw || w) && m00.aw && m00.w) {
+        uint8_t *p = dma_ptr(m00.waddr & ~3u);
+        for (int i = 0; p && i < 4; i++) {
+            if (m00.wstrb >> i & 1) {
+                p[i] = (uint8_t)(m00.wdata >> (8 * i));
+            }
+        }
+        m00.bwait = HW_MODEL_DMA_WRITE_CYCLES;
+    }
+}
+
+static void tick()
+{
+    top->s00_axi_aclk = 0;
+    top->core_clk = 0;
+    top->eval();
+    m00_clock();
+    top->s00_axi_aclk = 1;
+    top->core_clk = 1;
+    top->eval();
+    m00_drive();
+    stats.now++;
+}
+
+static void guard(int clocks, const char *what, uint32_t offset)
+{
+    if (clocks > HANDSHAKE_TIMEOUT) {
+        fprintf(stderr, "axi_bfm: no %s handshake at offset 0x%03x after %d clocks\n",
+                what, (unsigned)offset, clocks);
+        exit(1);
+    }
+}
+
+// Returns 0 and the register offset for an address in the IP, -1 otherwise
+static int ip_offset(uintptr_t addr, uint32_t *offset)
+{
+    if (addr < IP_BASE || addr >= IP_BASE + IP_SPAN) {
+        stats.other++;
+        return -1;
+    }
+    if (!top) {
+        hw_model_reset();
+    }
+    *offset = (uint32_t)(addr - IP_BASE);
+    return 0;
+}
+
+static void account(uint32_t offset, int write, uint32_t value, uint64_t clocks)
+{
+    hw_model_mode_stats *s = &stats.mode[algo_mode];
+
+    s->cycles += clocks;
+    if (!write) {
+        s->reads++;
+        if (offset == 0x1C || offset == 0x120) {    // STATUS, completion FIFO status
+            s->polls++;
+        }
+        return;
+    }
+    s->writes++;
+    // A SHAKE/SHA3 job starts with REG0 start, a SHA-2 job ends with tvalid and tlast in REG6
+    if (offset == 0x00) {
+        algo_mode = value & 0xF;
+        if ((value & 0x18) == 0x18) {
+            stats.mode[algo_mode].jobs++;
+        }
+    }
+    else if (offset == 0x18 && (value & 0x3) == 0x3 && !(algo_mode & 0x8)) {
+        s->jobs++;
+    }
+}
+
+void hw_model_reset(void)
+{
+    if (!top) {
+        top = new Vshake_sha2_ip_v1_0;
+    }
+    top->s00_axi_awvalid = 0;
+    top->s00_axi_awprot  = 0;
+    top->s00_axi_wvalid  = 0;
+    top->s00_axi_wstrb   = 0xF;
+    top->s00_axi_bready  = 0;
+    top->s00_axi_arvalid = 0;
+    top->s00_axi_arprot  = 0;
+    top->s00_axi_rready  = 0;
+    m00 = {};
+    m00_drive();
+
+    top->s00_axi_aresetn = 0;
+    for (int i = 0; i < 16; i++) {
+        tick();
+    }
+    top->s00_axi_aresetn = 1;
+    tick();
+
+    stats = hw_model_stats();
+    algo_mode = 0;
+}
+
+uint32_t hw_model_read(uintptr_t addr)
+{
+    uint32_t offset, data = 0;
+    uint64_t start = stats.now;
+    int clocks = 0;
+    bool ar = true, r = true;
+
+    if (ip_offset(addr, &offset)) {
+        return 0;
+    }
+    top->s00_axi_araddr  = offset;
+    top->s00_axi_arvalid = 1;
+    top->s00_axi_rready  = 1;
+    while (ar || r) {
+        top->eval();
+        bool ar_done = ar && top->s00_axi_arready;
+        bool r_done  = !ar && r && top->s00_axi_rvalid;
+        if (r_done) {
+            data = top->s00_axi_rdata;
+        }
+        tick();
+        if (ar_done) {
+            ar = false;
+            top->s00_axi_arvalid = 0;
+        }
+        if (r_done) {
+            r = false;
+            top->s00_axi_rready = 0;
+        }
+        guard(++clocks, "read", offset);
+    }
+    account(offset, 0, data, stats.now - start);
+    return data;
+}
+
+void hw_model_write(uintptr_t addr, uint32_t value)
+{
+    uint32_t offset;
+    uint64_t start = stats.now;
+    int clocks = 0;
+    bool aw = true, w = true, b = true;
+
+    if (ip_offset(addr, &offset)) {
+        return;
+    }
+    top->s00_axi_awaddr  = offset;
+    top->s00_axi_awvalid = 1;
+    top->s00_axi_wdata   = value;
+    top->s00_axi_wvalid  = 1;
+    top->s00_axi_bready  = 1;
+    while (aw || w || b) {
+        top->eval();
+        bool aw_done = aw && top->s00_axi_awready;
+        bool w_done  = w && top->s00_axi_wready;
+        bool b_done  = !aw && !w && b && top->s00_axi_bvalid;
+        tick();
+        if (aw_done) {
+            aw = false;
+            top->s00_axi_awvalid = 0;
+        }
+        if (w_done) {
+            w = false;
+            top->s00_axi_wvalid = 0;
+        }
+        if (b_done) {
+            b = false;
+            top->s00_axi_bready = 0;
+        }
+        guard(++clocks, "write", offset);
+    }
+    account(offset, 1, value, stats.now - start);
+}
+
+int hw_model_dma_map(void *mem, size_t len)
+{
+    uint64_t addr = (uint32_t)(uintptr_t)mem;
+
+    if (dma_windows == DMA_WINDOWS || len == 0 || addr + (uint64_t)len > 0x100000000ULL) {
+        return -1;
+    }
+    dma_map[dma_windows].addr = (uint32_t)addr;
+    dma_map[dma_windows].len = len;
+    dma_map[dma_windows].mem = (uint8_t *)mem;
+    dma_windows++;
+    return 0;
+}
+
+void hw_model_get_stats(hw_model_stats *out)
+{
+    *out = stats;
+}
+
+// For host/hash_replay.c: the latencies are those of the RTL (IP_PARAMS), so
+// a configuration only resets the IP
+void hw_model_default_config(hw_model_config *cfg)
+{
+    cfg->read_cycles   = HW_MODEL_READ_CYCLES;
+    cfg->write_cycles  = HW_MODEL_WRITE_CYCLES;
+    cfg->keccak_cycles = HW_MODEL_KECCAK_CYCLES;
+    cfg->sha256_cycles = HW_MODEL_SHA256_CYCLES;
+    cfg->sha512_cycles = HW_MODEL_SHA512_CYCLES;
+    cfg->cmpl_depth    = 4;
+    cfg->dma_read_cycles  = HW_MODEL_DMA_READ_CYCLES;
+    cfg->dma_write_cycles = HW_MODEL_DMA_WRITE_CYCLES;
+}
+
+void hw_model_configure(const hw_model_config *)
+{
+    hw_model_reset();
+}
@@ -0,0 +1,122 @@
+/*
+ * One keypair, signature and verification with the parameter set of the
+ * build, reporting the AXI clocks each step keeps the bus busy, and the
+ * verification once more with the hashdag batches on the descriptor ring
+ * (hashdag_hw.h), which drives M00_AXI, and for SHA-2 on the tagged jobs of
+ * the completion FIFO. The performance counters must account for the ring
+ * verification. Linked with
+ * axi_bfm.cpp the clocks are those of the RTL; with host/hw_model.c, those
+ * of the C model.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "api.h"
+#include "hashdag.h"
+#include "hashdag_hw.h"
+#include "randombytes.h"
+#include "hw_model.h"
+#include "fpga_sha_driver.h"
+
+#define MLEN 32
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+/* IP clocks since the last call */
+static unsigned long long lap(void)
+{
+    static uint64_t last;
+    hw_model_stats st;
+    uint64_t d;
+
+    hw_model_get_stats(&st);
+    d = st.now - last;
+    last = st.now;
+    return (unsigned long long)d;
+}
+
+/* Clocks the counters may differ from the bus time, for the snapshot write */
+#define PERF_SLACK 64
+
+static spx_hw_ring_area ring;
+
+/* Returns 1 if the counters read after a ring run of clocks add up. */
+static int perf_ok(const HwPerfCounters *c, unsigned long long clocks)
+{
+    unsigned long long total = (unsigned long long)c->busy + c->idle;
+
+    printf("  counters: busy %u, idle %u, %u permutations, %u SHA-2 blocks, "
+           "S00 %u/%u, M00 %u/%u beats (read/write)\n",
+           c->busy, c->idle, c->keccak_perms, c->sha2_blocks,
+           c->axi_reads, c->axi_writes, c->dma_reads, c->dma_writes);
+    return total + PERF_SLACK >= clocks && total <= clocks + PERF_SLACK &&
+           c->keccak_perms + c->sha2_blocks > 0 &&
+           c->axi_reads > 0 && c->axi_writes > 0 &&
+           c->dma_reads > 0 && c->dma_writes > 0;
+}
+
+int main(void)
+{
+    static unsigned char pk[CRYPTO_PUBLICKEYBYTES];
+    static unsigned char sk[CRYPTO_SECRETKEYBYTES];
+    static unsigned char sm[CRYPTO_BYTES + MLEN];
+    static unsigned char mout[CRYPTO_BYTES + MLEN];
+    unsigned char m[MLEN];
+    unsigned long long smlen, mlen;
+    unsigned long long keygen, sign, verify, ring_verify, tags_verify = 0;
+    int ok, ring_ok, tags_ok = 1, counters_ok;
+    HwPerfCounters perf;
+
+    hw_model_reset();
+    randombytes(m, MLEN);
+    lap();
+
+    crypto_sign_keypair(pk, sk);
+    keygen = lap();
+    crypto_sign(sm, &smlen, m, MLEN, sk);
+    sign = lap();
+    ok = crypto_sign_open(mout, &mlen, sm, smlen, pk) == 0 &&
+         mlen == MLEN && memcmp(m, mout, MLEN) == 0;
+    verify = lap();
+
+    if (hw_model_dma_map(&ring, sizeof(ring)) ||
+            spx_hw_ring_install(&ring, 1 << SPX_HW_RING_ORDER)) {
+        printf("Setting up the descriptor ring failed\n");
+        return 1;
+    }
+    hw_perf_clear();
+    lap();
+    ring_ok = crypto_sign_open(mout, &mlen, sm, smlen, pk) == 0 &&
+              mlen == MLEN && memcmp(m, mout, MLEN) == 0;
+    ring_verify = lap();
+    hw_perf_read(&perf, 0);
+    spx_set_hash_kernel(NULL, 0);
+
+    if (spx_hw_sha2_tags_install() == 0) {
+        lap();
+        tags_ok = crypto_sign_open(mout, &mlen, sm, smlen, pk) == 0 &&
+                  mlen == MLEN && memcmp(m, mout, MLEN) == 0;
+        tags_verify = lap();
+        spx_set_hash_kernel(NULL, 0);
+    }
+
+    printf("%s: keygen %llu, sign %llu, verify %llu clocks; %s\n",
+           STR(PARAMS), keygen, sign, verify, ok ? "verified" : "FAILED");
+    printf("  verify through the descriptor ring %llu clocks; %s\n",
+           ring_verify, ring_ok ? "verified" : "FAILED");
+    counters_ok = perf_ok(&perf, ring_verify);
+    if (!counters_ok) {
+        printf("  counters do not add up to the ring run\n");
+    }
+    if (tags_verify > 0) {
+        printf("  verify through the SHA-2 tag queue %llu clocks; %s\n",
+               tags_verify, tags_ok ? "verified" : "FAILED");
+    }
+    if (sign > 0) {
+        printf("  %.3f signatures/s at 100 MHz, bus time only\n", 1e8 / (double)sign);
+    }
+    hw_model_print_stats();
+    return ok && ring_ok && tags_ok && counters_ok ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+`timescale 1 ns / 1 ps
+//--------------------------------------------------------------------------------------------------------
+// Module  : ila_0
+// Type    : simulation
+// Standard: Verilog 2001 (IEEE1364-2001)
+// Function: Empty stand-in for the Vivado ILA instantiated in shake_sha2_top.v, for Verilator.
+//--------------------------------------------------------------------------------------------------------
+
+/* verilator lint_off UNUSED */
+module ila_0 (
+    input  wire              clk,
+    input  wire  [1799:0]    probe0
+);
+
+endmodule
+/* verilator lint_on UNUSED */
@@ -15,6 +15,7 @@ reg                      dout_ready_i;
 reg                      sha3_hold;
 wire   [1343:0]         dout_full_o;
 wire                     dout_full_valid_o;
+wire                     din_ready_o;
 
 // 初始?
 initial begin
@@ -87,6 +88,7 @@ initial begin
     // Test 2: SHA3 Hold测试
     //==========================================================================
     #100
+    check_unroll;
     $display("\n=== Test 2: SHA3 Hold Test ===");
     
     @(posedge clk_i) #(DELAY);
@@ -127,6 +129,7 @@ initial begin
     // Test 3: 不同模式测试
     //==========================================================================
     #100
+    check_unroll;
     $display("\n=== Test 3: Different Modes Test ===");
     
 
@@ -167,6 +170,7 @@ initial begin
     #10 dout_ready_i = 0;
 
     // 测试SHA3-256
+    check_unroll;
     #100;
     @(posedge clk_i) #(DELAY);
     mode_i = 3'b010;  // SHA3-256
@@ -190,6 +194,28 @@ initial begin
     $display("SHA3-256 output: %h", dout_full_o);
     #10 dout_ready_i = 0;
 
+    check_unroll;
+
+    //==========================================================================
+    // Test 4: known answers, SHAKE256("") and SHAKE256(200 x 0xA3), which
+    // absorbs two blocks. The first squeezed block is checked in full.
+    //==========================================================================
+    #100
+    $display("\n=== Test 4: SHAKE256 Known Answer Test ===");
+    kat_start(3'b001);
+    kat_word(64'h0, 1, 0);
+    kat_check(KAT_SHAKE256_EMPTY, "SHAKE256(\"\")");
+    check_unroll;
+
+    kat_start(3'b001);
+    for (kat_i=0; kat_i < 24; kat_i=kat_i+1)
+        kat_word({8{8'hA3}}, 0, 0);
+    kat_word({8{8'hA3}}, 1, 8);
+    kat_check(KAT_SHAKE256_A3_200, "SHAKE256(200 x 0xA3)");
+    check_unroll;
+
+    $display("\nUnrolled Keccak: %0d mismatch(es)", unroll_errors);
+    $display("Known answers: %0d mismatch(es)", kat_errors);
     #100 $finish;
 end
 
@@ -219,7 +245,162 @@ shake_top dut (
     .dout_ready_i     (dout_ready_i),
     .sha3_hold        (sha3_hold),
     .dout_full_o      (dout_full_o),
-    .dout_full_valid_o(dout_full_valid_o)
+    .dout_full_valid_o(dout_full_valid_o),
+    .din_ready_o      (din_ready_o)
 );
 
+//==========================================================================
+// Unrolled Keccak: one more shake_top per KECCAK_ROUNDS_PER_CYCLE factor on
+// the same stimulus. The first block squeezed after each start must match
+// dut (one round per clock); check_unroll also reports how many cycles
+// earlier it arrived.
+//==========================================================================
+localparam NR_UNROLL = 7;
+
+function integer unroll_factor;
+    input integer k;
+    begin
+        case (k)
+            0:       unroll_factor = 2;
+            1:       unroll_factor = 3;
+            2:       unroll_factor = 4;
+            3:       unroll_factor = 6;
+            4:       unroll_factor = 8;
+            5:       unroll_factor = 12;
+            default: unroll_factor = 24;
+        endcase
+    end
+endfunction
+
+reg    [1343:0]         ref_first;
+reg                      ref_seen;
+time                     ref_time;
+reg    [1343:0]         unroll_first [0:NR_UNROLL-1];
+reg                      unroll_seen  [0:NR_UNROLL-1];
+time                     unroll_time  [0:NR_UNROLL-1];
+integer                  unroll_errors = 0;
+
+always @(posedge clk_i) begin
+    if(~rst_ni | start_i)
+        ref_seen <= 0;
+    else if(dout_full_valid_o & ~ref_seen) begin
+        ref_first <= dout_full_o;
+        ref_seen  <= 1;
+        ref_time  <= $time;
+    end
+end
+
+genvar u;
+generate
+    for (u=0; u < NR_UNROLL; u=u+1)
+    begin: unroll
+
+      wire   [1343:0]         dout_full;
+      wire                     dout_full_valid;
+
+      shake_top #(
+          .KECCAK_ROUNDS_PER_CYCLE (unroll_factor(u))
+      ) dut_unroll (
+          .clk_i            (clk_i),
+          .rst_ni           (rst_ni),
+          .mode_i           (mode_i),
+          .start_i          (start_i),
+          .din_i            (din_i),
+          .din_valid_i      (din_valid_i),
+          .last_din_i       (last_din_i),
+          .last_din_byte_i  (last_din_byte_i),
+          .dout_ready_i     (dout_ready_i),
+          .sha3_hold        (sha3_hold),
+          .dout_full_o      (dout_full),
+          .dout_full_valid_o(dout_full_valid),
+          .din_ready_o      ()
+      );
+
+      always @(posedge clk_i) begin
+          if(~rst_ni | start_i)
+              unroll_seen[u] <= 0;
+          else if(dout_full_valid & ~unroll_seen[u]) begin
+              unroll_first[u] <= dout_full;
+              unroll_seen[u]  <= 1;
+              unroll_time[u]  <= $time;
+          end
+      end
+    end
+endgenerate
+
+task check_unroll;
+    integer k;
+    begin
+        for (k=0; k < NR_UNROLL; k=k+1) begin
+            if(unroll_seen[k] !== ref_seen || (ref_seen && unroll_first[k] !== ref_first)) begin
+                $display("ERROR: %0d rounds/cycle: first block differs from 1 round/cycle", unroll_factor(k));
+                unroll_errors = unroll_errors + 1;
+            end else if(ref_seen)
+                $display("%0d rounds/cycle: match, %0d cycles earlier", unroll_factor(k),
+                         (ref_time - unroll_time[k]) / PERIOD);
+        end
+    end
+endtask
+
+//==========================================================================
+// Known-answer tests. Message bytes go in MSB first (byte 0 in din_i[63:56]),
+// one word per din_valid_i rising edge; the first squeezed byte is
+// dout_full_o[1343:1336].
+//==========================================================================
+localparam [1087:0] KAT_SHAKE256_EMPTY  = 1088'h46b9dd2b0ba88d13233b3feb743eeb243fcd52ea62b81b82b50c27646ed5762fd75dc4ddd8c0f200cb05019d67b592f6fc821c49479ab48640292eacb3b7c4be141e96616fb13957692cc7edd0b45ae3dc07223c8e92937bef84bc0eab862853349ec75546f58fb7c2775c38462c5010d846c185c15111e595522a6bcd16cf86f3d122109e3b1fdd;
+localparam [1087:0] KAT_SHAKE256_A3_200 = 1088'hcd8a920ed141aa0407a22d59288652e9d9f1a7ee0c1e7c1ca699424da84a904d2d700caae7396ece96604440577da4f3aa22aeb8857f961c4cd8e06f0ae6610b1048a7f64e1074cd629e85ad7566048efc4fb500b486a3309a8f26724c0ed628001a1099422468de726f1061d99eb9e93604d5aa7467d4b1bd6484582a384317d7f47d750b8f5499;
+
+integer                  kat_errors = 0;
+integer                  kat_i;
+
+task kat_start;
+    input [2:0] mode;
+    begin
+        @(posedge clk_i) #(DELAY);
+        mode_i = mode;
+        start_i = 1;
+        @(posedge clk_i) #(DELAY) start_i = 0;
+    end
+endtask
+
+task kat_word;
+    input [63:0] word;
+    input        last;
+    input [3:0]  nbytes;
+    begin
+        while(!din_ready_o)
+            @(posedge clk_i) #(DELAY);
+        din_i = word;
+        last_din_i = last;
+        last_din_byte_i = nbytes;
+        din_valid_i = 1;
+        @(posedge clk_i) #(DELAY);
+        din_valid_i = 0;
+        last_din_i = 0;
+        @(posedge clk_i) #(DELAY);
+    end
+endtask
+
+task kat_check;
+    input [1087:0]    expected;
+    input [8*24-1:0]  name;
+    integer           cycles;
+    begin
+        cycles = 0;
+        @(negedge clk_i);
+        while(!dout_full_valid_o && cycles < 1000) begin
+            @(negedge clk_i);
+            cycles = cycles + 1;
+        end
+        if(!dout_full_valid_o) begin
+            $display("ERROR: %0s: no output", name);
+            kat_errors = kat_errors + 1;
+        end else if(dout_full_o[1343:256] !== expected) begin
+            $display("ERROR: %0s: got %h", name, dout_full_o[1343:256]);
+            kat_errors = kat_errors + 1;
+        end else
+            $display("%0s: match", name);
+    end
+endtask
+
 endmodule
\ No newline at end of file
@@ -3,6 +3,8 @@
 // Type    : simulation, top
 // Standard: Verilog 2001 (IEEE1364-2001)
 // Function: Unified testbench for SHA-2 top module (SHA-256 and SHA-512)
+//           Also runs the stimulus through 2 and 4 rounds per clock and
+//           reports the clocks from the last byte to ovalid for each
 //--------------------------------------------------------------------------------------------------------
 
 `timescale 1ns/1ps
@@ -71,7 +73,7 @@ always @(posedge clk) begin
         if(mode)
             $display("  Hash    = %h", osha);
         else
-            $display("  Hash    = %h", osha[255:0]);
+            $display("  Hash    = %h", osha[511:256]);
         $display("===========================================");
     end
 end
@@ -94,6 +96,9 @@ task send_bytes;
             tdata  <= data_array[i*8 +: 8];
             tlast  <= (i == 0);
             
+            // The cores take a byte on the rising edge of tvalid
+            @(posedge clk);
+            tvalid <= 1'b0;
             @(posedge clk);
             while(~tready) @(posedge clk);
         end
@@ -130,6 +135,7 @@ initial begin
         8);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-256 Test 2: 64-bit data 2
     $display("\n--- SHA-256 Test 2: 64'hFFFFFFFF00000000 (8 bytes) ---");
@@ -138,6 +144,7 @@ initial begin
         8);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-256 Test 3: 128-bit data 1
     $display("\n--- SHA-256 Test 3: 128'hA5A5A5A5A5A5A5A55A5A5A5A5A5A5A5A (16 bytes) ---");
@@ -147,6 +154,7 @@ initial begin
         16);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-256 Test 4: 128-bit data 2
     $display("\n--- SHA-256 Test 4: 128'h550E8400E29B41D4A716446655440000 (16 bytes) ---");
@@ -156,6 +164,7 @@ initial begin
         16);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-256 Test 5: 256-bit data 1
     $display("\n--- SHA-256 Test 5: 256'h000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F (32 bytes) ---");
@@ -167,6 +176,7 @@ initial begin
         32);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-256 Test 6: 256-bit data 2
     $display("\n--- SHA-256 Test 6: 256'h5348413225365f4249545f484153485f544553545f44415441212100000000 (32 bytes) ---");
@@ -178,6 +188,7 @@ initial begin
         32);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     //========================================
     // Part 2: SHA-512 Mode Tests (6 data groups - same data)
@@ -196,6 +207,7 @@ initial begin
         8);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-512 Test 8: 64-bit data 2 (same as Test 2)
     $display("\n--- SHA-512 Test 8: 64'hFFFFFFFF00000000 (8 bytes) ---");
@@ -204,6 +216,7 @@ initial begin
         8);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-512 Test 9: 128-bit data 1 (same as Test 3)
     $display("\n--- SHA-512 Test 9: 128'hA5A5A5A5A5A5A5A55A5A5A5A5A5A5A5A (16 bytes) ---");
@@ -213,6 +226,7 @@ initial begin
         16);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-512 Test 10: 128-bit data 2 (same as Test 4)
     $display("\n--- SHA-512 Test 10: 128'h550E8400E29B41D4A716446655440000 (16 bytes) ---");
@@ -222,6 +236,7 @@ initial begin
         16);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-512 Test 11: 256-bit data 1 (same as Test 5)
     $display("\n--- SHA-512 Test 11: 256'h000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F   (32 bytes) ---");
@@ -233,6 +248,7 @@ initial begin
         32);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // SHA-512 Test 12: 256-bit data 2 (same as Test 6)
     $display("\n--- SHA-512 Test 12: 256'h5348413225365f4249545f484153485f544553545f44415441212100000000 (32 bytes) ---");
@@ -244,6 +260,7 @@ initial begin
         32);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     //========================================
     // Part 3: Mode Switching Test
@@ -262,6 +279,7 @@ initial begin
         8);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
     // Quick switch to SHA-512
     $display("\n--- Quick Switch: SHA-512 ---");
@@ -273,16 +291,160 @@ initial begin
         16);
     wait(ovalid);
     repeat(10) @(posedge clk);
+    check_unroll;
     
+    //========================================
+    // Part 4: NIST known answers (FIPS 180-4 examples)
+    //========================================
+    $display("\n");
+    $display("*******************************************");
+    $display("*       NIST KNOWN ANSWER TESTS           *");
+    $display("*******************************************");
+    mode <= 1'b0;
+    repeat(2) @(posedge clk);
+
+    $display("\n--- SHA-256 KAT 1: \"abc\" ---");
+    send_bytes(32'h2571, "abc", 3);
+    wait(ovalid);
+    repeat(10) @(posedge clk);
+    kat_check(256'hba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad);
+    check_unroll;
+
+    $display("\n--- SHA-256 KAT 2: 448-bit message, two blocks ---");
+    send_bytes(32'h2572, "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 56);
+    wait(ovalid);
+    repeat(10) @(posedge clk);
+    kat_check(256'h248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1);
+    check_unroll;
+
+    mode <= 1'b1;
+    repeat(2) @(posedge clk);
+
+    $display("\n--- SHA-512 KAT 1: \"abc\" ---");
+    send_bytes(32'h5171, "abc", 3);
+    wait(ovalid);
+    repeat(10) @(posedge clk);
+    kat_check(512'hddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f);
+    check_unroll;
+
+    $display("\n--- SHA-512 KAT 2: 896-bit message, two blocks ---");
+    send_bytes(32'h5172, "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 112);
+    wait(ovalid);
+    repeat(10) @(posedge clk);
+    kat_check(512'h8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909);
+    check_unroll;
+
     // Wait for completion
     repeat(200) @(posedge clk);
     
     $display("\n===========================================");
-    $display("All 14 tests completed successfully!");
+    $display("Unrolled compression: %0d mismatch(es)", unroll_errors);
+    $display("Known answers: %0d mismatch(es)", kat_errors);
+    $display("All 18 tests completed!");
     $display("===========================================");
     $finish;
 end
 
+//========================================
+// Unrolled compression: one more sha2_top per ROUNDS_PER_CYCLE factor on the
+// same stimulus. Each result must match u_sha2_top (one round per clock);
+// check_unroll reports the clocks from the last byte to ovalid for all.
+//========================================
+localparam NR_UNROLL = 2;
+
+function integer unroll_factor;
+    input integer k;
+    begin
+        unroll_factor = (k == 0) ? 2 : 4;
+    end
+endfunction
+
+time         last_time;
+reg  [511:0] ref_sha;
+reg  [ 31:0] ref_id;
+time         ref_time;
+reg  [511:0] unroll_sha  [0:NR_UNROLL-1];
+reg  [ 31:0] unroll_id   [0:NR_UNROLL-1];
+time         unroll_time [0:NR_UNROLL-1];
+integer      unroll_errors = 0;
+
+always @(posedge clk) begin
+    if(tvalid & tlast)
+        last_time <= $time;
+    if(ovalid) begin
+        ref_sha  <= osha;
+        ref_id   <= oid;
+        ref_time <= $time;
+    end
+end
+
+genvar u;
+generate
+    for (u=0; u < NR_UNROLL; u=u+1)
+    begin: unroll
+
+      wire         ovalid_u;
+      wire [ 31:0] oid_u;
+      wire [511:0] osha_u;
+
+      sha2_top #(
+          .ROUNDS_PER_CYCLE ( unroll_factor(u) )
+      ) u_sha2_top_unroll (
+          .rstn   ( rstn     ),
+          .clk    ( clk      ),
+          .mode   ( mode     ),
+          .tvalid ( tvalid   ),
+          .tready (          ),
+          .tlast  ( tlast    ),
+          .tid    ( tid      ),
+          .tdata  ( tdata    ),
+          .ovalid ( ovalid_u ),
+          .oid    ( oid_u    ),
+          .olen   (          ),
+          .osha   ( osha_u   )
+      );
+
+      always @(posedge clk) begin
+          if(ovalid_u) begin
+              unroll_sha[u]  <= osha_u;
+              unroll_id[u]   <= oid_u;
+              unroll_time[u] <= $time;
+          end
+      end
+    end
+endgenerate
+
+task check_unroll;
+    integer k;
+    begin
+        $display("  Clocks from last byte to ovalid: %0d at 1 round/clock",
+                 (ref_time - last_time) / 10);
+        for (k=0; k < NR_UNROLL; k=k+1) begin
+            if(unroll_sha[k] !== ref_sha || unroll_id[k] !== ref_id) begin
+                $display("  ERROR: %0d rounds/clock: result differs from 1 round/clock", unroll_factor(k));
+                unroll_errors = unroll_errors + 1;
+            end else
+                $display("  Clocks from last byte to ovalid: %0d at %0d rounds/clock",
+                         (unroll_time[k] - last_time) / 10, unroll_factor(k));
+        end
+    end
+endtask
+
+// Compares the last result with a known answer. sha2_top puts a SHA-256
+// digest in osha[511:256]; pass it in the low 256 bits of expected.
+integer      kat_errors = 0;
+
+task kat_check;
+    input [511:0] expected;
+    begin
+        if((mode ? ref_sha : {256'h0, ref_sha[511:256]}) !== expected) begin
+            $display("  ERROR: known answer mismatch, expected %h", mode ? expected : expected[255:0]);
+            kat_errors = kat_errors + 1;
+        end else
+            $display("  Known answer: match");
+    end
+endtask
+
 // Timeout watchdog
 initial begin
     #20_000_000;  // 20ms timeout
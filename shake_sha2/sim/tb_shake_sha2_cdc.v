@@ -0,0 +1,271 @@
+//--------------------------------------------------------------------------------------------------------
+// Module  : tb_shake_sha2_cdc
+// Type    : simulation, top
+// Standard: Verilog 2001 (IEEE1364-2001)
+// Function: Testbench for shake_sha2_cdc, run once per core clock period, e.g.
+//           iverilog -Ptb_shake_sha2_cdc.CORE_HALF=2 (core clock faster than the 100MHz AXI clock),
+//           CORE_HALF=5 (same rate, unrelated phase) or CORE_HALF=13 (slower).
+//           Each SHA-256, SHA-512, SHAKE128 and SHAKE256 job is run on a shake_sha2_top on the AXI
+//           clock and then on shake_sha2_cdc, and the results compared. Build with shake_sha2_top0.v
+//           (no ila).
+//--------------------------------------------------------------------------------------------------------
+
+`timescale 1ns/1ps
+
+module tb_shake_sha2_cdc #(
+    parameter CORE_HALF = 2         // core_clk half period in ns
+) ();
+
+// Clocks and reset
+reg rstn;
+reg clk;
+reg core_clk;
+
+initial begin
+    rstn     = 1'b0;
+    clk      = 1'b1;
+    core_clk = 1'b1;
+end
+
+always #5 clk = ~clk;                       // 100MHz AXI clock
+always #(CORE_HALF) core_clk = ~core_clk;
+
+// Stimulus; the reference sees it all, shake_sha2_cdc only while it is the target, so the
+// reference jobs do not fill its command FIFO
+reg              target;        // 0: reference, 1: shake_sha2_cdc
+reg  [3:0]       algo_mode;
+reg              sha2_tvalid;
+reg              sha2_tlast;
+reg  [31:0]      sha2_tid;
+reg  [7:0]       sha2_tdata;
+reg              shake_start_i;
+reg  [63:0]      shake_din_i;
+reg              shake_din_valid_i;
+reg              shake_last_din_i;
+reg  [3:0]       shake_last_din_byte_i;
+reg              shake_dout_ready_i;
+
+// Reference (shake_sha2_top on clk) outputs
+wire             ref_sha2_tready;
+wire             ref_sha2_ovalid;
+wire [31:0]      ref_sha2_oid;
+wire [60:0]      ref_sha2_olen;
+wire [1343:0]    ref_dout;
+wire             ref_dout_valid;
+wire             ref_din_ready;
+
+// shake_sha2_cdc outputs
+wire             cdc_sha2_tready;
+wire             cdc_sha2_ovalid;
+wire [31:0]      cdc_sha2_oid;
+wire [60:0]      cdc_sha2_olen;
+wire [1343:0]    cdc_dout;
+wire             cdc_dout_valid;
+wire             cdc_din_ready;
+wire             cmd_overflow;
+wire             res_overflow;
+
+shake_sha2_top u_ref (
+    .clk                    ( clk                                  ),
+    .rstn                   ( rstn                                 ),
+    .algo_mode              ( algo_mode                            ),
+    .sha2_tvalid            ( sha2_tvalid & ~target                ),
+    .sha2_tready            ( ref_sha2_tready                      ),
+    .sha2_tlast             ( sha2_tlast                           ),
+    .sha2_tid               ( sha2_tid                             ),
+    .sha2_tdata             ( sha2_tdata                           ),
+    .sha2_ovalid            ( ref_sha2_ovalid                      ),
+    .sha2_oid               ( ref_sha2_oid                         ),
+    .sha2_olen              ( ref_sha2_olen                        ),
+    .shake_start_i          ( shake_start_i & ~target              ),
+    .shake_din_i            ( shake_din_i                          ),
+    .shake_din_valid_i      ( shake_din_valid_i & ~target          ),
+    .shake_last_din_i       ( shake_last_din_i                     ),
+    .shake_last_din_byte_i  ( shake_last_din_byte_i                ),
+    .shake_dout_ready_i     ( shake_dout_ready_i & ~target         ),
+    .shake_hold             ( 1'b0                                 ),
+    .dout                   ( ref_dout                             ),
+    .dout_valid             ( ref_dout_valid                       ),
+    .shake_din_ready        ( ref_din_ready                        )
+);
+
+shake_sha2_cdc u_cdc (
+    .clk                    ( clk                                  ),
+    .rstn                   ( rstn                                 ),
+    .algo_mode              ( algo_mode                            ),
+    .sha2_tvalid            ( sha2_tvalid & target                 ),
+    .sha2_tready            ( cdc_sha2_tready                      ),
+    .sha2_tlast             ( sha2_tlast & target                  ),
+    .sha2_tid               ( sha2_tid & {32{target}}              ),
+    .sha2_tdata             ( sha2_tdata & {8{target}}             ),
+    .sha2_ovalid            ( cdc_sha2_ovalid                      ),
+    .sha2_oid               ( cdc_sha2_oid                         ),
+    .sha2_olen              ( cdc_sha2_olen                        ),
+    .shake_start_i          ( shake_start_i & target               ),
+    .shake_din_i            ( shake_din_i & {64{target}}           ),
+    .shake_din_valid_i      ( shake_din_valid_i & target           ),
+    .shake_last_din_i       ( shake_last_din_i & target            ),
+    .shake_last_din_byte_i  ( shake_last_din_byte_i & {4{target}}  ),
+    .shake_dout_ready_i     ( shake_dout_ready_i & target          ),
+    .shake_hold             ( 1'b0                                 ),
+    .dout                   ( cdc_dout                             ),
+    .dout_valid             ( cdc_dout_valid                       ),
+    .shake_din_ready        ( cdc_din_ready                        ),
+    .cmd_overflow           ( cmd_overflow                         ),
+    .res_overflow           ( res_overflow                         ),
+    .core_clk               ( core_clk                             )
+);
+
+wire sha2_tready = target ? cdc_sha2_tready : ref_sha2_tready;
+wire din_ready   = target ? cdc_din_ready   : ref_din_ready;
+wire ovalid      = target ? cdc_sha2_ovalid : ref_sha2_ovalid;
+wire dvalid      = target ? cdc_dout_valid  : ref_dout_valid;
+
+// Result of the last job on each DUT
+reg  [1343:0] result   [0:1];
+reg  [31:0]   result_id[0:1];
+
+// One SHA-2 message of n pseudo-random bytes from seed. Call 1ns after a clock edge.
+task sha2_job;
+    input [31:0]   id;
+    input integer  n;
+    input integer  seed;
+    integer        k, r;
+    begin
+        r = seed;
+        for (k = 0; k < n; k = k + 1) begin
+            while (!sha2_tready) @(posedge clk) #1;
+            sha2_tid    = (k == 0) ? id : 32'd0;
+            sha2_tdata  = $random(r);
+            sha2_tlast  = (k == n-1);
+            @(posedge clk) #1;
+            sha2_tvalid = 1'b1;
+            @(posedge clk) #1;
+            sha2_tvalid = 1'b0;
+        end
+        sha2_tlast = 1'b0;
+        while (!ovalid) @(posedge clk) #1;
+        result[target]    = target ? cdc_dout : ref_dout;
+        result_id[target] = target ? cdc_sha2_oid : ref_sha2_oid;
+        @(posedge clk) #1;
+    end
+endtask
+
+// One SHAKE/SHA3 message of n pseudo-random 64-bit words from seed. Call 1ns after a clock edge.
+task shake_job;
+    input integer  n;
+    input integer  seed;
+    integer        k, r;
+    begin
+        r = seed;
+        shake_start_i = 1'b1;
+        @(posedge clk) #1;
+        shake_start_i = 1'b0;
+        for (k = 0; k < n; k = k + 1) begin
+            while (!din_ready) @(posedge clk) #1;
+            shake_din_i           = {$random(r), $random(r)};
+            shake_last_din_i      = (k == n-1);
+            shake_last_din_byte_i = (k == n-1) ? 4'd8 : 4'd0;
+            @(posedge clk) #1;
+            shake_din_valid_i = 1'b1;
+            @(posedge clk) #1;
+            shake_din_valid_i = 1'b0;
+        end
+        shake_last_din_i      = 1'b0;
+        shake_last_din_byte_i = 4'd0;
+        shake_dout_ready_i    = 1'b1;
+        while (!dvalid) @(posedge clk) #1;
+        result[target]    = target ? cdc_dout : ref_dout;
+        result_id[target] = 32'd0;
+        shake_dout_ready_i = 1'b0;
+        @(posedge clk) #1;
+    end
+endtask
+
+integer errors, jobs;
+
+task check;
+    input [8*16-1:0] name;
+    begin
+        jobs = jobs + 1;
+        if (result[1] !== result[0] || result_id[1] !== result_id[0]) begin
+            $display("ERROR: %0s differs: %h / %h", name, result[1][1343 -: 128], result[0][1343 -: 128]);
+            errors = errors + 1;
+        end
+    end
+endtask
+
+integer m, t;
+
+initial begin
+    target                = 1'b0;
+    algo_mode             = 4'b0000;
+    sha2_tvalid           = 1'b0;
+    sha2_tlast            = 1'b0;
+    sha2_tid              = 32'd0;
+    sha2_tdata            = 8'd0;
+    shake_start_i         = 1'b0;
+    shake_din_i           = 64'd0;
+    shake_din_valid_i     = 1'b0;
+    shake_last_din_i      = 1'b0;
+    shake_last_din_byte_i = 4'd0;
+    shake_dout_ready_i    = 1'b0;
+    errors                = 0;
+    jobs                  = 0;
+
+    repeat (4) @(posedge clk);
+    #1 rstn = 1'b1;
+    repeat (4) @(posedge clk) #1;
+
+    // Lengths around the block boundaries of each mode
+    for (m = 0; m < 4; m = m + 1) begin
+        for (t = 0; t < 2; t = t + 1) begin
+            target = t;
+            algo_mode = 4'b0000;
+            sha2_job(32'h2560 + m, 1 + 37*m, m);
+        end
+        check("SHA-256");
+        for (t = 0; t < 2; t = t + 1) begin
+            target = t;
+            algo_mode = 4'b0001;
+            sha2_job(32'h5120 + m, 1 + 75*m, m + 10);
+        end
+        check("SHA-512");
+        for (t = 0; t < 2; t = t + 1) begin
+            target = t;
+            algo_mode = 4'b1000;
+            shake_job(1 + 11*m, m + 20);
+        end
+        check("SHAKE128");
+        for (t = 0; t < 2; t = t + 1) begin
+            target = t;
+            algo_mode = 4'b1001;
+            shake_job(1 + 9*m, m + 30);
+        end
+        check("SHAKE256");
+    end
+
+    if (cmd_overflow) begin
+        $display("ERROR: command FIFO overrun");
+        errors = errors + 1;
+    end
+    if (res_overflow) begin
+        $display("ERROR: result FIFO overrun");
+        errors = errors + 1;
+    end
+
+    $display("CORE_HALF=%0d: %0d jobs compared", CORE_HALF, jobs);
+    if (errors == 0)
+        $display("PASS");
+    else
+        $display("FAIL: %0d error(s)", errors);
+    $finish;
+end
+
+initial begin
+    #20_000_000;
+    $display("ERROR: timeout");
+    $finish;
+end
+
+endmodule
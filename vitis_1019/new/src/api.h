@@ -54,12 +54,37 @@ int crypto_sign_keypair(unsigned char *pk, unsigned char *sk);
 int crypto_sign_signature(uint8_t *sig, size_t *siglen,
                           const uint8_t *m, size_t mlen, const uint8_t *sk);
 
+/**
+ * Signs n messages under one key into the detached signatures sigs[i] and
+ * sets siglens[i]. Consecutive messages are pipelined: the message digest of
+ * one, the FORS and subtree work of the previous and the WOTS signatures of
+ * the one before that form one job batch (see parallel.h), so a concurrent
+ * job runner keeps several hash engines busy. Only the host build has such
+ * a runner (host/host_jobs.c); on the board none is installed, and the
+ * messages are signed one after the other with no overlap. Not reentrant.
+ * Returns 0.
+ */
+int crypto_sign_many(uint8_t *const *sigs, size_t *siglens,
+                     const uint8_t *const *ms, const size_t *mlens,
+                     size_t n, const uint8_t *sk);
+
 /**
  * Verifies a detached signature and message under a given public key.
  */
 int crypto_sign_verify(const uint8_t *sig, size_t siglen,
                        const uint8_t *m, size_t mlen, const uint8_t *pk);
 
+/**
+ * Verifies n detached signatures, advancing groups of them in lock-step so
+ * that hashes from different signatures can share the hash engine's lanes.
+ * Sets results[i] to 0 if signature i is valid and to -1 otherwise, exactly
+ * as crypto_sign_verify() would. Returns 0 if all are valid, -1 otherwise.
+ */
+int crypto_sign_verify_batch(const uint8_t *const *sigs, const size_t *siglens,
+                             const uint8_t *const *ms, const size_t *mlens,
+                             const uint8_t *const *pks, size_t n,
+                             int *results);
+
 /**
  * Returns an array containing the signature followed by the message.
  */
@@ -0,0 +1,119 @@
+#include <stddef.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "api.h"
+#include "params.h"
+#include "hash.h"
+#include "utils.h"
+#include "batch_sign.h"
+
+#define BATCH_TAG_BYTES 8
+#define BATCH_MSG_BYTES (BATCH_TAG_BYTES + 1 + SPX_N)
+
+/*
+ * Tree nodes, one level at a time, reduced in place. SPX_BATCH_MAX nodes
+ * do not fit next to a signature in the 8 KiB stack.
+ */
+static unsigned char batch_nodes[SPX_BATCH_MAX][SPX_N];
+
+static unsigned int batch_height(size_t n)
+{
+    unsigned int height = 0;
+
+    while (((size_t)1 << height) < n) {
+        height++;
+    }
+    return height;
+}
+
+/* The message that crypto_sign_signature() actually signs. */
+static void batch_root_msg(unsigned char *msg, unsigned int height,
+                           const unsigned char *root)
+{
+    memcpy(msg, "SPXBATCH", BATCH_TAG_BYTES);
+    msg[BATCH_TAG_BYTES] = (unsigned char)height;
+    memcpy(msg + BATCH_TAG_BYTES + 1, root, SPX_N);
+}
+
+size_t spx_batch_proof_bytes(size_t n)
+{
+    if (n == 0 || n > SPX_BATCH_MAX) {
+        return 0;
+    }
+    return 5 + batch_height(n) * SPX_N;
+}
+
+int spx_batch_sign(uint8_t *sig, size_t *siglen, uint8_t *const *proofs,
+                   const uint8_t *const *ms, const size_t *mlens, size_t n,
+                   const uint8_t *sk)
+{
+    unsigned char msg[BATCH_MSG_BYTES];
+    unsigned int height, level;
+    size_t i, width;
+
+    if (n == 0 || n > SPX_BATCH_MAX) {
+        return -1;
+    }
+    height = batch_height(n);
+    width = (size_t)1 << height;
+
+    for (i = 0; i < n; i++) {
+        hash_batch(batch_nodes[i], ms[i], mlens[i], 0x00);
+        u32_to_bytes(proofs[i], (uint32_t)i);
+        proofs[i][4] = (uint8_t)height;
+    }
+    memset(batch_nodes[0] + n * SPX_N, 0, (width - n) * SPX_N);
+
+    /* Before each level is reduced, every message takes its sibling on it. */
+    for (level = 0; level < height; level++, width >>= 1) {
+        for (i = 0; i < n; i++) {
+            memcpy(proofs[i] + 5 + level * SPX_N,
+                   batch_nodes[(i >> level) ^ 1], SPX_N);
+        }
+        for (i = 0; i < width / 2; i++) {
+            hash_batch(batch_nodes[i], batch_nodes[2*i], 2*SPX_N, 0x01);
+        }
+    }
+
+    batch_root_msg(msg, height, batch_nodes[0]);
+    return crypto_sign_signature(sig, siglen, msg, BATCH_MSG_BYTES, sk);
+}
+
+int spx_batch_verify(const uint8_t *sig, size_t siglen,
+                     const uint8_t *proof, size_t prooflen,
+                     const uint8_t *m, size_t mlen, const uint8_t *pk)
+{
+    unsigned char msg[BATCH_MSG_BYTES];
+    unsigned char pair[2*SPX_N];
+    unsigned char node[SPX_N];
+    const unsigned char *path = proof + 5;
+    unsigned int height, level;
+    uint32_t idx;
+
+    if (prooflen < 5) {
+        return -1;
+    }
+    idx = (uint32_t)bytes_to_ull(proof, 4);
+    height = proof[4];
+    if (height > SPX_BATCH_MAX_HEIGHT || prooflen != 5 + height * SPX_N ||
+        (idx >> height) != 0) {
+        return -1;
+    }
+
+    hash_batch(node, m, mlen, 0x00);
+    for (level = 0; level < height; level++, path += SPX_N) {
+        if ((idx >> level) & 1) {
+            memcpy(pair, path, SPX_N);
+            memcpy(pair + SPX_N, node, SPX_N);
+        }
+        else {
+            memcpy(pair, node, SPX_N);
+            memcpy(pair + SPX_N, path, SPX_N);
+        }
+        hash_batch(node, pair, 2*SPX_N, 0x01);
+    }
+
+    batch_root_msg(msg, height, node);
+    return crypto_sign_verify(sig, siglen, msg, BATCH_MSG_BYTES, pk);
+}
@@ -0,0 +1,61 @@
+#ifndef SPX_BATCH_SIGN_H
+#define SPX_BATCH_SIGN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "params.h"
+
+/*
+ * Merkle-batched signing: a burst of messages is collected into a hash tree
+ * and one SPHINCS+ signature is made over its root. Each message is then
+ * authenticated by the shared signature plus its own inclusion proof.
+ *
+ *   leaf  = hash_batch(m, 0x00)
+ *   node  = hash_batch(left || right, 0x01)
+ *   signed message = "SPXBATCH" || height || root
+ *
+ * A batch of n messages uses a tree of height ceil(log2(n)); leaves past n
+ * are all-zero. The signed message is an ordinary crypto_sign_signature()
+ * message, so a key used for batches must not also sign messages that
+ * start with "SPXBATCH".
+ */
+
+/* Largest batch is 2^SPX_BATCH_MAX_HEIGHT messages. */
+#ifndef SPX_BATCH_MAX_HEIGHT
+#define SPX_BATCH_MAX_HEIGHT 8
+#endif
+#define SPX_BATCH_MAX (1U << SPX_BATCH_MAX_HEIGHT)
+
+/*
+ * Inclusion proof: leaf index (4 bytes, big-endian), tree height (1 byte),
+ * then height sibling nodes from the leaf upwards. SPX_BATCH_PROOF_BYTES is
+ * the size at the largest height.
+ */
+#define SPX_BATCH_PROOF_BYTES (5 + SPX_BATCH_MAX_HEIGHT * SPX_N)
+
+/* Size of each proof of a batch of n messages, or 0 if n is out of range. */
+#define spx_batch_proof_bytes SPX_NAMESPACE(spx_batch_proof_bytes)
+size_t spx_batch_proof_bytes(size_t n);
+
+/*
+ * Signs the n (1..SPX_BATCH_MAX) messages ms[i] of mlens[i] bytes with one
+ * signature into sig, and writes the proof of message i to proofs[i]
+ * (spx_batch_proof_bytes(n) bytes each). Keeps the tree in static memory, so
+ * it is not reentrant. Returns 0 on success, -1 otherwise.
+ */
+#define spx_batch_sign SPX_NAMESPACE(spx_batch_sign)
+int spx_batch_sign(uint8_t *sig, size_t *siglen, uint8_t *const *proofs,
+                   const uint8_t *const *ms, const size_t *mlens, size_t n,
+                   const uint8_t *sk);
+
+/*
+ * Verifies message m against a batch signature and its inclusion proof.
+ * Returns 0 if valid, -1 otherwise.
+ */
+#define spx_batch_verify SPX_NAMESPACE(spx_batch_verify)
+int spx_batch_verify(const uint8_t *sig, size_t siglen,
+                     const uint8_t *proof, size_t prooflen,
+                     const uint8_t *m, size_t mlen, const uint8_t *pk);
+
+#endif
@@ -0,0 +1,116 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "api.h"
+#include "xtime_l.h"
+
+static uint8_t bench_sig[SPX_BYTES];
+static uint8_t bench_sigs[SPX_BENCH_MANY][SPX_BYTES];
+
+static uint64_t isqrt64(uint64_t x)
+{
+    uint64_t r = 0, bit = (uint64_t)1 << 62;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= r + bit) {
+            x -= r + bit;
+            r = (r >> 1) + bit;
+        }
+        else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
+
+int spx_bench_sign(spx_bench_result *res, const uint8_t *sk, uint32_t runs)
+{
+    static const uint8_t m[32] = "SPHINCS+ latency benchmark";
+    uint64_t base = 0, sumsq = 0, t;
+    int64_t sum = 0, d, mean_d;
+    XTime start, end;
+    size_t siglen;
+    uint32_t i;
+
+    if (runs == 0) {
+        return -1;
+    }
+    memset(res, 0, sizeof(spx_bench_result));
+    res->min = UINT64_MAX;
+
+    /* Warm-up: caches, TLB and the accelerator state of the first call. */
+    if (crypto_sign_signature(bench_sig, &siglen, m, sizeof(m), sk)) {
+        return -1;
+    }
+
+    for (i = 0; i < runs; i++) {
+        XTime_GetTime(&start);
+        if (crypto_sign_signature(bench_sig, &siglen, m, sizeof(m), sk)) {
+            return -1;
+        }
+        XTime_GetTime(&end);
+
+        t = end - start;
+        if (t < res->min) {
+            res->min = t;
+        }
+        if (t > res->max) {
+            res->max = t;
+        }
+
+        /* Accumulate around the first sample: a whole signature squared
+           overflows 64 bits at the slower parameter sets, the jitter does not. */
+        if (i == 0) {
+            base = t;
+        }
+        d = (int64_t)(t - base);
+        sum += d;
+        sumsq += (uint64_t)(d * d);
+    }
+
+    mean_d = sum / (int64_t)runs;
+    res->runs = runs;
+    res->mean = base + (uint64_t)mean_d;
+    res->stddev = isqrt64(sumsq / runs - (uint64_t)(mean_d * mean_d));
+
+    return 0;
+}
+
+int spx_bench_sign_many(spx_bench_throughput *res, const uint8_t *sk,
+                        uint32_t count)
+{
+    uint8_t m[SPX_BENCH_MANY][32];
+    uint8_t *sigs[SPX_BENCH_MANY];
+    const uint8_t *ms[SPX_BENCH_MANY];
+    size_t mlens[SPX_BENCH_MANY], siglens[SPX_BENCH_MANY];
+    XTime start, end;
+    uint32_t i;
+
+    if (count == 0 || count > SPX_BENCH_MANY) {
+        return -1;
+    }
+    for (i = 0; i < count; i++) {
+        memset(m[i], (int)i, sizeof(m[i]));
+        sigs[i] = bench_sigs[i];
+        ms[i] = m[i];
+        mlens[i] = sizeof(m[i]);
+    }
+
+    XTime_GetTime(&start);
+    if (crypto_sign_many(sigs, siglens, ms, mlens, count, sk)) {
+        return -1;
+    }
+    XTime_GetTime(&end);
+
+    res->sigs = count;
+    res->ticks = end - start;
+    res->sigs_per_ksec = res->ticks == 0 ? 0 :
+        (uint64_t)count * COUNTS_PER_SECOND * 1000 / res->ticks;
+
+    return 0;
+}
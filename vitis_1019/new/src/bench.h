@@ -0,0 +1,54 @@
+#ifndef SPX_BENCH_H
+#define SPX_BENCH_H
+
+#include <stdint.h>
+
+#include "params.h"
+
+/*
+ * Per-signature latency over a run of crypto_sign_signature() calls with one
+ * key and message, in XTime ticks (COUNTS_PER_SECOND per second). The spread
+ * (max - min, standard deviation) is the jitter that memory placement
+ * (hotmem.h) is meant to remove.
+ */
+typedef struct {
+    uint32_t runs;
+    uint64_t min;
+    uint64_t max;
+    uint64_t mean;
+    uint64_t stddev;
+} spx_bench_result;
+
+/*
+ * Signs runs times (after one untimed warm-up signature) under sk.
+ * Returns -1 if runs is 0 or a signature fails, 0 otherwise.
+ */
+#define spx_bench_sign SPX_NAMESPACE(spx_bench_sign)
+int spx_bench_sign(spx_bench_result *res, const uint8_t *sk, uint32_t runs);
+
+/* Largest batch spx_bench_sign_many() takes (one signature buffer each). */
+#ifndef SPX_BENCH_MANY
+#define SPX_BENCH_MANY 4
+#endif
+
+/*
+ * Aggregate signing throughput of one crypto_sign_many() batch: ticks for the
+ * whole batch and signatures per 1000 seconds (per second with three decimals).
+ * Without a concurrent job runner (none on the board yet) this is the rate
+ * of signing the messages one by one.
+ */
+typedef struct {
+    uint32_t sigs;
+    uint64_t ticks;
+    uint64_t sigs_per_ksec;
+} spx_bench_throughput;
+
+/*
+ * Signs count (1..SPX_BENCH_MANY) distinct messages under sk with one
+ * crypto_sign_many() call. Returns -1 if count is out of range, 0 otherwise.
+ */
+#define spx_bench_sign_many SPX_NAMESPACE(spx_bench_sign_many)
+int spx_bench_sign_many(spx_bench_throughput *res, const uint8_t *sk,
+                        uint32_t count);
+
+#endif
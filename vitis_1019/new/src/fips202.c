@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include "fips202.h"
+#include "hashtrace.h"
 
 #include "fpga_sha_driver.h" // <--- ͷļ
 
@@ -524,10 +525,12 @@ static void keccak_inc_squeeze(uint8_t *h, size_t outlen,
 
 void shake256_inc_init(uint64_t *s_inc) {
     keccak_inc_init(s_inc);
+    SPX_TRACE_INC_INIT(s_inc);
 }
 
 void shake256_inc_absorb(uint64_t *s_inc, const uint8_t *input, size_t inlen) {
     keccak_inc_absorb(s_inc, SHAKE256_RATE, input, inlen);
+    SPX_TRACE_INC_ABSORB(s_inc, inlen);
 }
 
 void shake256_inc_finalize(uint64_t *s_inc) {
@@ -535,6 +538,7 @@ void shake256_inc_finalize(uint64_t *s_inc) {
 }
 
 void shake256_inc_squeeze(uint8_t *output, size_t outlen, uint64_t *s_inc) {
+    SPX_TRACE_INC_SQUEEZE(s_inc, outlen);
     keccak_inc_squeeze(output, outlen, s_inc, SHAKE256_RATE);
 }
 
@@ -616,6 +620,7 @@ void shake256(uint8_t *output, size_t outlen,
 void shake256(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen)
 {
     // ֱӵǵӲ
+    SPX_TRACE_CALL(SPX_TRACE_SHAKE256, inlen, 0, outlen);
     shake256_hw(out, outlen, in, inlen);
 }
 
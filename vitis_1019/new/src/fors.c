@@ -8,6 +8,7 @@
 #include "hash.h"
 #include "thash.h"
 #include "address.h"
+#include "hashdag.h"
 
 static void fors_gen_sk(unsigned char *sk, const spx_ctx *ctx,
                         uint32_t fors_leaf_addr[8])
@@ -62,54 +63,71 @@ static void message_to_indices(uint32_t *indices, const unsigned char *m)
     }
 }
 
+/* The SPX_FORS_HEIGHT-bit integer message_to_indices() gives tree 'tree'. */
+static uint32_t message_to_index(const unsigned char *m, uint32_t tree)
+{
+    unsigned int j;
+    unsigned int offset = tree * SPX_FORS_HEIGHT;
+    uint32_t index = 0;
+
+    for (j = 0; j < SPX_FORS_HEIGHT; j++) {
+        index ^= ((m[offset >> 3] >> (offset & 0x7)) & 1u) << j;
+        offset++;
+    }
+    return index;
+}
+
 /**
- * Signs a message m, deriving the secret key from sk_seed and the FTS address.
- * Assumes m contains at least SPX_FORS_HEIGHT * SPX_FORS_TREES bits.
+ * Produces the part of the FORS signature that belongs to tree 'tree'.
  */
-void fors_sign(unsigned char *sig, unsigned char *pk,
-               const unsigned char *m,
-               const spx_ctx *ctx,
-               const uint32_t fors_addr[8])
+void fors_sign_tree(unsigned char *sig, unsigned char *root,
+                    const unsigned char *m, uint32_t tree,
+                    const spx_ctx *ctx,
+                    const uint32_t fors_addr[8])
 {
-    uint32_t indices[SPX_FORS_TREES];
-    unsigned char roots[SPX_FORS_TREES * SPX_N];
     uint32_t fors_tree_addr[8] = {0};
     struct fors_gen_leaf_info fors_info = {0};
     uint32_t *fors_leaf_addr = fors_info.leaf_addrx;
-    uint32_t fors_pk_addr[8] = {0};
-    uint32_t idx_offset;
-    unsigned int i;
+    uint32_t idx_offset = tree * (1 << SPX_FORS_HEIGHT);
+    uint32_t index = message_to_index(m, tree);
 
     copy_keypair_addr(fors_tree_addr, fors_addr);
     copy_keypair_addr(fors_leaf_addr, fors_addr);
 
-    copy_keypair_addr(fors_pk_addr, fors_addr);
-    set_type(fors_pk_addr, SPX_ADDR_TYPE_FORSPK);
-
-    message_to_indices(indices, m);
-
-    for (i = 0; i < SPX_FORS_TREES; i++) {
-        idx_offset = i * (1 << SPX_FORS_HEIGHT);
+    set_tree_height(fors_tree_addr, 0);
+    set_tree_index(fors_tree_addr, index + idx_offset);
+    set_type(fors_tree_addr, SPX_ADDR_TYPE_FORSPRF);
 
-        set_tree_height(fors_tree_addr, 0);
-        set_tree_index(fors_tree_addr, indices[i] + idx_offset);
-        set_type(fors_tree_addr, SPX_ADDR_TYPE_FORSPRF);
+    /* Include the secret key part that produces the selected leaf node. */
+    fors_gen_sk(sig, ctx, fors_tree_addr);
+    set_type(fors_tree_addr, SPX_ADDR_TYPE_FORSTREE);
+    sig += SPX_N;
 
-        /* Include the secret key part that produces the selected leaf node. */
-        fors_gen_sk(sig, ctx, fors_tree_addr);
-        set_type(fors_tree_addr, SPX_ADDR_TYPE_FORSTREE);
-        sig += SPX_N;
+    /* Compute the authentication path for this leaf node. */
+    treehashx1(root, sig, ctx,
+             index, idx_offset, SPX_FORS_HEIGHT, fors_gen_leafx1,
+             fors_tree_addr, &fors_info);
+}
 
-        /* Compute the authentication path for this leaf node. */
-        treehashx1(roots + i*SPX_N, sig, ctx,
-                 indices[i], idx_offset, SPX_FORS_HEIGHT, fors_gen_leafx1,
-                 fors_tree_addr, &fors_info);
+/**
+ * Signs a message m, deriving the secret key from sk_seed and the FTS address.
+ * Assumes m contains at least SPX_FORS_HEIGHT * SPX_FORS_TREES bits.
+ */
+void fors_sign(unsigned char *sig, unsigned char *pk,
+               const unsigned char *m,
+               const spx_ctx *ctx,
+               const uint32_t fors_addr[8])
+{
+    SPX_VLA(unsigned char, roots, SPX_FORS_TREES * SPX_N);
+    unsigned int i;
 
-        sig += SPX_N * SPX_FORS_HEIGHT;
+    for (i = 0; i < SPX_FORS_TREES; i++) {
+        fors_sign_tree(sig, roots + i*SPX_N, m, i, ctx, fors_addr);
+        sig += SPX_N * (SPX_FORS_HEIGHT + 1);
     }
 
     /* Hash horizontally across all tree roots to derive the public key. */
-    thash(pk, roots, SPX_FORS_TREES, ctx, fors_pk_addr);
+    fors_pk_from_roots(pk, roots, ctx, fors_addr);
 }
 
 /**
@@ -125,12 +143,15 @@ void fors_pk_from_sig(unsigned char *pk,
                       const uint32_t fors_addr[8])
 {
     uint32_t indices[SPX_FORS_TREES];
-    unsigned char roots[SPX_FORS_TREES * SPX_N];
-    unsigned char leaf[SPX_N];
+    SPX_VLA(unsigned char, roots, SPX_FORS_TREES * SPX_N);
+    SPX_VLA(unsigned char, leaves, SPX_DAG_WINDOW * SPX_N);
+    SPX_VLA(spx_root_walk, walks, SPX_DAG_WINDOW);
+    SPX_VLA(spx_hash_node, nodes, SPX_DAG_WINDOW);
+    spx_hash_dag dag;
     uint32_t fors_tree_addr[8] = {0};
     uint32_t fors_pk_addr[8] = {0};
     uint32_t idx_offset;
-    unsigned int i;
+    unsigned int i, first, w;
 
     copy_keypair_addr(fors_tree_addr, fors_addr);
     copy_keypair_addr(fors_pk_addr, fors_addr);
@@ -140,22 +161,79 @@ void fors_pk_from_sig(unsigned char *pk,
 
     message_to_indices(indices, m);
 
-    for (i = 0; i < SPX_FORS_TREES; i++) {
-        idx_offset = i * (1 << SPX_FORS_HEIGHT);
+    /* The trees are independent: each window of trees derives its leaves
+       as one set of calls, then walks up to the roots level by level. */
+    for (first = 0; first < SPX_FORS_TREES; first += SPX_DAG_WINDOW) {
+        unsigned int count = SPX_FORS_TREES - first;
+        const unsigned char *tree_sig;
+
+        if (count > SPX_DAG_WINDOW) {
+            count = SPX_DAG_WINDOW;
+        }
 
-        set_tree_height(fors_tree_addr, 0);
-        set_tree_index(fors_tree_addr, indices[i] + idx_offset);
+        /* Derive the leaves from the included secret key parts. */
+        spx_dag_init(&dag, nodes, SPX_DAG_WINDOW);
+        for (w = 0; w < count; w++) {
+            i = first + w;
+            idx_offset = i * (1 << SPX_FORS_HEIGHT);
+            tree_sig = sig + i * (SPX_FORS_HEIGHT + 1) * SPX_N;
 
-        /* Derive the leaf from the included secret key part. */
-        fors_sk_to_leaf(leaf, sig, ctx, fors_tree_addr);
-        sig += SPX_N;
+            set_tree_height(fors_tree_addr, 0);
+            set_tree_index(fors_tree_addr, indices[i] + idx_offset);
+            spx_dag_add(&dag, leaves + w*SPX_N, tree_sig, 1, fors_tree_addr);
+        }
+        spx_dag_run(&dag, ctx);
+
+        /* Derive the corresponding root nodes of these trees. */
+        for (w = 0; w < count; w++) {
+            i = first + w;
+            idx_offset = i * (1 << SPX_FORS_HEIGHT);
+            tree_sig = sig + i * (SPX_FORS_HEIGHT + 1) * SPX_N;
 
-        /* Derive the corresponding root node of this tree. */
-        compute_root(roots + i*SPX_N, leaf, indices[i], idx_offset,
-                     sig, SPX_FORS_HEIGHT, ctx, fors_tree_addr);
-        sig += SPX_N * SPX_FORS_HEIGHT;
+            spx_root_walk_init(&walks[w], roots + i*SPX_N, leaves + w*SPX_N,
+                               indices[i], idx_offset, tree_sig + SPX_N,
+                               ctx, fors_tree_addr);
+        }
+        spx_root_walks(walks, count, SPX_FORS_HEIGHT);
     }
 
     /* Hash horizontally across all tree roots to derive the public key. */
     thash(pk, roots, SPX_FORS_TREES, ctx, fors_pk_addr);
 }
+
+void fors_tree_root_from_sig(unsigned char *root, const unsigned char *sig,
+                             const unsigned char *m, uint32_t tree,
+                             const spx_ctx* ctx,
+                             const uint32_t fors_addr[8])
+{
+    unsigned char leaf[SPX_N];
+    uint32_t fors_tree_addr[8] = {0};
+    uint32_t idx_offset = tree * (1 << SPX_FORS_HEIGHT);
+    uint32_t index = message_to_index(m, tree);
+
+    copy_keypair_addr(fors_tree_addr, fors_addr);
+    set_type(fors_tree_addr, SPX_ADDR_TYPE_FORSTREE);
+
+    set_tree_height(fors_tree_addr, 0);
+    set_tree_index(fors_tree_addr, index + idx_offset);
+
+    /* Derive the leaf from the included secret key part. */
+    fors_sk_to_leaf(leaf, sig, ctx, fors_tree_addr);
+
+    /* Derive the corresponding root node of this tree. */
+    compute_root(root, leaf, index, idx_offset, sig + SPX_N,
+                 SPX_FORS_HEIGHT, ctx, fors_tree_addr);
+}
+
+void fors_pk_from_roots(unsigned char *pk, const unsigned char *roots,
+                        const spx_ctx* ctx,
+                        const uint32_t fors_addr[8])
+{
+    uint32_t fors_pk_addr[8] = {0};
+
+    copy_keypair_addr(fors_pk_addr, fors_addr);
+    set_type(fors_pk_addr, SPX_ADDR_TYPE_FORSPK);
+
+    /* Hash horizontally across all tree roots to derive the public key. */
+    thash(pk, roots, SPX_FORS_TREES, ctx, fors_pk_addr);
+}
@@ -16,6 +16,18 @@ void fors_sign(unsigned char *sig, unsigned char *pk,
                const spx_ctx* ctx,
                const uint32_t fors_addr[8]);
 
+/**
+ * Produces the part of the FORS signature that belongs to tree 'tree' (the
+ * secret key value followed by the auth path, (SPX_FORS_HEIGHT + 1) * SPX_N
+ * bytes) and the root of that tree. fors_sign() is this for every tree,
+ * followed by fors_pk_from_roots().
+ */
+#define fors_sign_tree SPX_NAMESPACE(fors_sign_tree)
+void fors_sign_tree(unsigned char *sig, unsigned char *root,
+                    const unsigned char *m, uint32_t tree,
+                    const spx_ctx* ctx,
+                    const uint32_t fors_addr[8]);
+
 /**
  * Derives the FORS public key from a signature.
  * This can be used for verification by comparing to a known public key, or to
@@ -29,4 +41,23 @@ void fors_pk_from_sig(unsigned char *pk,
                       const spx_ctx* ctx,
                       const uint32_t fors_addr[8]);
 
+/**
+ * Derives the root of FORS tree 'tree' from its part of a signature (the
+ * secret key value followed by the auth path, (SPX_FORS_HEIGHT + 1) * SPX_N
+ * bytes), so that the trees can be processed one at a time.
+ */
+#define fors_tree_root_from_sig SPX_NAMESPACE(fors_tree_root_from_sig)
+void fors_tree_root_from_sig(unsigned char *root, const unsigned char *sig,
+                             const unsigned char *m, uint32_t tree,
+                             const spx_ctx* ctx,
+                             const uint32_t fors_addr[8]);
+
+/**
+ * Derives the FORS public key from the SPX_FORS_TREES tree roots.
+ */
+#define fors_pk_from_roots SPX_NAMESPACE(fors_pk_from_roots)
+void fors_pk_from_roots(unsigned char *pk, const unsigned char *roots,
+                        const spx_ctx* ctx,
+                        const uint32_t fors_addr[8]);
+
 #endif
@@ -1,5 +1,7 @@
 #include "fpga_sha_driver.h"
 #include "xil_io.h"
+#include "xil_cache.h"
+#include "xpseudo_asm.h"
 #include <string.h>
 
 // Ĵx
@@ -34,9 +36,9 @@ static void reorder_and_swap_bytes_shake(unsigned char* dest, const u32* src_reg
     }
 }
 
-/* * o 2SHA-2 ݔ̎ ()
- *  shake_sha2_top.vSHA-2 Yλ dout ǰ (͵ַ)
- * ҂ļĴ_^ (REG11) xȡKQֹ
+/* * Helper 2: SHA-2 output
+ * shake_sha2_top.v puts the digest at the top of dout ({osha, 832'h0}), i.e.
+ * result_regs[41] downwards; src_regs[] is in that order, most significant first.
  */
 static void reorder_and_swap_bytes_sha2(unsigned char* dest, const u32* src_regs, size_t num_bytes_to_copy) {
     size_t num_regs_to_process = (num_bytes_to_copy + 3) / 4;
@@ -57,29 +59,23 @@ static void reorder_and_swap_bytes_sha2(unsigned char* dest, const u32* src_regs
 }
 
 
-/* --- Ȳ SHA-2 ߉݋ --- */
-// ѭ shake_sha2_test.c ߉݋
-static void sha2_hw_internal(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen, HwHashMode mode)
+/* Feeds in as one message tagged tid. Returns 0, or -1 if the core stalls. */
+static int sha2_hw_feed(u32 base_addr, const uint8_t *in, size_t inlen, u32 tid)
 {
-    u32 base_addr = IP_CORE_BASEADDR;
-    u32 status;
     int timeout;
+    u32 status;
 
-    // 1. Oģʽ (SHA2-256  SHA2-512)
-    SHA_HW_WriteReg(base_addr, REG_CONTROL_OFFSET, (u32)mode);
-
-    // 2. ѭhl͔ (ֹ)ʹ tvalid }_
+    SHA_HW_WriteReg(base_addr, REG_SHA2_TID_OFFSET, tid);
     for (size_t i = 0; i < inlen; i++) {
         // ȴ tready == 1
         timeout = 1000000;
         do {
             status = SHA_HW_ReadReg(base_addr, REG_STATUS_OFFSET);
-            if (timeout-- <= 0) { /* ̎r */ return; }
+            if (timeout-- <= 0) { /* ̎r */ return -1; }
         } while ((status & STATUS_SHA2_TREADY_BIT) == 0);
 
         //  tdata
         SHA_HW_WriteReg(base_addr, REG_SHA2_TDATA_OFFSET, (u32)in[i]);
-        SHA_HW_WriteReg(base_addr, REG_SHA2_TID_OFFSET, 0);
 
         // O tvalid=1, tlast=1 ()
         u32 sha2_control = SHA2_CONTROL_TVALID_BIT;
@@ -93,6 +89,22 @@ static void sha2_hw_internal(uint8_t *out, size_t outlen, const uint8_t *in, siz
         SHA_HW_WriteReg(base_addr, REG_SHA2_CONTROL_OFFSET, sha2_control);
     }
 
+    return 0;
+}
+
+/* --- Ȳ SHA-2 ߉݋ --- */
+// ѭ shake_sha2_test.c ߉݋
+static void sha2_hw_internal(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen, HwHashMode mode)
+{
+    u32 base_addr = IP_CORE_BASEADDR;
+    int timeout;
+
+    // 1. Oģʽ (SHA2-256  SHA2-512)
+    SHA_HW_WriteReg(base_addr, REG_CONTROL_OFFSET, (u32)mode);
+
+    // 2. ѭhl͔ (ֹ)ʹ tvalid }_
+    if (sha2_hw_feed(base_addr, in, inlen, 0)) { return; }
+
     // 3. ȴY (ѭ shake_sha2_test.c ߉݋)
     timeout = 1000000;
     while (((SHA_HW_ReadReg(base_addr, REG_STATUS_OFFSET) & STATUS_RESULT_READY_BIT) == 0) && (timeout > 0)) {
@@ -105,7 +117,7 @@ static void sha2_hw_internal(uint8_t *out, size_t outlen, const uint8_t *in, siz
     size_t regs_to_read = (mode == HW_MODE_SHA2_256) ? SHA256_REG_COUNT : SHA512_REG_COUNT;
 
     for (size_t i = 0; i < regs_to_read; i++) {
-        result_regs[i] = SHA_HW_ReadReg(base_addr, REG_RESULT_START_OFFSET + i * 4);
+        result_regs[i] = SHA_HW_ReadReg(base_addr, REG_RESULT_START_OFFSET + (RESULT_REG_COUNT - 1 - i) * 4);
     }
 
     // 5. }uKQֹݔ (SHA-2 YڼĴǰ)
@@ -204,3 +216,228 @@ void sha512_hw(uint8_t *out, const uint8_t *in, size_t inlen)
     // SHA512 ݔ̶ 64 ֹ
     sha2_hw_internal(out, 64, in, inlen, HW_MODE_SHA2_512);
 }
+
+
+/* --- Descriptor ring --- */
+
+#ifdef HW_RING_COHERENT
+#define RING_FLUSH(addr, len)      ((void)(addr), (void)(len))
+#define RING_INVALIDATE(addr, len) ((void)(addr), (void)(len))
+#else
+#define RING_FLUSH(addr, len)      Xil_DCacheFlushRange((INTPTR)(addr), (u32)(len))
+#define RING_INVALIDATE(addr, len) Xil_DCacheInvalidateRange((INTPTR)(addr), (u32)(len))
+#endif
+
+int hw_ring_init(HwHashRing *ring, HwHashDesc *desc, u32 order, volatile u32 *cmpl)
+{
+    u32 base_addr = IP_CORE_BASEADDR;
+
+    if (order > HW_RING_MAX_ORDER || ((UINTPTR)desc & 63) != 0 || ((UINTPTR)cmpl & 3) != 0) {
+        return -1;
+    }
+    ring->desc = desc;
+    ring->order = order;
+    ring->prod = 0;
+    ring->submitted = 0;
+    ring->cons = 0;
+    ring->cmpl = cmpl;
+    *cmpl = 0;
+    RING_FLUSH(cmpl, sizeof(u32));
+
+    // Disabling clears the error state and the consumer index
+    SHA_HW_WriteReg(base_addr, REG_DMA_CONTROL_OFFSET, 0);
+    SHA_HW_WriteReg(base_addr, REG_DMA_PROD_OFFSET, 0);
+    SHA_HW_WriteReg(base_addr, REG_DMA_RING_BASE_OFFSET, (u32)(UINTPTR)desc);
+    SHA_HW_WriteReg(base_addr, REG_DMA_CMPL_ADDR_OFFSET, (u32)(UINTPTR)cmpl);
+    SHA_HW_WriteReg(base_addr, REG_DMA_CONTROL_OFFSET,
+                    DMA_CONTROL_ENABLE_BIT | (order << DMA_CONTROL_ORDER_SHIFT));
+    return 0;
+}
+
+int hw_ring_queue(HwHashRing *ring, HwHashMode mode, uint8_t *out, size_t outlen,
+                  const uint8_t *prefix, size_t prefix_len,
+                  const uint8_t *tweak, size_t tweak_len,
+                  const uint8_t *in, size_t inlen)
+{
+    HwHashDesc *d;
+
+    if (outlen == 0 || outlen > HW_RING_MAX_OUT || tweak_len > HW_RING_MAX_TWEAK) {
+        return -1;
+    }
+    if (((ring->prod - ring->cons) & 0xFFFF) >= (1U << ring->order)) {
+        return -1;
+    }
+
+    d = &ring->desc[ring->prod & ((1U << ring->order) - 1)];
+    d->ctrl = ((u32)mode & 0xF) | ((u32)outlen << 8) | ((u32)tweak_len << 16);
+    d->in_addr = (u32)(UINTPTR)in;
+    d->in_len = (u32)inlen;
+    d->out_addr = (u32)(UINTPTR)out;
+    d->prefix_addr = (u32)(UINTPTR)prefix;
+    d->prefix_len = (u32)prefix_len;
+    d->tag = ring->prod;
+    d->reserved = 0;
+    if (tweak_len > 0) {
+        memcpy(d->tweak, tweak, tweak_len);
+    }
+
+    if (prefix_len > 0) {
+        RING_FLUSH(prefix, prefix_len);
+    }
+    if (inlen > 0) {
+        RING_FLUSH(in, inlen);
+    }
+    // No dirty line may be evicted over the digest once the IP has written it
+    RING_FLUSH(out, outlen);
+    RING_FLUSH(d, sizeof(HwHashDesc));
+
+    ring->prod++;
+    return 0;
+}
+
+void hw_ring_submit(HwHashRing *ring)
+{
+    // Descriptors and inputs must be visible to the IP before the doorbell
+    dsb();
+    SHA_HW_WriteReg(IP_CORE_BASEADDR, REG_DMA_PROD_OFFSET, ring->prod & 0xFFFF);
+    ring->submitted = ring->prod;
+}
+
+u32 hw_ring_completed(HwHashRing *ring)
+{
+    RING_INVALIDATE(ring->cmpl, sizeof(u32));
+    return *ring->cmpl & 0xFFFF;
+}
+
+int hw_ring_wait(HwHashRing *ring)
+{
+    u32 mask = (1U << ring->order) - 1;
+    int timeout = 1000000;
+
+    while (hw_ring_completed(ring) != (ring->submitted & 0xFFFF)) {
+        if (SHA_HW_ReadReg(IP_CORE_BASEADDR, REG_DMA_STATUS_OFFSET) & DMA_STATUS_ERROR_BIT) {
+            return -1;
+        }
+        if (timeout-- <= 0) {
+            return -1;
+        }
+    }
+
+    // Drop lines the CPU may have speculatively refilled before the IP wrote
+    for (; ring->cons != ring->submitted; ring->cons++) {
+        HwHashDesc *d = &ring->desc[ring->cons & mask];
+        RING_INVALIDATE(d->out_addr, (d->ctrl >> 8) & 0xFF);
+    }
+    return 0;
+}
+
+
+/* --- Tagged SHA-2 jobs --- */
+
+int hw_sha2_queue_init(HwSha2Queue *q, HwHashMode mode)
+{
+    if (mode != HW_MODE_SHA2_256 && mode != HW_MODE_SHA2_512) {
+        return -1;
+    }
+    memset(q, 0, sizeof(HwSha2Queue));
+    q->mode = mode;
+    q->next_tag = 1;
+    SHA_HW_WriteReg(IP_CORE_BASEADDR, REG_SHA2_CMPL_CTRL_OFFSET, SHA2_CMPL_FLUSH_BIT);
+    return 0;
+}
+
+int hw_sha2_submit(HwSha2Queue *q, uint8_t *out, const uint8_t *in, size_t inlen)
+{
+    u32 base_addr = IP_CORE_BASEADDR;
+    u32 i;
+
+    if (q->inflight == SHA2_CMPL_DEPTH || inlen == 0) {
+        return -1;
+    }
+    if (q->inflight == 0) {
+        // Results of untagged calls made since the last job
+        SHA_HW_WriteReg(base_addr, REG_SHA2_CMPL_CTRL_OFFSET, SHA2_CMPL_FLUSH_BIT);
+        SHA_HW_WriteReg(base_addr, REG_CONTROL_OFFSET, (u32)q->mode);
+    }
+    for (i = 0; q->slot[i].tag != 0; i++) {
+    }
+    q->slot[i].tag = q->next_tag;
+    q->slot[i].out = out;
+    q->next_tag = q->next_tag == 0x7FFFFFFF ? 1 : q->next_tag + 1;
+    q->inflight++;
+
+    if (sha2_hw_feed(base_addr, in, inlen, q->slot[i].tag)) {
+        q->slot[i].tag = 0;
+        q->inflight--;
+        return -1;
+    }
+    return (int)q->slot[i].tag;
+}
+
+int hw_sha2_harvest(HwSha2Queue *q)
+{
+    u32 base_addr = IP_CORE_BASEADDR;
+    u32 digest[SHA512_REG_COUNT];
+    u32 words = (q->mode == HW_MODE_SHA2_256) ? SHA256_REG_COUNT : SHA512_REG_COUNT;
+    u32 status, tag, i, w;
+
+    for (;;) {
+        status = SHA_HW_ReadReg(base_addr, REG_SHA2_CMPL_STATUS_OFFSET);
+        if (status & SHA2_CMPL_OVERFLOW_BIT) {
+            return -1;
+        }
+        if ((status & SHA2_CMPL_COUNT_MASK) == 0) {
+            return (int)q->inflight;
+        }
+
+        tag = SHA_HW_ReadReg(base_addr, REG_SHA2_CMPL_OID_OFFSET);
+        for (i = 0; i < SHA2_CMPL_DEPTH; i++) {
+            if (tag != 0 && q->slot[i].tag == tag) {
+                for (w = 0; w < words; w++) {
+                    digest[w] = SHA_HW_ReadReg(base_addr, REG_SHA2_CMPL_DIGEST_OFFSET + w * 4);
+                }
+                reorder_and_swap_bytes_sha2(q->slot[i].out, digest, words * 4);
+                q->slot[i].tag = 0;
+                q->inflight--;
+                break;
+            }
+        }
+        // Entries of unknown tags are dropped
+        SHA_HW_WriteReg(base_addr, REG_SHA2_CMPL_CTRL_OFFSET, SHA2_CMPL_POP_BIT);
+    }
+}
+
+int hw_sha2_drain(HwSha2Queue *q)
+{
+    int timeout = 1000000;
+    int left;
+
+    while ((left = hw_sha2_harvest(q)) > 0) {
+        if (timeout-- <= 0) {
+            return -1;
+        }
+    }
+    return left;
+}
+
+
+/* --- Performance counters --- */
+
+void hw_perf_clear(void)
+{
+    SHA_HW_WriteReg(IP_CORE_BASEADDR, REG_PERF_CTRL_OFFSET, PERF_CLEAR_BIT);
+}
+
+void hw_perf_read(HwPerfCounters *c, int clear)
+{
+    u32 base_addr = IP_CORE_BASEADDR;
+    u32 words[sizeof(HwPerfCounters) / sizeof(u32)];
+    u32 i;
+
+    SHA_HW_WriteReg(base_addr, REG_PERF_CTRL_OFFSET,
+                    PERF_SNAPSHOT_BIT | (clear ? PERF_CLEAR_BIT : 0));
+    for (i = 0; i < sizeof(words) / sizeof(words[0]); i++) {
+        words[i] = SHA_HW_ReadReg(base_addr, REG_PERF_BASE_OFFSET + i * 4);
+    }
+    memcpy(c, words, sizeof(HwPerfCounters));
+}
@@ -47,6 +47,8 @@
 #define STATUS_BUSY_BIT           (1 << 4)
 #define STATUS_RESULT_READY_BIT   (1 << 5) // Ĝyԇaهλ
 #define STATUS_SHA2_TREADY_BIT    (1 << 6)
+#define STATUS_CMD_OVERFLOW_BIT   (1 << 8) // core on its own clock: command FIFO overrun
+#define STATUS_RES_OVERFLOW_BIT   (1 << 9) // core on its own clock: result FIFO overrun, a result was lost
 
 /* * 5.  shake_sha2_top.vx_ģʽֵ
  */
@@ -61,6 +63,98 @@ typedef enum {
 #define SHA256_REG_COUNT 8  // 256 bits / 32 bits
 #define SHA512_REG_COUNT 16 // 512 bits / 32 bits
 
+/* * 6. Descriptor ring (shake_sha2_dma.v): the IP fetches hash jobs from memory
+ * over its M00_AXI master and writes the digests back itself.
+ */
+#define REG_DMA_RING_BASE_OFFSET  0x100 // ring base, 64-byte aligned
+#define REG_DMA_CONTROL_OFFSET    0x104 // enable(0), log2 ring entries(11:8)
+#define REG_DMA_PROD_OFFSET       0x108 // producer index (doorbell)
+#define REG_DMA_CONS_OFFSET       0x10C // consumer index (read-only)
+#define REG_DMA_CMPL_ADDR_OFFSET  0x110 // consumer index write-back address, 0: none
+#define REG_DMA_STATUS_OFFSET     0x114 // busy(0), error(1), error code(6:4) (read-only)
+
+#define DMA_CONTROL_ENABLE_BIT    (1 << 0)
+#define DMA_CONTROL_ORDER_SHIFT   8
+#define DMA_STATUS_BUSY_BIT       (1 << 0)
+#define DMA_STATUS_ERROR_BIT      (1 << 1)
+
+#define HW_RING_MAX_ORDER  15
+#define HW_RING_MAX_OUT    64
+#define HW_RING_MAX_TWEAK  32
+
+/* One job: hash of prefix || tweak || in, outlen bytes to out. */
+typedef struct {
+    u32 ctrl;           // mode(3:0), output bytes(15:8), tweak bytes(23:16)
+    u32 in_addr;
+    u32 in_len;
+    u32 out_addr;
+    u32 prefix_addr;
+    u32 prefix_len;
+    u32 tag;            // SHA-2 tid
+    u32 reserved;
+    uint8_t tweak[HW_RING_MAX_TWEAK];
+} __attribute__((aligned(64))) HwHashDesc;
+
+typedef struct {
+    HwHashDesc *desc;   // 2^order entries
+    u32 order;
+    u32 prod;           // entries queued (free-running, 16 bits used)
+    u32 submitted;      // entries handed to the IP
+    u32 cons;           // entries completed and made visible to the CPU
+    volatile u32 *cmpl; // consumer index written back by the IP
+} HwHashRing;
+
+/* * 7. SHA-2 completion FIFO: every SHA-2 result (outside the descriptor ring)
+ * is queued with the tid of its message, so several tagged messages can be in
+ * flight and are matched to their callers by tag.
+ */
+#define REG_SHA2_CMPL_STATUS_OFFSET 0x120 // count(3:0), overflow(9) (read-only)
+#define REG_SHA2_CMPL_OID_OFFSET    0x124 // tag of the head entry (read-only)
+#define REG_SHA2_CMPL_LEN_OFFSET    0x128 // message bytes of the head entry (read-only)
+#define REG_SHA2_CMPL_CTRL_OFFSET   0x12C // pop(0), flush(1)
+#define REG_SHA2_CMPL_DIGEST_OFFSET 0x140 // 16 words, digest of the head entry
+
+#define SHA2_CMPL_COUNT_MASK      0xF
+#define SHA2_CMPL_OVERFLOW_BIT    (1 << 9)
+#define SHA2_CMPL_POP_BIT         (1 << 0)
+#define SHA2_CMPL_FLUSH_BIT       (1 << 1)
+
+#define SHA2_CMPL_DEPTH 4
+
+typedef struct {
+    u32 tag;            // 0: free slot
+    uint8_t *out;
+} HwSha2Slot;
+
+typedef struct {
+    HwHashMode mode;    // HW_MODE_SHA2_256 or HW_MODE_SHA2_512
+    u32 next_tag;
+    u32 inflight;
+    HwSha2Slot slot[SHA2_CMPL_DEPTH];
+} HwSha2Queue;
+
+/* * 8. Performance counters: free-running 32-bit counts on the AXI clock,
+ * read as one consistent set through a snapshot.
+ */
+#define REG_PERF_CTRL_OFFSET      0xD4  // snapshot(0), clear(1)
+#define REG_PERF_BASE_OFFSET      0xD8  // 10 words, snapshot of the counts (read-only)
+
+#define PERF_SNAPSHOT_BIT         (1 << 0)
+#define PERF_CLEAR_BIT            (1 << 1)
+
+typedef struct {
+    u32 busy;             // clocks a job or the descriptor ring is running
+    u32 idle;             // all other clocks
+    u32 keccak_perms;     // Keccak-f permutations
+    u32 sha2_blocks;      // SHA-2 blocks compressed
+    u32 axi_writes;       // S00_AXI write beats
+    u32 axi_reads;        // S00_AXI read beats
+    u32 dout_ready_wait;  // clocks a SHAKE output block waited for dout_ready
+    u32 tready_wait;      // busy clocks in which the core took no input
+    u32 dma_reads;        // M00_AXI read beats
+    u32 dma_writes;       // M00_AXI write beats
+} HwPerfCounters;
+
 /* ---  API (ṩo SPHINCS+ {) --- */
 
 /**
@@ -78,4 +172,95 @@ void sha256_hw(uint8_t *out, const uint8_t *in, size_t inlen);
  */
 void sha512_hw(uint8_t *out, const uint8_t *in, size_t inlen);
 
+/* --- Descriptor ring API (batches of jobs, one doorbell per batch) ---
+ *
+ * Build with HW_RING_COHERENT when M00_AXI is on the ACP: the IP then sees
+ * the CPU caches and no cache maintenance is done. On an HP port inputs and
+ * descriptors are flushed when queued and outputs invalidated on completion;
+ * outputs should then not share cache lines with data the CPU writes while
+ * the jobs run. All buffers must stay valid until hw_ring_wait() returns.
+ */
+
+/**
+ * @brief Sets up the IP on desc[0 .. 2^order - 1] (64-byte aligned) with the
+ *        completion word *cmpl (4-byte aligned, best on a cache line of its
+ *        own). Also clears an earlier DMA error. Returns 0, or -1 on bad
+ *        arguments. Call only while no jobs are outstanding.
+ */
+int hw_ring_init(HwHashRing *ring, HwHashDesc *desc, u32 order, volatile u32 *cmpl);
+
+/**
+ * @brief Queues one job without starting it. prefix and in may be NULL when
+ *        their length is 0. Returns 0, or -1 if the ring is full or
+ *        outlen/tweak_len are out of range.
+ */
+int hw_ring_queue(HwHashRing *ring, HwHashMode mode, uint8_t *out, size_t outlen,
+                  const uint8_t *prefix, size_t prefix_len,
+                  const uint8_t *tweak, size_t tweak_len,
+                  const uint8_t *in, size_t inlen);
+
+/**
+ * @brief Starts all queued jobs with one register write.
+ */
+void hw_ring_submit(HwHashRing *ring);
+
+/**
+ * @brief Number of jobs completed so far (free-running, 16 bits).
+ */
+u32 hw_ring_completed(HwHashRing *ring);
+
+/**
+ * @brief Waits until all submitted jobs are done. Returns 0, or -1 on a DMA
+ *        error or timeout (hw_ring_init() recovers).
+ */
+int hw_ring_wait(HwHashRing *ring);
+
+/* --- Tagged SHA-2 jobs (up to SHA2_CMPL_DEPTH in flight) ---
+ *
+ * Each message is fed with its own nonzero tid and its digest is taken from
+ * the completion FIFO by tag, so the CPU can prepare the next message while
+ * the core still compresses the previous one. While jobs are in flight no
+ * other SHA-2 or SHAKE call may use the IP, and all jobs of a queue use the
+ * queue's mode.
+ */
+
+/**
+ * @brief Sets up an empty queue for mode and flushes the completion FIFO.
+ *        Returns 0, or -1 if mode is not a SHA-2 mode.
+ */
+int hw_sha2_queue_init(HwSha2Queue *q, HwHashMode mode);
+
+/**
+ * @brief Feeds in (inlen > 0 bytes) as one tagged message whose digest goes to
+ *        out once harvested. Returns the tag, or -1 if SHA2_CMPL_DEPTH jobs
+ *        are in flight or the core stalls.
+ */
+int hw_sha2_submit(HwSha2Queue *q, uint8_t *out, const uint8_t *in, size_t inlen);
+
+/**
+ * @brief Copies every finished digest to its caller's buffer. Returns the
+ *        number of jobs still in flight, or -1 if the FIFO overflowed (the
+ *        queue must then be set up again).
+ */
+int hw_sha2_harvest(HwSha2Queue *q);
+
+/**
+ * @brief Waits until all jobs are done. Returns 0, or -1 on overflow or
+ *        timeout.
+ */
+int hw_sha2_drain(HwSha2Queue *q);
+
+/* --- Performance counters --- */
+
+/**
+ * @brief Zeroes the counters.
+ */
+void hw_perf_clear(void);
+
+/**
+ * @brief Takes a snapshot and reads it into c; the snapshot write itself is
+ *        counted. With clear set the counters restart from 0 at the snapshot.
+ */
+void hw_perf_read(HwPerfCounters *c, int clear);
+
 #endif // FPGA_SHA_DRIVER_H_
@@ -5,6 +5,10 @@
 #include "context.h"
 #include "params.h"
 
+#ifdef SPX_SHA2
+#include "sha2.h"
+#endif
+
 #define initialize_hash_function SPX_NAMESPACE(initialize_hash_function)
 void initialize_hash_function(spx_ctx *ctx);
 
@@ -24,4 +28,48 @@ void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
                   const unsigned char *m, unsigned long long mlen,
                   const spx_ctx *ctx);
 
+/* State of a message digest that is computed as the message arrives. */
+typedef struct {
+#ifdef SPX_SHA2
+# if SPX_N >= 24
+    uint8_t state[8 + SPX_SHA512_OUTPUT_BYTES];
+    uint8_t block[SPX_SHA512_BLOCK_BYTES];
+# else
+    uint8_t state[8 + SPX_SHA256_OUTPUT_BYTES];
+    uint8_t block[SPX_SHA256_BLOCK_BYTES];
+# endif
+    unsigned int blocklen;
+#else
+    uint64_t s_inc[26];
+#endif
+    unsigned char R[SPX_N];
+} spx_hmsg_state;
+
+/*
+ * hash_message() split into init / update / final, so that the message can
+ * be absorbed in pieces. R and pk are absorbed by hash_message_init().
+ */
+#define hash_message_init SPX_NAMESPACE(hash_message_init)
+void hash_message_init(spx_hmsg_state *state,
+                       const unsigned char *R, const unsigned char *pk,
+                       const spx_ctx *ctx);
+
+#define hash_message_update SPX_NAMESPACE(hash_message_update)
+void hash_message_update(spx_hmsg_state *state,
+                         const unsigned char *m, unsigned long long mlen);
+
+#define hash_message_final SPX_NAMESPACE(hash_message_final)
+void hash_message_final(unsigned char *digest, uint64_t *tree,
+                        uint32_t *leaf_idx, spx_hmsg_state *state,
+                        const spx_ctx *ctx);
+
+/*
+ * Hashes in followed by the byte domain to SPX_N bytes, with the family's
+ * message hash (SHAKE256, or SHA-256/SHA-512 as for H_msg). Node hash of the
+ * message trees in batch_sign.h.
+ */
+#define hash_batch SPX_NAMESPACE(hash_batch)
+void hash_batch(unsigned char *out, const unsigned char *in,
+                unsigned long long inlen, unsigned char domain);
+
 #endif
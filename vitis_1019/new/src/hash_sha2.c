@@ -6,6 +6,7 @@
 #include "params.h"
 #include "hash.h"
 #include "sha2.h"
+#include "hashtrace.h"
 
 #if SPX_N >= 24
 #define SPX_SHAX_OUTPUT_BYTES SPX_SHA512_OUTPUT_BYTES
@@ -43,6 +44,8 @@ void prf_addr(unsigned char *out, const spx_ctx *ctx,
     unsigned char buf[SPX_SHA256_ADDR_BYTES + SPX_N];
     unsigned char outbuf[SPX_SHA256_OUTPUT_BYTES];
 
+    SPX_TRACE_SITE(SPX_SITE_PRF);
+
     /* Retrieve precomputed state containing pub_seed */
     memcpy(sha2_state, ctx->state_seeded, 40 * sizeof(uint8_t));
 
@@ -78,6 +81,8 @@ void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
     #error "Currently only supports SPX_N of at most SPX_SHAX_BLOCK_BYTES"
 #endif
 
+    SPX_TRACE_SITE(SPX_SITE_PRF_MSG);
+
     /* This implements HMAC-SHA */
     for (i = 0; i < SPX_N; i++) {
         buf[i] = 0x36 ^ sk_prf[i];
@@ -114,17 +119,66 @@ void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
     memcpy(R, buf, SPX_N);
 }
 
-/**
- * Computes the message hash using R, the public key, and the message.
- * Outputs the message digest and the index of the leaf. The index is split in
- * the tree index and the leaf index, for convenient copying to an address.
+/*
+ * Incremental form of hash_message(); see hash.h.
+ * The message is collected in state->block so that only whole blocks go
+ * through shaX_inc_blocks(), the tail through shaX_inc_finalize().
  */
-void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
-                  const unsigned char *R, const unsigned char *pk,
-                  const unsigned char *m, unsigned long long mlen,
-                  const spx_ctx *ctx)
+void hash_message_init(spx_hmsg_state *state,
+                       const unsigned char *R, const unsigned char *pk,
+                       const spx_ctx *ctx)
 {
     (void)ctx;
+
+#if SPX_N + SPX_PK_BYTES >= SPX_SHAX_BLOCK_BYTES
+    #error "Assumes that R and PK fit into one block"
+#endif
+
+    SPX_TRACE_SITE(SPX_SITE_HMSG);
+    memcpy(state->R, R, SPX_N);
+    shaX_inc_init(state->state);
+
+    // seed: SHA-X(R ‖ PK.seed ‖ PK.root ‖ M)
+    memcpy(state->block, R, SPX_N);
+    memcpy(state->block + SPX_N, pk, SPX_PK_BYTES);
+    state->blocklen = SPX_N + SPX_PK_BYTES;
+}
+
+void hash_message_update(spx_hmsg_state *state,
+                         const unsigned char *m, unsigned long long mlen)
+{
+    unsigned long long take;
+
+    while (mlen > 0) {
+        /* Whole blocks straight from the message */
+        if (state->blocklen == 0 && mlen >= SPX_SHAX_BLOCK_BYTES) {
+            take = mlen - mlen % SPX_SHAX_BLOCK_BYTES;
+            shaX_inc_blocks(state->state, m, (size_t)(take / SPX_SHAX_BLOCK_BYTES));
+            m += take;
+            mlen -= take;
+            continue;
+        }
+
+        take = SPX_SHAX_BLOCK_BYTES - state->blocklen;
+        if (take > mlen) {
+            take = mlen;
+        }
+        memcpy(state->block + state->blocklen, m, (size_t)take);
+        state->blocklen += (unsigned int)take;
+        m += take;
+        mlen -= take;
+
+        if (state->blocklen == SPX_SHAX_BLOCK_BYTES) {
+            shaX_inc_blocks(state->state, state->block, 1);
+            state->blocklen = 0;
+        }
+    }
+}
+
+void hash_message_final(unsigned char *digest, uint64_t *tree,
+                        uint32_t *leaf_idx, spx_hmsg_state *state,
+                        const spx_ctx *ctx)
+{
 #define SPX_TREE_BITS (SPX_TREE_HEIGHT * (SPX_D - 1))
 #define SPX_TREE_BYTES ((SPX_TREE_BITS + 7) / 8)
 #define SPX_LEAF_BITS SPX_TREE_HEIGHT
@@ -132,44 +186,16 @@ void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
 #define SPX_DGST_BYTES (SPX_FORS_MSG_BYTES + SPX_TREE_BYTES + SPX_LEAF_BYTES)
 
     unsigned char seed[2*SPX_N + SPX_SHAX_OUTPUT_BYTES];
-
-    /* Round to nearest multiple of SPX_SHAX_BLOCK_BYTES */
-#if (SPX_SHAX_BLOCK_BYTES & (SPX_SHAX_BLOCK_BYTES-1)) != 0
-    #error "Assumes that SPX_SHAX_BLOCK_BYTES is a power of 2"
-#endif
-#define SPX_INBLOCKS (((SPX_N + SPX_PK_BYTES + SPX_SHAX_BLOCK_BYTES - 1) & \
-                        -SPX_SHAX_BLOCK_BYTES) / SPX_SHAX_BLOCK_BYTES)
-    unsigned char inbuf[SPX_INBLOCKS * SPX_SHAX_BLOCK_BYTES];
-
     unsigned char buf[SPX_DGST_BYTES];
     unsigned char *bufp = buf;
-    uint8_t state[8 + SPX_SHAX_OUTPUT_BYTES];
 
-    shaX_inc_init(state);
-
-    // seed: SHA-X(R ‖ PK.seed ‖ PK.root ‖ M)
-    memcpy(inbuf, R, SPX_N);
-    memcpy(inbuf + SPX_N, pk, SPX_PK_BYTES);
-
-    /* If R + pk + message cannot fill up an entire block */
-    if (SPX_N + SPX_PK_BYTES + mlen < SPX_INBLOCKS * SPX_SHAX_BLOCK_BYTES) {
-        memcpy(inbuf + SPX_N + SPX_PK_BYTES, m, mlen);
-        shaX_inc_finalize(seed + 2*SPX_N, state, inbuf, SPX_N + SPX_PK_BYTES + mlen);
-    }
-    /* Otherwise first fill a block, so that finalize only uses the message */
-    else {
-        memcpy(inbuf + SPX_N + SPX_PK_BYTES, m,
-               SPX_INBLOCKS * SPX_SHAX_BLOCK_BYTES - SPX_N - SPX_PK_BYTES);
-        shaX_inc_blocks(state, inbuf, SPX_INBLOCKS);
-
-        m += SPX_INBLOCKS * SPX_SHAX_BLOCK_BYTES - SPX_N - SPX_PK_BYTES;
-        mlen -= SPX_INBLOCKS * SPX_SHAX_BLOCK_BYTES - SPX_N - SPX_PK_BYTES;
-        shaX_inc_finalize(seed + 2*SPX_N, state, m, mlen);
-    }
+    SPX_TRACE_SITE(SPX_SITE_HMSG);
+    shaX_inc_finalize(seed + 2*SPX_N, state->state,
+                      state->block, state->blocklen);
 
     // H_msg: MGF1-SHA-X(R ‖ PK.seed ‖ seed)
-    memcpy(seed, R, SPX_N);
-    memcpy(seed + SPX_N, pk, SPX_N);
+    memcpy(seed, state->R, SPX_N);
+    memcpy(seed + SPX_N, ctx->pub_seed, SPX_N);
 
     /* By doing this in two steps, we prevent hashing the message twice;
        otherwise each iteration in MGF1 would hash the message again. */
@@ -194,4 +220,45 @@ void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
     *leaf_idx &= (~(uint32_t)0) >> (32 - SPX_LEAF_BITS);
 }
 
+/*
+ * Whole blocks go straight from in; the tail is finalized together with the
+ * domain byte.
+ */
+void hash_batch(unsigned char *out, const unsigned char *in,
+                unsigned long long inlen, unsigned char domain)
+{
+    uint8_t state[8 + SPX_SHAX_OUTPUT_BYTES];
+    unsigned char buf[SPX_SHAX_BLOCK_BYTES];
+    unsigned char outbuf[SPX_SHAX_OUTPUT_BYTES];
+    size_t blocks = (size_t)(inlen / SPX_SHAX_BLOCK_BYTES);
+    size_t rest = (size_t)(inlen % SPX_SHAX_BLOCK_BYTES);
+
+    SPX_TRACE_SITE(SPX_SITE_BATCH);
+    shaX_inc_init(state);
+    shaX_inc_blocks(state, in, blocks);
+
+    memcpy(buf, in + blocks * SPX_SHAX_BLOCK_BYTES, rest);
+    buf[rest] = domain;
+    shaX_inc_finalize(outbuf, state, buf, rest + 1);
+
+    memcpy(out, outbuf, SPX_N);
+}
+
+/**
+ * Computes the message hash using R, the public key, and the message.
+ * Outputs the message digest and the index of the leaf. The index is split in
+ * the tree index and the leaf index, for convenient copying to an address.
+ */
+void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
+                  const unsigned char *R, const unsigned char *pk,
+                  const unsigned char *m, unsigned long long mlen,
+                  const spx_ctx *ctx)
+{
+    spx_hmsg_state state;
+
+    hash_message_init(&state, R, pk, ctx);
+    hash_message_update(&state, m, mlen);
+    hash_message_final(digest, tree, leaf_idx, &state, ctx);
+}
+
 
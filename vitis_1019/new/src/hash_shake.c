@@ -6,6 +6,7 @@
 #include "params.h"
 #include "hash.h"
 #include "fips202.h"
+#include "hashtrace.h"
 
 /* For SHAKE256, there is no immediate reason to initialize at the start,
    so this function is an empty operation. */
@@ -22,6 +23,7 @@ void prf_addr(unsigned char *out, const spx_ctx *ctx,
 {
     unsigned char buf[2*SPX_N + SPX_ADDR_BYTES];
 
+    SPX_TRACE_SITE(SPX_SITE_PRF);
     memcpy(buf, ctx->pub_seed, SPX_N);
     memcpy(buf + SPX_N, addr, SPX_ADDR_BYTES);
     memcpy(buf + SPX_N + SPX_ADDR_BYTES, ctx->sk_seed, SPX_N);
@@ -41,6 +43,7 @@ void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
     (void)ctx;
     uint64_t s_inc[26];
 
+    SPX_TRACE_SITE(SPX_SITE_PRF_MSG);
     shake256_inc_init(s_inc);
     shake256_inc_absorb(s_inc, sk_prf, SPX_N);
     shake256_inc_absorb(s_inc, optrand, SPX_N);
@@ -49,15 +52,31 @@ void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
     shake256_inc_squeeze(R, SPX_N, s_inc);
 }
 
-/**
- * Computes the message hash using R, the public key, and the message.
- * Outputs the message digest and the index of the leaf. The index is split in
- * the tree index and the leaf index, for convenient copying to an address.
+/*
+ * Incremental form of hash_message(); see hash.h.
  */
-void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
-                  const unsigned char *R, const unsigned char *pk,
-                  const unsigned char *m, unsigned long long mlen,
-                  const spx_ctx *ctx)
+void hash_message_init(spx_hmsg_state *state,
+                       const unsigned char *R, const unsigned char *pk,
+                       const spx_ctx *ctx)
+{
+    (void)ctx;
+
+    SPX_TRACE_SITE(SPX_SITE_HMSG);
+    memcpy(state->R, R, SPX_N);
+    shake256_inc_init(state->s_inc);
+    shake256_inc_absorb(state->s_inc, R, SPX_N);
+    shake256_inc_absorb(state->s_inc, pk, SPX_PK_BYTES);
+}
+
+void hash_message_update(spx_hmsg_state *state,
+                         const unsigned char *m, unsigned long long mlen)
+{
+    shake256_inc_absorb(state->s_inc, m, mlen);
+}
+
+void hash_message_final(unsigned char *digest, uint64_t *tree,
+                        uint32_t *leaf_idx, spx_hmsg_state *state,
+                        const spx_ctx *ctx)
 {
     (void)ctx;
 #define SPX_TREE_BITS (SPX_TREE_HEIGHT * (SPX_D - 1))
@@ -68,14 +87,9 @@ void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
 
     unsigned char buf[SPX_DGST_BYTES];
     unsigned char *bufp = buf;
-    uint64_t s_inc[26];
 
-    shake256_inc_init(s_inc);
-    shake256_inc_absorb(s_inc, R, SPX_N);
-    shake256_inc_absorb(s_inc, pk, SPX_PK_BYTES);
-    shake256_inc_absorb(s_inc, m, mlen);
-    shake256_inc_finalize(s_inc);
-    shake256_inc_squeeze(buf, SPX_DGST_BYTES, s_inc);
+    shake256_inc_finalize(state->s_inc);
+    shake256_inc_squeeze(buf, SPX_DGST_BYTES, state->s_inc);
 
     memcpy(digest, bufp, SPX_FORS_MSG_BYTES);
     bufp += SPX_FORS_MSG_BYTES;
@@ -95,3 +109,33 @@ void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
     *leaf_idx = (uint32_t)bytes_to_ull(bufp, SPX_LEAF_BYTES);
     *leaf_idx &= (~(uint32_t)0) >> (32 - SPX_LEAF_BITS);
 }
+
+void hash_batch(unsigned char *out, const unsigned char *in,
+                unsigned long long inlen, unsigned char domain)
+{
+    uint64_t s_inc[26];
+
+    SPX_TRACE_SITE(SPX_SITE_BATCH);
+    shake256_inc_init(s_inc);
+    shake256_inc_absorb(s_inc, in, inlen);
+    shake256_inc_absorb(s_inc, &domain, 1);
+    shake256_inc_finalize(s_inc);
+    shake256_inc_squeeze(out, SPX_N, s_inc);
+}
+
+/**
+ * Computes the message hash using R, the public key, and the message.
+ * Outputs the message digest and the index of the leaf. The index is split in
+ * the tree index and the leaf index, for convenient copying to an address.
+ */
+void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
+                  const unsigned char *R, const unsigned char *pk,
+                  const unsigned char *m, unsigned long long mlen,
+                  const spx_ctx *ctx)
+{
+    spx_hmsg_state state;
+
+    hash_message_init(&state, R, pk, ctx);
+    hash_message_update(&state, m, mlen);
+    hash_message_final(digest, tree, leaf_idx, &state, ctx);
+}
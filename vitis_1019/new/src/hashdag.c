@@ -0,0 +1,238 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "hashdag.h"
+#include "utils.h"
+#include "thash.h"
+#include "address.h"
+#include "params.h"
+
+static void default_kernel(spx_hash_node *const *batch, unsigned int n)
+{
+    unsigned int i;
+
+    for (i = 0; i < n; i++) {
+        thash(batch[i]->out, batch[i]->in, batch[i]->inblocks,
+              batch[i]->ctx, batch[i]->addr);
+    }
+}
+
+static spx_hash_kernel hash_kernel = default_kernel;
+static unsigned int hash_lanes = 1;
+
+void spx_set_hash_kernel(spx_hash_kernel kernel, unsigned int lanes)
+{
+    if (kernel == 0) {
+        hash_kernel = default_kernel;
+        hash_lanes = 1;
+        return;
+    }
+    if (lanes < 1) {
+        lanes = 1;
+    }
+    if (lanes > SPX_DAG_MAX_LANES) {
+        lanes = SPX_DAG_MAX_LANES;
+    }
+    hash_kernel = kernel;
+    hash_lanes = lanes;
+}
+
+void spx_dag_init(spx_hash_dag *dag, spx_hash_node *nodes, unsigned int cap)
+{
+    dag->nodes = nodes;
+    dag->count = 0;
+    dag->cap = cap < SPX_DAG_NONE ? cap : SPX_DAG_NONE;
+}
+
+static int dag_new(spx_hash_dag *dag, unsigned char *out,
+                   const unsigned char *in, unsigned int inblocks,
+                   const uint32_t addr[8])
+{
+    spx_hash_node *node;
+
+    if (dag->count >= dag->cap) {
+        return -1;
+    }
+    node = &dag->nodes[dag->count];
+    memset(node, 0, sizeof(spx_hash_node));
+    node->out = out;
+    node->in = in;
+    node->inblocks = (uint16_t)inblocks;
+    node->steps = 1;
+    memcpy(node->addr, addr, 8 * sizeof(uint32_t));
+
+    return (int)dag->count++;
+}
+
+int spx_dag_add(spx_hash_dag *dag, unsigned char *out,
+                const unsigned char *in, unsigned int inblocks,
+                const uint32_t addr[8])
+{
+    return dag_new(dag, out, in, inblocks, addr);
+}
+
+int spx_dag_add_chain(spx_hash_dag *dag, unsigned char *out,
+                      const unsigned char *in,
+                      unsigned int start, unsigned int steps,
+                      const uint32_t addr[8])
+{
+    int idx = dag_new(dag, out, in, 1, addr);
+
+    if (idx < 0) {
+        return -1;
+    }
+    /* As in gen_chain(), the chain never runs past its top. */
+    if (start + steps > SPX_WOTS_W) {
+        steps = start < SPX_WOTS_W ? SPX_WOTS_W - start : 0;
+    }
+    dag->nodes[idx].chain = 1;
+    dag->nodes[idx].chain_pos = start;
+    dag->nodes[idx].steps = (uint16_t)steps;
+
+    return idx;
+}
+
+void spx_dag_run(spx_hash_dag *dag, const spx_ctx *ctx)
+{
+    spx_hash_node *nodes = dag->nodes;
+    spx_hash_node *batch[SPX_DAG_MAX_LANES];
+    uint16_t head = SPX_DAG_NONE;
+    uint16_t tail = SPX_DAG_NONE;
+    uint16_t idx;
+    unsigned int i, n;
+
+/* Appends node i to the ready list. */
+#define DAG_PUSH(i) do {                                        \
+        nodes[i].link = SPX_DAG_NONE;                           \
+        if (head == SPX_DAG_NONE) { head = (uint16_t)(i); }     \
+        else { nodes[tail].link = (uint16_t)(i); }              \
+        tail = (uint16_t)(i);                                   \
+    } while (0)
+
+    for (i = 0; i < dag->count; i++) {
+        DAG_PUSH(i);
+    }
+
+    while (head != SPX_DAG_NONE) {
+        n = 0;
+        while (head != SPX_DAG_NONE && n < hash_lanes &&
+               (n == 0 || nodes[head].inblocks == batch[0]->inblocks)) {
+            idx = head;
+            head = nodes[idx].link;
+
+            if (nodes[idx].steps == 0) {
+                /* A chain with nothing to do: its output is its input. */
+                if (nodes[idx].out != nodes[idx].in) {
+                    memcpy(nodes[idx].out, nodes[idx].in, SPX_N);
+                }
+                continue;
+            }
+            if (nodes[idx].ctx == 0) {
+                nodes[idx].ctx = ctx;
+            }
+            if (nodes[idx].chain) {
+                set_hash_addr(nodes[idx].addr, nodes[idx].chain_pos);
+            }
+            batch[n++] = &nodes[idx];
+        }
+        if (head == SPX_DAG_NONE) {
+            tail = SPX_DAG_NONE;
+        }
+        if (n == 0) {
+            continue;
+        }
+
+        hash_kernel(batch, n);
+
+        for (i = 0; i < n; i++) {
+            idx = (uint16_t)(batch[i] - nodes);
+            if (--nodes[idx].steps) {
+                /* Chains go to the back so other chains share the lanes. */
+                nodes[idx].in = nodes[idx].out;
+                nodes[idx].chain_pos++;
+                DAG_PUSH(idx);
+            }
+        }
+    }
+
+#undef DAG_PUSH
+}
+
+void spx_root_walk_init(spx_root_walk *walk, unsigned char *root,
+                        const unsigned char *leaf,
+                        uint32_t leaf_idx, uint32_t idx_offset,
+                        const unsigned char *auth_path,
+                        const spx_ctx *ctx, const uint32_t addr[8])
+{
+    /* If leaf_idx is odd (last bit = 1), current path element is a right child
+       and auth_path has to go left. Otherwise it is the other way around. */
+    if (leaf_idx & 1) {
+        memcpy(walk->buffer + SPX_N, leaf, SPX_N);
+        memcpy(walk->buffer, auth_path, SPX_N);
+    }
+    else {
+        memcpy(walk->buffer, leaf, SPX_N);
+        memcpy(walk->buffer + SPX_N, auth_path, SPX_N);
+    }
+    walk->root = root;
+    walk->auth_path = auth_path + SPX_N;
+    walk->leaf_idx = leaf_idx;
+    walk->idx_offset = idx_offset;
+    walk->ctx = ctx;
+    memcpy(walk->addr, addr, 8 * sizeof(uint32_t));
+}
+
+void spx_root_walks(spx_root_walk *walks, unsigned int count,
+                    uint32_t tree_height)
+{
+    SPX_VLA(spx_hash_node, nodes, SPX_DAG_WINDOW);
+    spx_hash_dag dag;
+    unsigned int first, j;
+    uint32_t i;
+    int last;
+
+    for (i = 0; i < tree_height; i++) {
+        last = (i == tree_height - 1);
+
+        for (j = 0; j < count; ) {
+            spx_dag_init(&dag, nodes, SPX_DAG_WINDOW);
+            for (first = j; j < count && j - first < SPX_DAG_WINDOW; j++) {
+                spx_root_walk *w = &walks[j];
+                unsigned char *out;
+                int idx;
+
+                w->leaf_idx >>= 1;
+                w->idx_offset >>= 1;
+                /* Set the address of the node we're creating. */
+                set_tree_height(w->addr, i + 1);
+                set_tree_index(w->addr, w->leaf_idx + w->idx_offset);
+
+                if (last) {
+                    out = w->root;
+                }
+                else {
+                    out = w->buffer + ((w->leaf_idx & 1) ? SPX_N : 0);
+                }
+                idx = spx_dag_add(&dag, out, w->buffer, 2, w->addr);
+                dag.nodes[idx].ctx = w->ctx;
+            }
+            spx_dag_run(&dag, 0);
+        }
+
+        if (last) {
+            break;
+        }
+        /* Pick the right or left neighbor, depending on parity of the node. */
+        for (j = 0; j < count; j++) {
+            spx_root_walk *w = &walks[j];
+
+            if (w->leaf_idx & 1) {
+                memcpy(w->buffer, w->auth_path, SPX_N);
+            }
+            else {
+                memcpy(w->buffer + SPX_N, w->auth_path, SPX_N);
+            }
+            w->auth_path += SPX_N;
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef SPX_HASHDAG_H
+#define SPX_HASHDAG_H
+
+#include <stdint.h>
+
+#include "params.h"
+#include "context.h"
+
+/*
+ * Batching layer for tweakable hash calls.
+ *
+ * A graph of independent calls and WOTS chains is built with spx_dag_add*()
+ * and handed to spx_dag_run(), which repeatedly collects up to 'lanes' ready
+ * calls with the same input length and passes them to the installed kernel.
+ * Tree levels that depend on each other go through separate graphs, as in
+ * spx_root_walks().
+ *
+ * A backend only has to provide one kernel that executes n independent
+ * calls; hashdag_hw.h has those for the descriptor ring and the SHA-2 tag
+ * queue of shake_sha2_ip.
+ */
+#define SPX_DAG_NONE 0xffffu
+
+/* Upper bound for the number of lanes a kernel may ask for. */
+#define SPX_DAG_MAX_LANES 8
+
+typedef struct {
+    unsigned char *out;
+    const unsigned char *in;
+    const spx_ctx *ctx;  /* NULL: the ctx passed to spx_dag_run() */
+    uint32_t addr[8];
+    uint32_t chain_pos;  /* hash address of the next step, chains only */
+    uint16_t inblocks;
+    uint16_t steps;      /* calls left; chains feed each step the last output */
+    uint16_t link;       /* ready list */
+    uint8_t chain;
+} spx_hash_node;
+
+/*
+ * Computes node->out = thash(node->in, node->inblocks, node->ctx, node->addr)
+ * for the n nodes in batch. All nodes in a batch have the same inblocks, and
+ * n never exceeds the lanes the kernel was installed with. Nodes may belong
+ * to different keys (ctx), and out may overlap in.
+ */
+typedef void (*spx_hash_kernel)(spx_hash_node *const *batch, unsigned int n);
+
+/* Nodes the WOTS routines keep on the stack per graph; a multiple of the
+   lane count keeps all lanes busy until the last steps of a window. */
+#ifndef SPX_DAG_WINDOW
+#define SPX_DAG_WINDOW 16
+#endif
+
+typedef struct {
+    spx_hash_node *nodes;
+    unsigned int count;
+    unsigned int cap;
+} spx_hash_dag;
+
+/*
+ * Installs kernel with the given number of lanes (clamped to
+ * 1..SPX_DAG_MAX_LANES). NULL restores the default kernel, which calls
+ * thash() once per node.
+ */
+#define spx_set_hash_kernel SPX_NAMESPACE(spx_set_hash_kernel)
+void spx_set_hash_kernel(spx_hash_kernel kernel, unsigned int lanes);
+
+#define spx_dag_init SPX_NAMESPACE(spx_dag_init)
+void spx_dag_init(spx_hash_dag *dag, spx_hash_node *nodes, unsigned int cap);
+
+/*
+ * Adds a single call. Returns the node index, or -1 if the graph is full.
+ */
+#define spx_dag_add SPX_NAMESPACE(spx_dag_add)
+int spx_dag_add(spx_hash_dag *dag, unsigned char *out,
+                const unsigned char *in, unsigned int inblocks,
+                const uint32_t addr[8]);
+
+/*
+ * Adds 'steps' chain iterations starting at hash address 'start', as in
+ * gen_chain(). With steps == 0, in is copied to out. out may equal in.
+ * Returns the node index, or -1 if the graph is full.
+ */
+#define spx_dag_add_chain SPX_NAMESPACE(spx_dag_add_chain)
+int spx_dag_add_chain(spx_hash_dag *dag, unsigned char *out,
+                      const unsigned char *in,
+                      unsigned int start, unsigned int steps,
+                      const uint32_t addr[8]);
+
+/*
+ * Executes all calls of the graph. ctx is used for
+ * every node that does not have one of its own.
+ */
+#define spx_dag_run SPX_NAMESPACE(spx_dag_run)
+void spx_dag_run(spx_hash_dag *dag, const spx_ctx *ctx);
+
+/*
+ * State of one compute_root() evaluation, so that many of them (FORS trees,
+ * hypertree layers of different signatures) can advance level by level in
+ * lock-step through the scheduler.
+ */
+typedef struct {
+    unsigned char buffer[2 * SPX_N];
+    unsigned char *root;
+    const unsigned char *auth_path;
+    uint32_t leaf_idx;
+    uint32_t idx_offset;
+    uint32_t addr[8];
+    const spx_ctx *ctx;
+} spx_root_walk;
+
+/*
+ * Sets up walk with the same arguments as compute_root().
+ */
+#define spx_root_walk_init SPX_NAMESPACE(spx_root_walk_init)
+void spx_root_walk_init(spx_root_walk *walk, unsigned char *root,
+                        const unsigned char *leaf,
+                        uint32_t leaf_idx, uint32_t idx_offset,
+                        const unsigned char *auth_path,
+                        const spx_ctx *ctx, const uint32_t addr[8]);
+
+/*
+ * Runs count walks over tree_height levels; each level of all walks is one
+ * set of independent calls. Writes each result to walk->root.
+ */
+#define spx_root_walks SPX_NAMESPACE(spx_root_walks)
+void spx_root_walks(spx_root_walk *walks, unsigned int count,
+                    uint32_t tree_height);
+
+#endif
@@ -0,0 +1,156 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "hashdag_hw.h"
+#include "thash.h"
+#include "utils.h"
+#include "params.h"
+#ifdef SPX_SHA2
+#include "sha2.h"
+#endif
+
+#ifndef SPX_HARAKA
+static spx_hw_ring_area *ring_area;
+static HwHashRing ring;
+
+static void thash_batch(spx_hash_node *const *batch, unsigned int n)
+{
+    unsigned int i;
+
+    for (i = 0; i < n; i++) {
+        thash(batch[i]->out, batch[i]->in, batch[i]->inblocks,
+              batch[i]->ctx, batch[i]->addr);
+    }
+}
+
+static void ring_kernel(spx_hash_node *const *batch, unsigned int n)
+{
+    spx_hw_ring_area *a = ring_area;
+    size_t inlen = batch[0]->inblocks * SPX_N;
+    size_t prefix_len, tweak_len;
+    HwHashMode mode;
+    unsigned int i;
+
+    if (inlen > SPX_HW_RING_INBYTES) {
+        thash_batch(batch, n);
+        return;
+    }
+
+#ifdef SPX_SHA2
+    /* thash() continues from pub_seed padded to one block */
+    mode = HW_MODE_SHA2_256;
+    prefix_len = SPX_SHA256_BLOCK_BYTES;
+# if SPX_SHA512
+    if (batch[0]->inblocks > 1) {
+        mode = HW_MODE_SHA2_512;
+        prefix_len = SPX_SHA512_BLOCK_BYTES;
+    }
+# endif
+    tweak_len = SPX_SHA256_ADDR_BYTES;
+#else
+    mode = HW_MODE_SHAKE_256;
+    prefix_len = SPX_N;
+    tweak_len = SPX_ADDR_BYTES;
+#endif
+
+    for (i = 0; i < n; i++) {
+        memset(a->lane[i].prefix, 0, prefix_len);
+        memcpy(a->lane[i].prefix, batch[i]->ctx->pub_seed, SPX_N);
+        memcpy(a->lane[i].in, batch[i]->in, inlen);
+        if (hw_ring_queue(&ring, mode, a->lane[i].out, SPX_N,
+                          a->lane[i].prefix, prefix_len,
+                          (const uint8_t *)batch[i]->addr, tweak_len,
+                          a->lane[i].in, inlen)) {
+            break;
+        }
+    }
+    if (i == n) {
+        hw_ring_submit(&ring);
+        if (hw_ring_wait(&ring) == 0) {
+            for (i = 0; i < n; i++) {
+                memcpy(batch[i]->out, a->lane[i].out, SPX_N);
+            }
+            return;
+        }
+    }
+
+    /* Queued descriptors are dropped with the reset. */
+    hw_ring_init(&ring, a->desc, SPX_HW_RING_ORDER, a->cmpl);
+    thash_batch(batch, n);
+}
+#endif
+
+int spx_hw_ring_install(spx_hw_ring_area *area, unsigned int lanes)
+{
+#ifdef SPX_HARAKA
+    (void)area;
+    (void)lanes;
+    return -1;
+#else
+    if (hw_ring_init(&ring, area->desc, SPX_HW_RING_ORDER, area->cmpl)) {
+        return -1;
+    }
+    ring_area = area;
+    if (lanes > (1U << SPX_HW_RING_ORDER)) {
+        lanes = 1U << SPX_HW_RING_ORDER;
+    }
+    spx_set_hash_kernel(ring_kernel, lanes);
+    return 0;
+#endif
+}
+
+#ifdef SPX_SHA2
+static HwSha2Queue tags;
+
+static void tags_kernel(spx_hash_node *const *batch, unsigned int n)
+{
+    static uint8_t msg[SPX_SHA512_BLOCK_BYTES + SPX_SHA256_ADDR_BYTES +
+                       SPX_HW_RING_INBYTES];
+    static uint8_t digest[SHA2_CMPL_DEPTH][SPX_SHA512_OUTPUT_BYTES];
+    size_t inlen = batch[0]->inblocks * SPX_N;
+    size_t seed_len = SPX_SHA256_BLOCK_BYTES;
+    HwHashMode mode = HW_MODE_SHA2_256;
+    unsigned int i;
+
+    if (inlen > SPX_HW_RING_INBYTES) {
+        thash_batch(batch, n);
+        return;
+    }
+#if SPX_SHA512
+    if (batch[0]->inblocks > 1) {
+        mode = HW_MODE_SHA2_512;
+        seed_len = SPX_SHA512_BLOCK_BYTES;
+    }
+#endif
+
+    /* The inputs are fed before hw_sha2_submit() returns. */
+    hw_sha2_queue_init(&tags, mode);
+    memset(msg, 0, seed_len);
+    for (i = 0; i < n; i++) {
+        memcpy(msg, batch[i]->ctx->pub_seed, SPX_N);
+        memcpy(msg + seed_len, batch[i]->addr, SPX_SHA256_ADDR_BYTES);
+        memcpy(msg + seed_len + SPX_SHA256_ADDR_BYTES, batch[i]->in, inlen);
+        if (hw_sha2_submit(&tags, digest[i], msg,
+                           seed_len + SPX_SHA256_ADDR_BYTES + inlen) < 0) {
+            break;
+        }
+    }
+    if (hw_sha2_drain(&tags) == 0 && i == n) {
+        for (i = 0; i < n; i++) {
+            memcpy(batch[i]->out, digest[i], SPX_N);
+        }
+        return;
+    }
+    thash_batch(batch, n);
+}
+#endif
+
+int spx_hw_sha2_tags_install(void)
+{
+#ifdef SPX_SHA2
+    spx_set_hash_kernel(tags_kernel, SHA2_CMPL_DEPTH);
+    return 0;
+#else
+    return -1;
+#endif
+}
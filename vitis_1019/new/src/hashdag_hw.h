@@ -0,0 +1,67 @@
+#ifndef SPX_HASHDAG_HW_H
+#define SPX_HASHDAG_HW_H
+
+#include <stdint.h>
+
+#include "params.h"
+#include "hashdag.h"
+#include "fpga_sha_driver.h"
+
+/*
+ * Hash kernels (hashdag.h) on shake_sha2_ip, for the simple thash of the
+ * SHAKE and SHA-2 parameter sets.
+ *
+ * The descriptor ring kernel queues every call of a batch as one descriptor,
+ * with pub_seed as the prefix (for SHA-2 padded to a whole block, as in
+ * state_seeded), ADRS as the inline tweak and the input copied to its lane,
+ * and rings the doorbell once per batch. The IP reads the messages and
+ * writes the outputs back over M00_AXI, so the CPU writes no register per
+ * byte or word.
+ *
+ * The tag queue kernel (SHA-2 parameter sets) feeds the whole message of
+ * each call as a tagged job over S00_AXI and takes the digests from the
+ * SHA-2 completion FIFO, so the CPU writes the next message while the core
+ * compresses the previous ones.
+ */
+
+/* 2^3 descriptors, one per lane */
+#define SPX_HW_RING_ORDER 3
+
+/* Largest thash input a lane holds; larger calls go to thash(). */
+#define SPX_HW_RING_INBYTES \
+    ((SPX_WOTS_LEN > SPX_FORS_TREES ? SPX_WOTS_LEN : SPX_FORS_TREES) * SPX_N)
+
+/*
+ * Everything the IP reads and writes for the ring kernel. On the board it
+ * must lie where the M00_AXI master reaches it; on the host model it is
+ * given to hw_model_dma_map().
+ */
+typedef struct {
+    HwHashDesc desc[1 << SPX_HW_RING_ORDER];
+    volatile u32 cmpl[16];
+    struct {
+        uint8_t prefix[128];
+        uint8_t out[64];
+        uint8_t in[SPX_HW_RING_INBYTES];
+    } __attribute__((aligned(64))) lane[1 << SPX_HW_RING_ORDER];
+} spx_hw_ring_area;
+
+/*
+ * Sets up the ring on area and installs its kernel with lanes lanes
+ * (clamped to 1..2^SPX_HW_RING_ORDER). spx_set_hash_kernel(NULL, 0) removes
+ * it again. After a DMA error the kernel resets the ring and computes the
+ * batch with thash(). Returns 0, or -1 if the ring could not be set up.
+ */
+#define spx_hw_ring_install SPX_NAMESPACE(spx_hw_ring_install)
+int spx_hw_ring_install(spx_hw_ring_area *area, unsigned int lanes);
+
+
+/*
+ * Installs the tag queue kernel with SHA2_CMPL_DEPTH lanes. After a FIFO
+ * overflow or timeout it computes the batch with thash(). Returns 0, or -1
+ * for parameter sets other than SHA-2.
+ */
+#define spx_hw_sha2_tags_install SPX_NAMESPACE(spx_hw_sha2_tags_install)
+int spx_hw_sha2_tags_install(void);
+
+#endif
@@ -0,0 +1,163 @@
+#ifdef SPX_HASH_TRACE
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hashtrace.h"
+
+/* Incremental SHAKE states open at one time (hash_message plus one more) */
+#define TRACE_OPEN 4
+
+static const char *const site_names[SPX_SITE_COUNT] = {
+    "other", "thash", "prf", "prf_msg", "hash_message", "seed", "batch",
+    "vcache", "prehash"
+};
+
+struct trace_rec {
+    int site;
+    int mode;
+    size_t inlen;
+    size_t prefix;
+    size_t outlen;
+    unsigned long count;
+};
+
+static struct {
+    const void *state;
+    size_t inlen;
+    int site;
+} open_inc[TRACE_OPEN];
+
+int spx_trace_site;
+
+static FILE *trace_file;
+static int trace_failed;
+static struct trace_rec pending;
+
+static const char *mode_name(int mode)
+{
+    switch (mode) {
+    case SPX_TRACE_SHA256:   return "sha256";
+    case SPX_TRACE_SHA512:   return "sha512";
+    case SPX_TRACE_SHAKE256: return "shake256";
+    default:                 return "unknown";
+    }
+}
+
+static void trace_flush(void)
+{
+    if (pending.count == 0) {
+        return;
+    }
+    fprintf(trace_file, "%s %s %lu %lu %lu %lu\n", site_names[pending.site],
+            mode_name(pending.mode), (unsigned long)pending.inlen,
+            (unsigned long)pending.prefix, (unsigned long)pending.outlen,
+            pending.count);
+    pending.count = 0;
+}
+
+static void trace_close(void)
+{
+    trace_flush();
+    fclose(trace_file);
+    trace_file = NULL;
+}
+
+static int trace_open(void)
+{
+    if (trace_file != NULL) {
+        return 0;
+    }
+    if (trace_failed) {
+        return -1;
+    }
+    trace_file = fopen(SPX_HASH_TRACE_FILE, "w");
+    if (trace_file == NULL) {
+        trace_failed = 1;
+        return -1;
+    }
+    fprintf(trace_file, "# hash trace %s\n", xstr(PARAMS));
+    atexit(trace_close);
+    return 0;
+}
+
+static void trace_record(int site, int mode, size_t inlen, size_t prefix,
+                         size_t outlen)
+{
+    if (trace_open()) {
+        return;
+    }
+    if (pending.count != 0 && pending.site == site && pending.mode == mode &&
+        pending.inlen == inlen && pending.prefix == prefix &&
+        pending.outlen == outlen) {
+        pending.count++;
+        return;
+    }
+    trace_flush();
+    pending.site = site;
+    pending.mode = mode;
+    pending.inlen = inlen;
+    pending.prefix = prefix;
+    pending.outlen = outlen;
+    pending.count = 1;
+}
+
+void spx_trace_call(int mode, size_t inlen, size_t prefix, size_t outlen)
+{
+    trace_record(spx_trace_site, mode, inlen, prefix, outlen);
+}
+
+void spx_trace_inc_init(const void *state)
+{
+    int i, slot = 0;
+
+    /* A state that is never squeezed (or went out of scope) is reused. */
+    for (i = 0; i < TRACE_OPEN; i++) {
+        if (open_inc[i].state == state || open_inc[i].state == NULL) {
+            slot = i;
+            break;
+        }
+    }
+    open_inc[slot].state = state;
+    open_inc[slot].inlen = 0;
+    open_inc[slot].site = spx_trace_site;
+}
+
+void spx_trace_inc_absorb(const void *state, size_t inlen)
+{
+    int i;
+
+    for (i = 0; i < TRACE_OPEN; i++) {
+        if (open_inc[i].state == state) {
+            open_inc[i].inlen += inlen;
+            return;
+        }
+    }
+}
+
+void spx_trace_inc_squeeze(const void *state, size_t outlen)
+{
+    int i;
+
+    /* Only the first squeeze after init is a call; later ones continue it. */
+    for (i = 0; i < TRACE_OPEN; i++) {
+        if (open_inc[i].state == state) {
+            trace_record(open_inc[i].site, SPX_TRACE_SHAKE256,
+                         open_inc[i].inlen, 0, outlen);
+            open_inc[i].state = NULL;
+            return;
+        }
+    }
+}
+
+void spx_trace_mark(const char *name)
+{
+    if (trace_open()) {
+        return;
+    }
+    trace_flush();
+    fprintf(trace_file, "mark %s\n", name);
+    spx_trace_site = SPX_SITE_OTHER;
+}
+
+#endif
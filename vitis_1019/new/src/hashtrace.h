@@ -0,0 +1,86 @@
+#ifndef SPX_HASHTRACE_H
+#define SPX_HASHTRACE_H
+
+#include <stddef.h>
+
+#include "params.h"
+
+/*
+ * Hash-call trace, for working out which IP change pays off (host/hash_replay.c
+ * plays a trace against the register model). Built with -DSPX_HASH_TRACE,
+ * every shake256(), sha256() and sha512() call and every incremental hash
+ * that is finalized is written to SPX_HASH_TRACE_FILE, one line per run of
+ * identical calls:
+ *
+ *   <site> <mode> <inlen> <prefix> <outlen> <count>
+ *
+ * mode is shake256, sha256 or sha512; inlen counts all message bytes and
+ * prefix those already compressed into a copied SHA-2 state (pub_seed in
+ * thash and prf_addr, the HMAC key block). A line "mark <name>" starts a
+ * keygen, sign or verify call. Without SPX_HASH_TRACE the macros below are
+ * empty. Single-threaded hosts only; on the board the file cannot be opened
+ * and nothing is recorded.
+ */
+
+#ifndef SPX_HASH_TRACE_FILE
+#define SPX_HASH_TRACE_FILE "hash_trace.txt"
+#endif
+
+/* Callers, by the function that starts the hash */
+enum {
+    SPX_SITE_OTHER = 0,
+    SPX_SITE_THASH,
+    SPX_SITE_PRF,           /* prf_addr */
+    SPX_SITE_PRF_MSG,       /* gen_message_random */
+    SPX_SITE_HMSG,          /* hash_message and its MGF1 */
+    SPX_SITE_SEED,          /* seed_state */
+    SPX_SITE_BATCH,         /* hash_batch */
+    SPX_SITE_VCACHE,
+    SPX_SITE_PREHASH,
+    SPX_SITE_COUNT
+};
+
+/* Modes, numbered as REG0[3:0] of the IP (HwHashMode) */
+#define SPX_TRACE_SHA256    0
+#define SPX_TRACE_SHA512    1
+#define SPX_TRACE_SHAKE256  9
+
+#ifdef SPX_HASH_TRACE
+
+#define spx_trace_site SPX_NAMESPACE(spx_trace_site)
+extern int spx_trace_site;
+
+/* One finished hash at the current site. */
+#define spx_trace_call SPX_NAMESPACE(spx_trace_call)
+void spx_trace_call(int mode, size_t inlen, size_t prefix, size_t outlen);
+
+/* Incremental SHAKE: the length is kept per state until the first squeeze. */
+#define spx_trace_inc_init SPX_NAMESPACE(spx_trace_inc_init)
+void spx_trace_inc_init(const void *state);
+#define spx_trace_inc_absorb SPX_NAMESPACE(spx_trace_inc_absorb)
+void spx_trace_inc_absorb(const void *state, size_t inlen);
+#define spx_trace_inc_squeeze SPX_NAMESPACE(spx_trace_inc_squeeze)
+void spx_trace_inc_squeeze(const void *state, size_t outlen);
+
+#define spx_trace_mark SPX_NAMESPACE(spx_trace_mark)
+void spx_trace_mark(const char *name);
+
+#define SPX_TRACE_SITE(site)                        (spx_trace_site = (site))
+#define SPX_TRACE_CALL(mode, inlen, prefix, outlen) spx_trace_call(mode, inlen, prefix, outlen)
+#define SPX_TRACE_INC_INIT(state)                   spx_trace_inc_init(state)
+#define SPX_TRACE_INC_ABSORB(state, inlen)          spx_trace_inc_absorb(state, inlen)
+#define SPX_TRACE_INC_SQUEEZE(state, outlen)        spx_trace_inc_squeeze(state, outlen)
+#define SPX_TRACE_MARK(name)                        spx_trace_mark(name)
+
+#else
+
+#define SPX_TRACE_SITE(site)                        ((void)0)
+#define SPX_TRACE_CALL(mode, inlen, prefix, outlen) ((void)0)
+#define SPX_TRACE_INC_INIT(state)                   ((void)0)
+#define SPX_TRACE_INC_ABSORB(state, inlen)          ((void)0)
+#define SPX_TRACE_INC_SQUEEZE(state, outlen)        ((void)0)
+#define SPX_TRACE_MARK(name)                        ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,312 @@
+/*
+ * Plays a hash trace (../hashtrace.h) against the IP: every traced call goes
+ * through fpga_sha_driver.c as it would on the board, and the IP clocks it
+ * takes are added up per keygen, sign and verify and per call site. The
+ * options set the latencies of a hypothetical IP; the result is the bus time
+ * per operation and the signatures per second it leaves room for, e.g.
+ *   make host/hash_replay && ./host/hash_replay --keccak 13 hash_trace.txt
+ *
+ * Built in shake_sha2/sim/cosim (HASH_REPLAY_RTL) the calls run on the
+ * Verilated RTL instead, with the latencies its IP_PARAMS give.
+ *
+ * From an idle IP calls of the same mode and lengths cost the same, so each
+ * is run once and multiplied. SHA-2 calls with nothing left to send after
+ * --midstate are counted as one byte, since the IP takes no empty message.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hw_model.h"
+#include "fpga_sha_driver.h"
+
+#define MAX_SECTIONS 8
+#define MAX_SITES    16
+#define MEMO_SIZE    4096
+
+static const char *const site_names[] = {
+    "other", "thash", "prf", "prf_msg", "hash_message", "seed", "batch",
+    "vcache", "prehash"
+};
+#define NSITES (sizeof(site_names) / sizeof(site_names[0]))
+
+struct site_total {
+    uint64_t calls;
+    uint64_t bytes;     /* sent to the IP */
+    uint64_t clocks;
+};
+
+struct section {
+    char name[16];
+    uint64_t marks;
+    struct site_total site[MAX_SITES];
+};
+
+static struct section sections[MAX_SECTIONS];
+static int nsections;
+
+static struct {
+    int mode;
+    size_t inlen;
+    size_t outlen;
+    uint64_t clocks;
+    int used;
+} memo[MEMO_SIZE];
+
+static hw_model_config cfg;
+static int midstate;
+static uint8_t *inbuf;
+static size_t inbuf_len;
+
+static struct section *section_named(const char *name)
+{
+    int i;
+
+    for (i = 0; i < nsections; i++) {
+        if (!strcmp(sections[i].name, name)) {
+            return &sections[i];
+        }
+    }
+    if (nsections == MAX_SECTIONS) {
+        return &sections[MAX_SECTIONS - 1];
+    }
+    snprintf(sections[nsections].name, sizeof(sections[nsections].name), "%.15s", name);
+    return &sections[nsections++];
+}
+
+/* IP clocks of one driver call on an idle IP */
+static uint64_t call_clocks(int mode, size_t inlen, size_t outlen)
+{
+    uint8_t out[RESULT_REG_COUNT * 4];
+    hw_model_stats st;
+    uint64_t start;
+    unsigned int h;
+
+    h = (unsigned int)(((size_t)mode * 31 + inlen * 131 + outlen) % MEMO_SIZE);
+    while (memo[h].used) {
+        if (memo[h].mode == mode && memo[h].inlen == inlen && memo[h].outlen == outlen) {
+            return memo[h].clocks;
+        }
+        h = (h + 1) % MEMO_SIZE;
+    }
+
+    if (inlen > inbuf_len) {
+        inbuf = realloc(inbuf, inlen);
+        if (inbuf == NULL) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+        memset(inbuf, 0, inlen);
+        inbuf_len = inlen;
+    }
+    if (outlen > sizeof(out)) {
+        outlen = sizeof(out);
+    }
+
+    hw_model_get_stats(&st);
+    start = st.now;
+    switch (mode) {
+    case HW_MODE_SHA2_256:
+        sha256_hw(out, inbuf, inlen);
+        break;
+    case HW_MODE_SHA2_512:
+        sha512_hw(out, inbuf, inlen);
+        break;
+    default:
+        shake256_hw(out, outlen, inbuf, inlen);
+        break;
+    }
+    hw_model_get_stats(&st);
+
+    memo[h].mode = mode;
+    memo[h].inlen = inlen;
+    memo[h].outlen = outlen;
+    memo[h].clocks = st.now - start;
+    memo[h].used = 1;
+    return memo[h].clocks;
+}
+
+static int replay_line(struct section *sec, const char *line)
+{
+    char site[16], mode[16];
+    unsigned long inlen, prefix, outlen, count;
+    uint64_t clocks;
+    unsigned int s;
+    int m;
+
+    if (sscanf(line, "%15s %15s %lu %lu %lu %lu", site, mode, &inlen, &prefix,
+               &outlen, &count) != 6) {
+        return -1;
+    }
+    if (!strcmp(mode, "sha256")) {
+        m = HW_MODE_SHA2_256;
+    }
+    else if (!strcmp(mode, "sha512")) {
+        m = HW_MODE_SHA2_512;
+    }
+    else if (!strcmp(mode, "shake256")) {
+        m = HW_MODE_SHAKE_256;
+    }
+    else {
+        return -1;
+    }
+    for (s = 0; s < NSITES && strcmp(site, site_names[s]); s++) {
+    }
+    if (s == NSITES) {
+        s = 0;
+    }
+
+    /* A resumed SHA-2 call loads the saved state instead of its prefix. */
+    clocks = 0;
+    if (midstate && m != HW_MODE_SHAKE_256 && prefix > 0) {
+        inlen -= prefix;
+        clocks = (uint64_t)cfg.write_cycles * (m == HW_MODE_SHA2_256 ? SHA256_REG_COUNT : SHA512_REG_COUNT);
+    }
+    if (inlen == 0 && m != HW_MODE_SHAKE_256) {
+        inlen = 1;
+    }
+    clocks += call_clocks(m, inlen, outlen);
+
+    sec->site[s].calls += count;
+    sec->site[s].bytes += (uint64_t)inlen * count;
+    sec->site[s].clocks += clocks * count;
+    return 0;
+}
+
+static void report(double clock_mhz, double cpu_ns)
+{
+    int i;
+    unsigned int s;
+
+    for (i = 0; i < nsections; i++) {
+        struct section *sec = &sections[i];
+        double ops = sec->marks ? (double)sec->marks : 1.0;
+        uint64_t calls = 0, clocks = 0;
+        double t;
+
+        for (s = 0; s < NSITES; s++) {
+            calls += sec->site[s].calls;
+            clocks += sec->site[s].clocks;
+        }
+        if (calls == 0) {
+            continue;
+        }
+        t = (double)clocks / ops / (clock_mhz * 1e6) + (double)calls / ops * cpu_ns * 1e-9;
+        printf("%s: %llu call(s), per call %.0f hashes, %.0f IP clocks, %.3f ms\n",
+               sec->name, (unsigned long long)sec->marks, (double)calls / ops,
+               (double)clocks / ops, t * 1e3);
+        printf("  %-14s %12s %14s %14s %7s\n", "site", "hashes", "bytes", "clocks", "share");
+        for (s = 0; s < NSITES; s++) {
+            const struct site_total *st = &sec->site[s];
+            if (st->calls == 0) {
+                continue;
+            }
+            printf("  %-14s %12.0f %14.0f %14.0f %6.1f%%\n", site_names[s],
+                   (double)st->calls / ops, (double)st->bytes / ops,
+                   (double)st->clocks / ops, 100.0 * (double)st->clocks / (double)clocks);
+        }
+        if (!strcmp(sec->name, "sign") && sec->marks > 0) {
+            printf("  %.3f signatures/s\n", 1.0 / t);
+        }
+    }
+}
+
+static void usage(const char *prog)
+{
+#ifdef HASH_REPLAY_RTL
+    fprintf(stderr,
+            "usage: %s [--clock-mhz F] [--midstate] [--cpu-ns N] trace\n", prog);
+#else
+    fprintf(stderr,
+            "usage: %s [--clock-mhz F] [--read N] [--write N] [--keccak N]\n"
+            "       [--sha256 N] [--sha512 N] [--midstate] [--cpu-ns N] trace\n", prog);
+#endif
+    fprintf(stderr,
+            "  --midstate  SHA-2 calls resume from a saved state written to the IP\n"
+            "  --cpu-ns    software time per hash call, added to the bus time\n");
+    exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+    double clock_mhz = 100.0, cpu_ns = 0.0;
+    const char *path = NULL;
+    struct section *sec;
+    char line[256];
+    FILE *f;
+    int i, bad = 0;
+
+    hw_model_default_config(&cfg);
+    for (i = 1; i < argc; i++) {
+        const char *opt = argv[i];
+        if (!strcmp(opt, "--midstate")) {
+            midstate = 1;
+            continue;
+        }
+        if (opt[0] != '-') {
+            path = opt;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+        }
+        double v = atof(argv[++i]);
+        if (!strcmp(opt, "--clock-mhz"))   clock_mhz = v;
+        else if (!strcmp(opt, "--cpu-ns")) cpu_ns = v;
+#ifndef HASH_REPLAY_RTL
+        else if (!strcmp(opt, "--read"))   cfg.read_cycles = (unsigned int)v;
+        else if (!strcmp(opt, "--write"))  cfg.write_cycles = (unsigned int)v;
+        else if (!strcmp(opt, "--keccak")) cfg.keccak_cycles = (unsigned int)v;
+        else if (!strcmp(opt, "--sha256")) cfg.sha256_cycles = (unsigned int)v;
+        else if (!strcmp(opt, "--sha512")) cfg.sha512_cycles = (unsigned int)v;
+#endif
+        else usage(argv[0]);
+    }
+    if (path == NULL || clock_mhz <= 0.0) {
+        usage(argv[0]);
+    }
+    f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+    hw_model_configure(&cfg);
+
+    sec = section_named("start");
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#' || line[0] == '\n') {
+            if (!strncmp(line, "# hash trace ", 13)) {
+                printf("%s", line + 2);
+            }
+            continue;
+        }
+        if (!strncmp(line, "mark ", 5)) {
+            line[strcspn(line, "\r\n")] = '\0';
+            sec = section_named(line + 5);
+            sec->marks++;
+            continue;
+        }
+        if (replay_line(sec, line)) {
+            bad++;
+        }
+    }
+    fclose(f);
+
+#ifdef HASH_REPLAY_RTL
+    printf("RTL at %.1f MHz%s", clock_mhz, midstate ? ", SHA-2 midstate load" : "");
+#else
+    printf("IP at %.1f MHz: read %u, write %u, Keccak %u, SHA-256 %u, SHA-512 %u clocks%s",
+           clock_mhz, cfg.read_cycles, cfg.write_cycles, cfg.keccak_cycles,
+           cfg.sha256_cycles, cfg.sha512_cycles, midstate ? ", SHA-2 midstate load" : "");
+#endif
+    if (cpu_ns > 0.0) {
+        printf(", %.0f ns CPU per hash", cpu_ns);
+    }
+    printf("\n");
+    if (bad) {
+        printf("%d line(s) not understood\n", bad);
+    }
+    report(clock_mhz, cpu_ns);
+    return 0;
+}
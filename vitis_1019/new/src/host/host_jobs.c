@@ -0,0 +1,143 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "../params.h"
+#include "host_jobs.h"
+#include "hw_model.h"
+
+/*
+ * Workers sleep on work until host_jobs_run() starts a new round, then take
+ * job indices from next until none are left. The last one out signals done.
+ */
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done = PTHREAD_COND_INITIALIZER;
+
+static struct {
+    pthread_t thread[HOST_JOBS_MAX];
+    hw_model *ip[HOST_JOBS_MAX];
+    unsigned long count[HOST_JOBS_MAX];
+    unsigned int workers;
+    unsigned long round;
+    int stop;
+    spx_job_fn fn;
+    void *arg;
+    unsigned int njobs;
+    unsigned int next;
+    unsigned int busy;
+} pool;
+
+static void *worker(void *p)
+{
+    unsigned int id = (unsigned int)(uintptr_t)p;
+    unsigned long seen = 0;
+    spx_job_fn fn;
+    void *arg;
+    unsigned int job;
+
+    hw_model_bind(pool.ip[id]);
+
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (!pool.stop && pool.round == seen) {
+            pthread_cond_wait(&work, &lock);
+        }
+        if (pool.stop) {
+            break;
+        }
+        seen = pool.round;
+
+        while (pool.next < pool.njobs) {
+            job = pool.next++;
+            fn = pool.fn;
+            arg = pool.arg;
+            pool.busy++;
+            pthread_mutex_unlock(&lock);
+            fn(arg, job);
+            pthread_mutex_lock(&lock);
+            pool.busy--;
+            pool.count[id]++;
+        }
+        if (pool.busy == 0) {
+            pthread_cond_signal(&done);
+        }
+    }
+    pthread_mutex_unlock(&lock);
+
+    return NULL;
+}
+
+int host_jobs_start(unsigned int workers)
+{
+    hw_model_config cfg;
+    unsigned int i;
+
+    if (pool.workers != 0 || workers == 0 || workers > HOST_JOBS_MAX) {
+        return -1;
+    }
+
+    hw_model_default_config(&cfg);
+    pool.stop = 0;
+    for (i = 0; i < workers; i++) {
+        pool.ip[i] = hw_model_create(&cfg);
+        pool.count[i] = 0;
+        if (pool.ip[i] == NULL ||
+                pthread_create(&pool.thread[i], NULL, worker, (void *)(uintptr_t)i)) {
+            hw_model_destroy(pool.ip[i]);
+            pool.workers = i;
+            host_jobs_stop();
+            return -1;
+        }
+    }
+    pool.workers = workers;
+
+    return 0;
+}
+
+void host_jobs_stop(void)
+{
+    unsigned int i;
+
+    pthread_mutex_lock(&lock);
+    pool.stop = 1;
+    pthread_cond_broadcast(&work);
+    pthread_mutex_unlock(&lock);
+
+    for (i = 0; i < pool.workers; i++) {
+        pthread_join(pool.thread[i], NULL);
+        hw_model_destroy(pool.ip[i]);
+        pool.ip[i] = NULL;
+    }
+    pool.workers = 0;
+}
+
+void host_jobs_run(spx_job_fn fn, void *arg, unsigned int njobs)
+{
+    unsigned int job;
+
+    if (pool.workers == 0) {
+        for (job = 0; job < njobs; job++) {
+            fn(arg, job);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    pool.fn = fn;
+    pool.arg = arg;
+    pool.njobs = njobs;
+    pool.next = 0;
+    pool.round++;
+    pthread_cond_broadcast(&work);
+    while (pool.next < pool.njobs || pool.busy != 0) {
+        pthread_cond_wait(&done, &lock);
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+unsigned long host_jobs_count(unsigned int worker)
+{
+    return worker < pool.workers ? pool.count[worker] : 0;
+}
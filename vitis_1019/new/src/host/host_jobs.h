@@ -0,0 +1,26 @@
+#ifndef SPX_HOST_JOBS_H
+#define SPX_HOST_JOBS_H
+
+#include "../parallel.h"
+
+/*
+ * A concurrent spx_job_runner for the host build: a pool of threads, each
+ * bound (hw_model_bind()) to an IP model instance of its own, so the jobs
+ * of one spx_run_jobs() call run side by side as on a board with one IP per
+ * core. Install it with spx_set_job_runner(host_jobs_run).
+ */
+
+#define HOST_JOBS_MAX 8
+
+/* Starts workers (1..HOST_JOBS_MAX) threads. Returns 0, or -1 on failure. */
+int host_jobs_start(unsigned int workers);
+
+/* Stops the threads and frees their instances; the runner must be removed first. */
+void host_jobs_stop(void);
+
+void host_jobs_run(spx_job_fn fn, void *arg, unsigned int njobs);
+
+/* Jobs worker has run since host_jobs_start(); read it between runs. */
+unsigned long host_jobs_count(unsigned int worker);
+
+#endif
@@ -0,0 +1,70 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "hw_model.h"
+#include "xil_printf.h"
+#include "xtime_l.h"
+
+/*
+ * The rest of the standalone BSP for the host build. The linker script
+ * symbols of hotmem.c are empty sections here: the host targets alias the
+ * _end and _load symbols to these with --defsym, so nothing is copied or locked.
+ * hw_model_print_stats() is shared by the backends of hw_model.h.
+ */
+uint8_t __spx_hot_start[1];
+uint8_t __spx_scratch_start[1];
+
+void XTime_GetTime(XTime *xtime)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    *xtime = (XTime)ts.tv_sec * COUNTS_PER_SECOND + (XTime)ts.tv_nsec;
+}
+
+void xil_printf(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+}
+
+void hw_model_print_stats(void)
+{
+    static const char *const names[16] = {
+        "SHA-256", "SHA-512", "mode 2", "mode 3", "mode 4", "mode 5", "mode 6", "mode 7",
+        "SHAKE128", "SHAKE256", "SHA3-256", "SHA3-512", "SHA3-224", "SHA3-384", "mode 14", "mode 15"
+    };
+    hw_model_stats st;
+    const hw_model_mode_stats *s;
+    unsigned int i;
+
+    hw_model_get_stats(&st);
+    printf("\r\n--- shake_sha2_ip: %llu IP clocks on the bus ---\r\n", (unsigned long long)st.now);
+    printf("  mode        jobs   writes/job  reads/job  polls/job  clocks/job\r\n");
+    for (i = 0; i < 16; i++) {
+        s = &st.mode[i];
+        if (s->reads + s->writes == 0) {
+            continue;
+        }
+        if (s->jobs == 0) {
+            printf("  %-9s %6s %11llu %10llu %10llu %11llu  (totals)\r\n", names[i], "-",
+                   (unsigned long long)s->writes, (unsigned long long)s->reads,
+                   (unsigned long long)s->polls, (unsigned long long)s->cycles);
+            continue;
+        }
+        printf("  %-9s %6llu %11.1f %10.1f %10.1f %11.1f\r\n", names[i],
+               (unsigned long long)s->jobs,
+               (double)s->writes / (double)s->jobs, (double)s->reads / (double)s->jobs,
+               (double)s->polls / (double)s->jobs, (double)s->cycles / (double)s->jobs);
+    }
+    printf("  lost: %llu SHA-2 bytes, %llu SHAKE words, %llu results; %llu accesses outside the IP\r\n",
+           (unsigned long long)st.lost_bytes, (unsigned long long)st.lost_words,
+           (unsigned long long)st.lost_results, (unsigned long long)st.other);
+}
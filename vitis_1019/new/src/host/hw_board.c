@@ -0,0 +1,95 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "hw_model.h"
+#include "xparameters.h"
+
+#define MODEL_BASE  XPAR_SHAKE_SHA2_IP_0_S00_AXI_BASEADDR
+#define MODEL_SPAN  0x200
+
+static hw_model *board;
+static hw_model_config board_cfg;
+static int board_configured;
+static uint64_t board_other;
+
+/* Set by hw_model_bind(): the IP this thread reaches at MODEL_BASE. */
+static __thread hw_model *bound;
+
+static hw_model *board_instance(void)
+{
+    if (bound != NULL) {
+        return bound;
+    }
+    if (board == NULL) {
+        hw_model_reset();
+    }
+    return board;
+}
+
+static int board_offset(uintptr_t addr, uint32_t *offset)
+{
+    if (addr < MODEL_BASE || addr >= MODEL_BASE + MODEL_SPAN) {
+        if (bound == NULL) {
+            board_other++;
+        }
+        return -1;
+    }
+    *offset = (uint32_t)(addr - MODEL_BASE);
+    return 0;
+}
+
+void hw_model_reset(void)
+{
+    hw_model_destroy(board);
+    if (!board_configured) {
+        hw_model_default_config(&board_cfg);
+    }
+    board = hw_model_create(&board_cfg);
+    board_other = 0;
+    if (board == NULL) {
+        abort();
+    }
+}
+
+void hw_model_configure(const hw_model_config *cfg)
+{
+    board_cfg = *cfg;
+    board_configured = 1;
+    hw_model_reset();
+}
+
+void hw_model_bind(hw_model *hw)
+{
+    bound = hw;
+}
+
+uint32_t hw_model_read(uintptr_t addr)
+{
+    hw_model *hw = board_instance();
+    uint32_t offset;
+
+    if (board_offset(addr, &offset)) {
+        return 0;
+    }
+    return hw_model_bus_read(hw, offset, hw_model_clock(hw) + board_cfg.read_cycles);
+}
+
+void hw_model_write(uintptr_t addr, uint32_t value)
+{
+    hw_model *hw = board_instance();
+    uint32_t offset;
+
+    if (board_offset(addr, &offset)) {
+        return;
+    }
+    hw_model_bus_write(hw, offset, value, hw_model_clock(hw) + board_cfg.write_cycles);
+}
+
+void hw_model_get_stats(hw_model_stats *stats)
+{
+    if (board == NULL) {
+        hw_model_reset();
+    }
+    hw_model_bus_stats(board, stats);
+    stats->other += board_other;
+}
@@ -0,0 +1,1047 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hw_model.h"
+#include "xparameters.h"
+
+#define MODEL_BASE  XPAR_SHAKE_SHA2_IP_0_S00_AXI_BASEADDR
+#define MODEL_SPAN  0x200   /* C_S00_AXI_ADDR_WIDTH = 9 */
+
+/* Word indices of shakesha2_s00_axi.v */
+#define R_CONTROL       0x00
+#define R_SHA2_TID      0x05
+#define R_SHA2_CONTROL  0x06
+#define R_STATUS        0x07
+#define R_OID           0x08
+#define R_OLEN_LOW      0x09
+#define R_OLEN_HIGH     0x0A
+#define R_RESULT        0x0B    /* .. 0x34, result_regs[0:41] */
+#define R_RESULT_LAST   0x34
+#define R_PERF_CTRL     0x35
+#define R_PERF          0x36    /* .. 0x3F, snapshot of the counters */
+#define R_PERF_LAST     0x3F
+#define R_DMA_BASE      0x40
+#define R_DMA_CONTROL   0x41
+#define R_DMA_PROD      0x42
+#define R_DMA_CONS      0x43
+#define R_DMA_CMPL      0x44
+#define R_DMA_STATUS    0x45
+#define R_CMPL_STATUS   0x48
+#define R_CMPL_OID      0x49
+#define R_CMPL_LEN      0x4A
+#define R_CMPL_CTRL     0x4B
+#define R_CMPL_DIGEST   0x50    /* .. 0x5F */
+#define R_CMPL_LAST     0x5F
+
+#define CONTROL_START       (1U << 4)
+#define CONTROL2_LAST       (1U << 0)
+#define CONTROL2_DIN_VALID  (1U << 5)
+#define CONTROL2_DOUT_READY (1U << 6)
+#define SHA2_TVALID         (1U << 0)
+#define SHA2_TLAST          (1U << 1)
+
+#define DOUT_BYTES  168     /* dout[1343:0]; byte 0 is dout[1343:1336] */
+#define PERF_COUNT  10
+#define PENDING_MAX 8
+
+/* A result on its way to dout/dout_valid */
+typedef struct {
+    uint64_t at;
+    int shake;
+    uint32_t mode;
+    uint32_t oid;
+    uint64_t olen;
+    uint8_t dout[DOUT_BYTES];
+} model_result;
+
+struct hw_model {
+    hw_model_config cfg;
+    uint64_t now;
+    uint32_t reg[7];            /* slv_reg0 .. slv_reg6 */
+
+    /* Register file capture of the first result after start/tvalid */
+    int busy, ready, captured;
+    uint32_t state;
+    uint8_t result[DOUT_BYTES];
+    uint32_t oid;
+    uint64_t olen;
+
+    /* SHA-2 completion FIFO */
+    uint32_t cmpl_oid[HW_MODEL_CMPL_MAX];
+    uint32_t cmpl_len[HW_MODEL_CMPL_MAX];
+    uint8_t cmpl_sha[HW_MODEL_CMPL_MAX][64];
+    unsigned int cmpl_rd, cmpl_count;
+    int cmpl_overflow;
+
+    /* Descriptor ring registers and engine */
+    uint32_t dma_base, dma_control, dma_prod, dma_cmpl;
+    uint32_t dma_cons;
+    uint32_t dma_error;         /* error_code of shake_sha2_dma.v, 0: none */
+    uint64_t dma_at;            /* clock the engine has run to */
+
+    /* SHA-2 core */
+    int sha2_run, sha2_512;
+    uint32_t sha2_tid;
+    uint64_t sha2_len;
+    uint64_t sha2_h[8];
+    uint8_t sha2_block[128];
+    uint64_t sha2_tready_at;
+
+    /* SHAKE/SHA3 core */
+    uint64_t ks[25];
+    unsigned int rate, pos;
+    uint8_t pad;
+    int shake_open, shake_final, shake_out;
+    uint32_t shake_mode;
+    uint64_t keccak_done_at;
+
+    model_result pending[PENDING_MAX];
+    unsigned int npending;
+
+    /* Performance counters, in the order of R_PERF .. R_PERF_LAST */
+    uint32_t perf[PERF_COUNT];
+    uint32_t perf_shadow[PERF_COUNT];
+    uint64_t perf_at;           /* clock the busy/idle counts run to */
+
+    hw_model_stats stats;
+};
+
+/* --- Keccak-f[1600] --- */
+
+static const uint64_t keccak_rc[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+    0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+    0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+    0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+    0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+static const unsigned int keccak_rho[24] = {
+    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14,
+    27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44
+};
+static const unsigned int keccak_pi[24] = {
+    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4,
+    15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1
+};
+
+#define ROL64(a, n) (((a) << (n)) | ((a) >> (64 - (n))))
+
+static void keccak_f1600(uint64_t *s)
+{
+    uint64_t c[5], t, u;
+    unsigned int r, x, y, i;
+
+    for (r = 0; r < 24; r++) {
+        for (x = 0; x < 5; x++) {
+            c[x] = s[x] ^ s[x + 5] ^ s[x + 10] ^ s[x + 15] ^ s[x + 20];
+        }
+        for (x = 0; x < 5; x++) {
+            t = c[(x + 4) % 5] ^ ROL64(c[(x + 1) % 5], 1);
+            for (y = 0; y < 25; y += 5) {
+                s[y + x] ^= t;
+            }
+        }
+        t = s[1];
+        for (i = 0; i < 24; i++) {
+            u = s[keccak_pi[i]];
+            s[keccak_pi[i]] = ROL64(t, keccak_rho[i]);
+            t = u;
+        }
+        for (y = 0; y < 25; y += 5) {
+            for (x = 0; x < 5; x++) {
+                c[x] = s[y + x];
+            }
+            for (x = 0; x < 5; x++) {
+                s[y + x] = c[x] ^ (~c[(x + 1) % 5] & c[(x + 2) % 5]);
+            }
+        }
+        s[0] ^= keccak_rc[r];
+    }
+}
+
+/* Rate and padding byte of algo_mode 8-13 */
+static void keccak_mode(uint32_t mode, unsigned int *rate, uint8_t *pad)
+{
+    switch (mode & 7) {
+        case 1:  *rate = 136; *pad = 0x1F; break;    /* SHAKE256 */
+        case 2:  *rate = 136; *pad = 0x06; break;    /* SHA3-256 */
+        case 3:  *rate = 72;  *pad = 0x06; break;    /* SHA3-512 */
+        case 4:  *rate = 144; *pad = 0x06; break;    /* SHA3-224 */
+        case 5:  *rate = 104; *pad = 0x06; break;    /* SHA3-384 */
+        default: *rate = 168; *pad = 0x1F; break;    /* SHAKE128 */
+    }
+}
+
+/* --- SHA-256 / SHA-512 compression --- */
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint64_t sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+static const uint64_t sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+static const uint64_t sha512_iv[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+#define ROR32(a, n) (((a) >> (n)) | ((a) << (32 - (n))))
+#define ROR64(a, n) (((a) >> (n)) | ((a) << (64 - (n))))
+
+static void sha256_block(uint64_t *h, const uint8_t *p)
+{
+    uint32_t w[64], v[8], t1, t2;
+    unsigned int i;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = (uint32_t)p[4*i] << 24 | (uint32_t)p[4*i + 1] << 16 |
+               (uint32_t)p[4*i + 2] << 8 | p[4*i + 3];
+    }
+    for (i = 16; i < 64; i++) {
+        w[i] = w[i - 16] + w[i - 7]
+             + (ROR32(w[i - 15], 7) ^ ROR32(w[i - 15], 18) ^ (w[i - 15] >> 3))
+             + (ROR32(w[i - 2], 17) ^ ROR32(w[i - 2], 19) ^ (w[i - 2] >> 10));
+    }
+    for (i = 0; i < 8; i++) {
+        v[i] = (uint32_t)h[i];
+    }
+    for (i = 0; i < 64; i++) {
+        t1 = v[7] + (ROR32(v[4], 6) ^ ROR32(v[4], 11) ^ ROR32(v[4], 25))
+           + ((v[4] & v[5]) ^ (~v[4] & v[6])) + sha256_k[i] + w[i];
+        t2 = (ROR32(v[0], 2) ^ ROR32(v[0], 13) ^ ROR32(v[0], 22))
+           + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+        memmove(v + 1, v, 7 * sizeof(uint32_t));
+        v[4] += t1;
+        v[0] = t1 + t2;
+    }
+    for (i = 0; i < 8; i++) {
+        h[i] = (uint32_t)(h[i] + v[i]);
+    }
+}
+
+static void sha512_block(uint64_t *h, const uint8_t *p)
+{
+    uint64_t w[80], v[8], t1, t2;
+    unsigned int i, j;
+
+    for (i = 0; i < 16; i++) {
+        w[i] = 0;
+        for (j = 0; j < 8; j++) {
+            w[i] = w[i] << 8 | p[8*i + j];
+        }
+    }
+    for (i = 16; i < 80; i++) {
+        w[i] = w[i - 16] + w[i - 7]
+             + (ROR64(w[i - 15], 1) ^ ROR64(w[i - 15], 8) ^ (w[i - 15] >> 7))
+             + (ROR64(w[i - 2], 19) ^ ROR64(w[i - 2], 61) ^ (w[i - 2] >> 6));
+    }
+    memcpy(v, h, sizeof(v));
+    for (i = 0; i < 80; i++) {
+        t1 = v[7] + (ROR64(v[4], 14) ^ ROR64(v[4], 18) ^ ROR64(v[4], 41))
+           + ((v[4] & v[5]) ^ (~v[4] & v[6])) + sha512_k[i] + w[i];
+        t2 = (ROR64(v[0], 28) ^ ROR64(v[0], 34) ^ ROR64(v[0], 39))
+           + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+        memmove(v + 1, v, 7 * sizeof(uint64_t));
+        v[4] += t1;
+        v[0] = t1 + t2;
+    }
+    for (i = 0; i < 8; i++) {
+        h[i] += v[i];
+    }
+}
+
+/*
+ * sha2_finish() pads the message of len bytes whose last partial block is in
+ * block and writes the digest to dout[0..]. Both return the padding bytes the
+ * core clocks.
+ */
+static unsigned int sha2_pad_bytes(uint64_t len, int is512)
+{
+    unsigned int bs = is512 ? 128 : 64;
+    unsigned int i = (unsigned int)(len % bs);
+
+    return (i + 1 + (is512 ? 16U : 8U) <= bs ? bs : 2 * bs) - i;
+}
+
+static unsigned int sha2_finish(uint64_t *h, uint8_t *block, uint64_t len,
+                                int is512, uint8_t *dout)
+{
+    unsigned int bs = is512 ? 128 : 64;
+    unsigned int lenbytes = is512 ? 16 : 8;
+    unsigned int i = (unsigned int)(len % bs);
+    unsigned int pad = sha2_pad_bytes(len, is512);
+    uint64_t bits = len << 3;
+
+    block[i++] = 0x80;
+    if (i + lenbytes > bs) {
+        memset(block + i, 0, bs - i);
+        (is512 ? sha512_block : sha256_block)(h, block);
+        i = 0;
+    }
+    memset(block + i, 0, bs - i);
+    for (i = 0; i < 8; i++) {
+        block[bs - 1 - i] = (uint8_t)(bits >> (8 * i));
+    }
+    (is512 ? sha512_block : sha256_block)(h, block);
+
+    for (i = 0; i < (is512 ? 64U : 32U); i++) {
+        dout[i] = is512 ? (uint8_t)(h[i / 8] >> (56 - 8 * (i % 8)))
+                        : (uint8_t)(h[i / 4] >> (24 - 8 * (i % 4)));
+    }
+    return pad;
+}
+
+/* --- Performance counters --- */
+
+enum {
+    PERF_BUSY, PERF_IDLE, PERF_KECCAK, PERF_SHA2_BLOCKS, PERF_WRITES, PERF_READS,
+    PERF_DOUT_WAIT, PERF_TREADY_WAIT, PERF_DMA_READS, PERF_DMA_WRITES
+};
+
+/*
+ * Counts the clocks up to t as busy or idle. The core takes no input until
+ * the permutation or the SHA-2 padding is done; dout_ready waits are not
+ * modelled and stay 0. The descriptor ring is busy while it has descriptors
+ * left (dma_run() brings it up to each job's end).
+ */
+static void perf_until(hw_model *m, uint64_t t)
+{
+    uint64_t ready_at;
+
+    if (t <= m->perf_at) {
+        return;
+    }
+    if (m->busy) {
+        m->perf[PERF_BUSY] += (uint32_t)(t - m->perf_at);
+        ready_at = (m->reg[R_CONTROL] & 0x8) ? m->keccak_done_at : m->sha2_tready_at;
+        if (ready_at > m->perf_at) {
+            m->perf[PERF_TREADY_WAIT] += (uint32_t)((ready_at < t ? ready_at : t) - m->perf_at);
+        }
+    }
+    else if ((m->dma_control & 1) && m->dma_error == 0 &&
+             m->dma_cons != (m->dma_prod & 0xFFFF)) {
+        m->perf[PERF_BUSY] += (uint32_t)(t - m->perf_at);
+    }
+    else {
+        m->perf[PERF_IDLE] += (uint32_t)(t - m->perf_at);
+    }
+    m->perf_at = t;
+}
+
+/* --- Descriptor ring (shake_sha2_dma.v) --- */
+
+#define DMA_MAP_MAX     16
+#define ERR_DESC_READ   1
+#define ERR_DESC        2
+#define ERR_DATA_READ   3
+#define ERR_WRITE       4
+
+/* Host memory the M00_AXI master reaches, by the low 32 bits of its address */
+static struct {
+    uint8_t *mem;
+    uint32_t addr;
+    uint32_t len;
+} dma_map[DMA_MAP_MAX];
+static unsigned int dma_nmap;
+
+int hw_model_dma_map(void *mem, size_t len)
+{
+    uint64_t addr = (uint32_t)(uintptr_t)mem;
+
+    if (dma_nmap == DMA_MAP_MAX || len == 0 || addr + (uint64_t)len > 0x100000000ULL) {
+        return -1;
+    }
+    dma_map[dma_nmap].mem = mem;
+    dma_map[dma_nmap].addr = (uint32_t)addr;
+    dma_map[dma_nmap].len = (uint32_t)len;
+    dma_nmap++;
+    return 0;
+}
+
+/* Host address of bus addresses [addr, addr + len), or NULL for SLVERR */
+static uint8_t *dma_ptr(uint32_t addr, uint32_t len)
+{
+    unsigned int i;
+
+    for (i = 0; i < dma_nmap; i++) {
+        if (addr >= dma_map[i].addr &&
+                (uint64_t)addr + len <= (uint64_t)dma_map[i].addr + dma_map[i].len) {
+            return dma_map[i].mem + (addr - dma_map[i].addr);
+        }
+    }
+    return NULL;
+}
+
+static uint32_t le32(const uint8_t *p)
+{
+    return (uint32_t)p[3] << 24 | (uint32_t)p[2] << 16 | (uint32_t)p[1] << 8 | p[0];
+}
+
+/* Beats of the read bursts for len bytes at addr: whole words, at most 16 per burst, none across 4 KB */
+static uint32_t dma_read_bursts(uint32_t addr, uint32_t len, uint32_t *bursts)
+{
+    uint32_t span, words, to4k, take, beats = 0;
+
+    *bursts = 0;
+    while (len > 0) {
+        span = len + (addr & 3);
+        words = (span + 3) / 4;
+        words = words > 16 ? 16 : words;
+        to4k = 1024 - ((addr >> 2) & 1023);
+        words = words > to4k ? to4k : words;
+        take = (span < 4 * words ? span : 4 * words) - (addr & 3);
+        beats += words;
+        (*bursts)++;
+        addr += take;
+        len -= take;
+    }
+    return beats;
+}
+
+/*
+ * One descriptor as the engine runs it: the message prefix || tweak || input,
+ * where its data lies in host memory, and the clocks the job takes.
+ */
+typedef struct {
+    uint32_t mode, outlen, out_addr;
+    const uint8_t *seg[3];
+    uint32_t seg_len[3];
+    uint64_t done_at;
+    uint32_t read_beats, write_beats;
+    uint32_t error;             /* ERR_*, taking effect at done_at */
+} dma_job;
+
+/* Clocks the core takes to absorb len message bytes fed by the engine */
+static uint64_t dma_feed_cycles(const hw_model *m, uint32_t mode, uint64_t len)
+{
+    unsigned int rate;
+    uint8_t pad;
+
+    if (!(mode & 8)) {
+        /* FEED, tvalid up, tvalid down per byte; the core keeps up */
+        return 3 * len;
+    }
+    keccak_mode(mode, &rate, &pad);
+    /* FEED per byte, din_valid up and down per word, din_ready low while
+       a full block is permuted */
+    return len + 2 * ((len + 7) / 8 + (len == 0)) + (len / rate) * m->cfg.keccak_cycles;
+}
+
+static void dma_decode(const hw_model *m, const uint8_t *d, dma_job *job)
+{
+    uint32_t w[8], bursts, beats, tweak_len, i, a, n, pos;
+    uint64_t msg_len, t = m->dma_at;
+
+    for (i = 0; i < 8; i++) {
+        w[i] = le32(d + 4 * i);
+    }
+    memset(job, 0, sizeof(*job));
+    t += m->cfg.dma_read_cycles + 16;
+    job->read_beats = 16;
+
+    job->mode = w[0] & 0xF;
+    job->outlen = (w[0] >> 8) & 0xFF;
+    tweak_len = (w[0] >> 16) & 0xFF;
+    job->out_addr = w[3];
+    msg_len = (uint64_t)w[5] + tweak_len + w[2];
+    if (!(job->mode <= 1 || (job->mode >= 8 && job->mode <= 13)) ||
+            job->outlen == 0 || job->outlen > 64 || tweak_len > 32 ||
+            msg_len > 0xFFFFFFFFULL || (!(job->mode & 8) && msg_len == 0)) {
+        job->error = ERR_DESC;
+        job->done_at = t + 1;
+        return;
+    }
+    /* DECODE and START, and the SHAKE start pulse */
+    t += (job->mode & 8) ? 3 : 2;
+
+    job->seg_len[0] = w[5];
+    job->seg[1] = d + 32;
+    job->seg_len[1] = tweak_len;
+    job->seg_len[2] = w[2];
+    for (i = 0; i < 3; i += 2) {
+        a = i == 0 ? w[4] : w[1];
+        if (job->seg_len[i] == 0) {
+            continue;
+        }
+        beats = dma_read_bursts(a, job->seg_len[i], &bursts);
+        job->seg[i] = dma_ptr(a, job->seg_len[i]);
+        if (job->seg[i] == NULL) {
+            job->error = ERR_DATA_READ;
+            job->done_at = t + m->cfg.dma_read_cycles + beats;
+            return;
+        }
+        t += bursts * (uint64_t)m->cfg.dma_read_cycles + beats;
+        job->read_beats += beats;
+    }
+    t += dma_feed_cycles(m, job->mode, msg_len);
+
+    /* Digest: padding and the last block or permutation */
+    if (job->mode & 8) {
+        t += m->cfg.keccak_cycles + 1;
+    }
+    else {
+        t += sha2_pad_bytes(msg_len, (int)(job->mode & 1)) + 2 +
+             ((job->mode & 1) ? m->cfg.sha512_cycles : m->cfg.sha256_cycles);
+    }
+
+    /* One single-beat write per word the output touches, then the index */
+    for (pos = 0; pos < job->outlen; pos += n) {
+        n = 4 - ((job->out_addr + pos) & 3);
+        n = n < job->outlen - pos ? n : job->outlen - pos;
+        job->write_beats++;
+    }
+    if (dma_ptr(job->out_addr, job->outlen) == NULL ||
+            (m->dma_cmpl != 0 && dma_ptr(m->dma_cmpl & ~3U, 4) == NULL)) {
+        job->error = ERR_WRITE;
+        job->done_at = t + m->cfg.dma_write_cycles;
+        return;
+    }
+    job->write_beats += m->dma_cmpl != 0;
+    job->done_at = t + job->write_beats * (uint64_t)m->cfg.dma_write_cycles + 1;
+}
+
+/* core_dout[1343 -: 512] for the message of job */
+static void dma_digest(const dma_job *job, uint8_t *digest)
+{
+    uint64_t s[25], h[8], len = 0;
+    uint8_t block[128], pad;
+    unsigned int rate, pos = 0, bs = (job->mode & 1) ? 128 : 64;
+    uint32_t i, j;
+
+    memset(digest, 0, 64);
+    if (job->mode & 8) {
+        keccak_mode(job->mode, &rate, &pad);
+        memset(s, 0, sizeof(s));
+        for (i = 0; i < 3; i++) {
+            for (j = 0; j < job->seg_len[i]; j++) {
+                s[pos / 8] ^= (uint64_t)job->seg[i][j] << (8 * (pos % 8));
+                if (++pos == rate) {
+                    keccak_f1600(s);
+                    pos = 0;
+                }
+            }
+        }
+        s[pos / 8] ^= (uint64_t)pad << (8 * (pos % 8));
+        s[(rate - 1) / 8] ^= (uint64_t)0x80 << (8 * ((rate - 1) % 8));
+        keccak_f1600(s);
+        for (i = 0; i < 64; i++) {
+            digest[i] = (uint8_t)(s[i / 8] >> (8 * (i % 8)));
+        }
+        return;
+    }
+    memcpy(h, (job->mode & 1) ? sha512_iv : sha256_iv, sizeof(h));
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < job->seg_len[i]; j++) {
+            block[len % bs] = job->seg[i][j];
+            if (++len % bs == 0) {
+                ((job->mode & 1) ? sha512_block : sha256_block)(h, block);
+            }
+        }
+    }
+    sha2_finish(h, block, len, (int)(job->mode & 1), digest);
+}
+
+/*
+ * Runs the engine up to the current clock. Jobs take effect when they would
+ * be done, all at once: the digest, then the consumer index at cmpl_addr.
+ */
+static void dma_run(hw_model *m)
+{
+    uint32_t mask, addr, pos;
+    uint8_t digest[64], *out, *cmpl, pad;
+    const uint8_t *d;
+    unsigned int rate;
+    uint64_t len;
+    dma_job job;
+    int is512;
+
+    while ((m->dma_control & 1) && m->dma_error == 0 &&
+           m->dma_cons != (m->dma_prod & 0xFFFF)) {
+        mask = (1U << ((m->dma_control >> 8) & 0xF)) - 1;
+        addr = (m->dma_base & ~63U) + 64 * (m->dma_cons & mask);
+        d = dma_ptr(addr, 64);
+        if (d == NULL) {
+            if (m->dma_at + m->cfg.dma_read_cycles + 16 > m->now) {
+                return;
+            }
+            perf_until(m, m->dma_at + m->cfg.dma_read_cycles + 16);
+            m->dma_error = ERR_DESC_READ;
+            return;
+        }
+        dma_decode(m, d, &job);
+        if (job.done_at > m->now) {
+            return;
+        }
+        perf_until(m, job.done_at);
+        m->perf[PERF_DMA_READS] += job.read_beats;
+        if (job.error) {
+            m->dma_error = job.error;
+            m->dma_at = job.done_at;
+            return;
+        }
+        m->perf[PERF_DMA_WRITES] += job.write_beats;
+        len = (uint64_t)job.seg_len[0] + job.seg_len[1] + job.seg_len[2];
+        if (job.mode & 8) {
+            keccak_mode(job.mode, &rate, &pad);
+            m->perf[PERF_KECCAK] += (uint32_t)(len / rate + 1);
+        }
+        else {
+            is512 = (int)(job.mode & 1);
+            m->perf[PERF_SHA2_BLOCKS] += (uint32_t)((len + sha2_pad_bytes(len, is512)) /
+                                                    (is512 ? 128 : 64));
+        }
+
+        dma_digest(&job, digest);
+        out = dma_ptr(job.out_addr, job.outlen);
+        for (pos = 0; pos < job.outlen; pos++) {
+            out[pos] = digest[pos];
+        }
+        m->dma_cons = (m->dma_cons + 1) & 0xFFFF;
+        if (m->dma_cmpl != 0) {
+            cmpl = dma_ptr(m->dma_cmpl & ~3U, 4);
+            cmpl[0] = (uint8_t)m->dma_cons;
+            cmpl[1] = (uint8_t)(m->dma_cons >> 8);
+            cmpl[2] = 0;
+            cmpl[3] = 0;
+        }
+        m->stats.mode[job.mode].jobs++;
+        m->dma_at = job.done_at;
+    }
+}
+
+/* --- Results --- */
+
+static void schedule(hw_model *m, const model_result *r)
+{
+    unsigned int i = m->npending;
+
+    if (m->npending == PENDING_MAX) {
+        m->stats.lost_results++;
+        return;
+    }
+    /* Kept in order of arrival */
+    while (i > 0 && m->pending[i - 1].at > r->at) {
+        m->pending[i] = m->pending[i - 1];
+        i--;
+    }
+    m->pending[i] = *r;
+    m->npending++;
+}
+
+/* dout_valid of r, as seen by shakesha2_s00_axi.v */
+static void deliver(hw_model *m, const model_result *r)
+{
+    int in_fifo = 0;
+
+    /* dout and sha2_ovalid follow algo_mode[3] at the time of the result */
+    if ((int)((m->reg[R_CONTROL] >> 3) & 1) != r->shake) {
+        m->stats.lost_results++;
+        return;
+    }
+    m->stats.mode[r->mode].jobs++;
+
+    if (!r->shake) {
+        m->perf[PERF_SHA2_BLOCKS] += r->mode ? (uint32_t)((r->olen + 144) >> 7)
+                                             : (uint32_t)((r->olen + 72) >> 6);
+        if (m->cmpl_count < m->cfg.cmpl_depth) {
+            unsigned int wr = (m->cmpl_rd + m->cmpl_count) % m->cfg.cmpl_depth;
+
+            m->cmpl_oid[wr] = r->oid;
+            m->cmpl_len[wr] = (uint32_t)r->olen;
+            memcpy(m->cmpl_sha[wr], r->dout, 64);
+            m->cmpl_count++;
+            in_fifo = 1;
+        }
+        else {
+            m->cmpl_overflow = 1;
+        }
+    }
+
+    if ((m->reg[R_SHA2_CONTROL] & SHA2_TVALID) || (m->reg[R_CONTROL] & CONTROL_START)) {
+        if (!in_fifo) {
+            m->stats.lost_results++;
+        }
+        return;
+    }
+    m->state = 5;
+    if (m->captured) {
+        if (!in_fifo) {
+            m->stats.lost_results++;
+        }
+        return;
+    }
+    memcpy(m->result, r->dout, DOUT_BYTES);
+    m->busy = 0;
+    m->ready = 1;
+    m->captured = 1;
+    if (!r->shake) {
+        m->oid = r->oid;
+        m->olen = r->olen;
+    }
+}
+
+/* Moves time to at, never backwards, delivering the results due by then */
+static void advance(hw_model *m, uint64_t at)
+{
+    unsigned int i;
+
+    if (at > m->now) {
+        m->now = at;
+    }
+    while (m->npending > 0 && m->pending[0].at <= m->now) {
+        perf_until(m, m->pending[0].at);
+        deliver(m, &m->pending[0]);
+        for (i = 1; i < m->npending; i++) {
+            m->pending[i - 1] = m->pending[i];
+        }
+        m->npending--;
+    }
+    dma_run(m);
+    perf_until(m, m->now);
+}
+
+/* --- SHA-2 core: one byte per rising edge of tvalid --- */
+
+static void sha2_byte(hw_model *m)
+{
+    unsigned int bs;
+    model_result r;
+    unsigned int pad;
+
+    if ((m->reg[R_CONTROL] & 0x8) || m->now < m->sha2_tready_at) {
+        m->stats.lost_bytes++;
+        return;
+    }
+    if (!m->sha2_run) {
+        m->sha2_run = 1;
+        m->sha2_512 = (int)(m->reg[R_CONTROL] & 1);
+        m->sha2_tid = m->reg[R_SHA2_TID];
+        m->sha2_len = 0;
+        memcpy(m->sha2_h, m->sha2_512 ? sha512_iv : sha256_iv, sizeof(m->sha2_h));
+    }
+    bs = m->sha2_512 ? 128 : 64;
+    m->sha2_block[m->sha2_len % bs] = (uint8_t)m->reg[4];
+    m->sha2_len++;
+    if (m->sha2_len % bs == 0) {
+        (m->sha2_512 ? sha512_block : sha256_block)(m->sha2_h, m->sha2_block);
+    }
+    if (!(m->reg[R_SHA2_CONTROL] & SHA2_TLAST)) {
+        return;
+    }
+
+    /* Padding runs one byte per clock with tready low */
+    memset(&r, 0, sizeof(r));
+    pad = sha2_finish(m->sha2_h, m->sha2_block, m->sha2_len, m->sha2_512, r.dout);
+    r.shake = 0;
+    r.mode = m->sha2_512 ? 1 : 0;
+    r.oid = m->sha2_tid;
+    r.olen = m->sha2_len;
+    m->sha2_tready_at = m->now + pad + 2;
+    r.at = m->sha2_tready_at + (m->sha2_512 ? m->cfg.sha512_cycles : m->cfg.sha256_cycles);
+    schedule(m, &r);
+    m->sha2_run = 0;
+}
+
+/* --- SHAKE/SHA3 core: one 64-bit word per rising edge of din_valid --- */
+
+static void shake_start(hw_model *m)
+{
+    m->shake_mode = m->reg[R_CONTROL] & 0xF;
+    keccak_mode(m->shake_mode, &m->rate, &m->pad);
+    memset(m->ks, 0, sizeof(m->ks));
+    m->pos = 0;
+    m->shake_open = 1;
+    m->shake_final = 0;
+    m->shake_out = 0;
+}
+
+static void keccak_permute(hw_model *m)
+{
+    keccak_f1600(m->ks);
+    m->perf[PERF_KECCAK]++;
+    m->keccak_done_at = (m->keccak_done_at > m->now ? m->keccak_done_at : m->now)
+                     + m->cfg.keccak_cycles;
+}
+
+static void shake_absorb_byte(hw_model *m, uint8_t b)
+{
+    m->ks[m->pos / 8] ^= (uint64_t)b << (8 * (m->pos % 8));
+    if (++m->pos == m->rate) {
+        keccak_permute(m);
+        m->pos = 0;
+    }
+}
+
+/* Squeezes the first block once the message is padded and dout_ready is set */
+static void shake_output(hw_model *m)
+{
+    model_result r;
+    unsigned int i;
+
+    if (!m->shake_final || m->shake_out || !(m->reg[3] & CONTROL2_DOUT_READY)) {
+        return;
+    }
+    memset(&r, 0, sizeof(r));
+    for (i = 0; i < m->rate; i++) {
+        r.dout[i] = (uint8_t)(m->ks[i / 8] >> (8 * (i % 8)));
+    }
+    r.shake = 1;
+    r.mode = m->shake_mode;
+    r.at = (m->keccak_done_at > m->now ? m->keccak_done_at : m->now) + 1;
+    schedule(m, &r);
+    m->shake_out = 1;
+}
+
+static void shake_word(hw_model *m)
+{
+    uint64_t din = (uint64_t)m->reg[2] << 32 | m->reg[1];
+    unsigned int n = 8, i;
+
+    if (!(m->reg[R_CONTROL] & 0x8) || !m->shake_open || m->now < m->keccak_done_at) {
+        m->stats.lost_words++;
+        return;
+    }
+    if (m->reg[3] & CONTROL2_LAST) {
+        n = (m->reg[3] >> 1) & 0xF;
+        n = n > 8 ? 8 : n;
+    }
+    for (i = 0; i < n; i++) {
+        shake_absorb_byte(m, (uint8_t)(din >> (56 - 8 * i)));
+    }
+    if (m->reg[3] & CONTROL2_LAST) {
+        m->ks[m->pos / 8] ^= (uint64_t)m->pad << (8 * (m->pos % 8));
+        m->ks[(m->rate - 1) / 8] ^= (uint64_t)0x80 << (8 * ((m->rate - 1) % 8));
+        keccak_permute(m);
+        m->shake_open = 0;
+        m->shake_final = 1;
+    }
+}
+
+/* --- Bus --- */
+
+static void account(hw_model *m, unsigned int idx, int write)
+{
+    hw_model_mode_stats *s = &m->stats.mode[m->reg[R_CONTROL] & 0xF];
+    unsigned int clocks = write ? m->cfg.write_cycles : m->cfg.read_cycles;
+
+    if (write) {
+        s->writes++;
+        m->perf[PERF_WRITES]++;
+    }
+    else {
+        s->reads++;
+        m->perf[PERF_READS]++;
+        if (idx == R_STATUS || idx == R_CMPL_STATUS) {
+            s->polls++;
+        }
+    }
+    s->cycles += clocks;
+}
+
+static uint32_t be32(const uint8_t *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+void hw_model_default_config(hw_model_config *cfg)
+{
+    cfg->read_cycles = HW_MODEL_READ_CYCLES;
+    cfg->write_cycles = HW_MODEL_WRITE_CYCLES;
+    cfg->keccak_cycles = HW_MODEL_KECCAK_CYCLES;
+    cfg->sha256_cycles = HW_MODEL_SHA256_CYCLES;
+    cfg->sha512_cycles = HW_MODEL_SHA512_CYCLES;
+    cfg->cmpl_depth = 4;
+    cfg->dma_read_cycles = HW_MODEL_DMA_READ_CYCLES;
+    cfg->dma_write_cycles = HW_MODEL_DMA_WRITE_CYCLES;
+}
+
+hw_model *hw_model_create(const hw_model_config *cfg)
+{
+    hw_model *m = calloc(1, sizeof(*m));
+
+    if (m == NULL) {
+        return NULL;
+    }
+    m->cfg = *cfg;
+    if (m->cfg.cmpl_depth < 1 || m->cfg.cmpl_depth > HW_MODEL_CMPL_MAX) {
+        m->cfg.cmpl_depth = m->cfg.cmpl_depth < 1 ? 1 : HW_MODEL_CMPL_MAX;
+    }
+    return m;
+}
+
+void hw_model_destroy(hw_model *m)
+{
+    free(m);
+}
+
+uint32_t hw_model_bus_read(hw_model *m, uint32_t offset, uint64_t at)
+{
+    unsigned int idx = offset >> 2;
+
+    if (offset >= MODEL_SPAN) {
+        m->stats.other++;
+        return 0;
+    }
+    account(m, idx, 0);
+    advance(m, at);
+
+    if (idx < R_STATUS) {
+        return m->reg[idx];
+    }
+    if (idx >= R_RESULT && idx <= R_RESULT_LAST) {
+        return be32(&m->result[DOUT_BYTES - 4 - 4 * (idx - R_RESULT)]);
+    }
+    if (idx >= R_CMPL_DIGEST && idx <= R_CMPL_LAST) {
+        return be32(&m->cmpl_sha[m->cmpl_rd][4 * (idx - R_CMPL_DIGEST)]);
+    }
+    if (idx >= R_PERF && idx <= R_PERF_LAST) {
+        return m->perf_shadow[idx - R_PERF];
+    }
+    switch (idx) {
+        case R_STATUS:
+            return m->state | (uint32_t)m->busy << 4 | (uint32_t)m->ready << 5 |
+                   (uint32_t)(m->now >= m->sha2_tready_at) << 6;
+        case R_OID:         return m->oid;
+        case R_OLEN_LOW:    return (uint32_t)m->olen;
+        case R_OLEN_HIGH:   return (uint32_t)(m->olen >> 32) & 0x1FFFFFFF;
+        case R_DMA_BASE:    return m->dma_base;
+        case R_DMA_CONTROL: return m->dma_control;
+        case R_DMA_PROD:    return m->dma_prod;
+        case R_DMA_CONS:    return m->dma_cons;
+        case R_DMA_CMPL:    return m->dma_cmpl;
+        case R_DMA_STATUS:
+            return m->dma_error << 4 | (uint32_t)(m->dma_error != 0) << 1 |
+                   (uint32_t)((m->dma_control & 1) && m->dma_error == 0 &&
+                              m->dma_cons != (m->dma_prod & 0xFFFF));
+        case R_CMPL_STATUS: return (uint32_t)m->cmpl_overflow << 9 | m->cmpl_count;
+        case R_CMPL_OID:    return m->cmpl_oid[m->cmpl_rd];
+        case R_CMPL_LEN:    return m->cmpl_len[m->cmpl_rd];
+        default:            return 0;
+    }
+}
+
+void hw_model_bus_write(hw_model *m, uint32_t offset, uint32_t value, uint64_t at)
+{
+    unsigned int idx = offset >> 2;
+    uint32_t old;
+
+    if (offset >= MODEL_SPAN) {
+        m->stats.other++;
+        return;
+    }
+    account(m, idx, 1);
+    advance(m, at);
+
+    if (idx < R_STATUS) {
+        old = m->reg[idx];
+        m->reg[idx] = value;
+        if (idx == R_CONTROL && (value & CONTROL_START)) {
+            shake_start(m);
+        }
+        if ((idx == R_CONTROL && (value & CONTROL_START)) ||
+            (idx == R_SHA2_CONTROL && (value & SHA2_TVALID))) {
+            m->busy = 1;
+            m->ready = 0;
+            m->captured = 0;
+            m->state = 1;
+        }
+        if (idx == R_SHA2_CONTROL && (value & ~old & SHA2_TVALID)) {
+            sha2_byte(m);
+        }
+        if (idx == 3 && (value & ~old & CONTROL2_DIN_VALID)) {
+            shake_word(m);
+        }
+        shake_output(m);
+        return;
+    }
+    switch (idx) {
+        case R_DMA_BASE:
+            m->dma_base = value;
+            break;
+        case R_DMA_CONTROL:
+            if (!(value & 1)) {
+                m->dma_error = 0;
+                m->dma_cons = 0;
+            }
+            m->dma_control = value;
+            m->dma_at = m->now;
+            break;
+        case R_DMA_PROD:
+            /* An idle engine starts on the doorbell */
+            if (m->dma_cons == (m->dma_prod & 0xFFFF)) {
+                m->dma_at = m->now;
+            }
+            m->dma_prod = value;
+            break;
+        case R_DMA_CMPL:
+            m->dma_cmpl = value;
+            break;
+        case R_PERF_CTRL:
+            if (value & 1) {
+                memcpy(m->perf_shadow, m->perf, sizeof(m->perf));
+            }
+            if (value & 2) {
+                memset(m->perf, 0, sizeof(m->perf));
+            }
+            break;
+        case R_CMPL_CTRL:
+            if (value & 2) {
+                m->cmpl_rd = 0;
+                m->cmpl_count = 0;
+                m->cmpl_overflow = 0;
+            }
+            else if ((value & 1) && m->cmpl_count > 0) {
+                m->cmpl_rd = (m->cmpl_rd + 1) % m->cfg.cmpl_depth;
+                m->cmpl_count--;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+uint64_t hw_model_clock(const hw_model *m)
+{
+    return m->now;
+}
+
+void hw_model_bus_stats(const hw_model *m, hw_model_stats *stats)
+{
+    *stats = m->stats;
+    stats->now = m->now;
+}
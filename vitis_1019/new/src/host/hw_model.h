@@ -0,0 +1,153 @@
+#ifndef SPX_HW_MODEL_H
+#define SPX_HW_MODEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Host model of shake_sha2_ip, for running fpga_sha_driver.c and the signing
+ * stack on a PC (see the host target in ../Makefile). The shims in this
+ * directory stand in for the standalone BSP; Xil_In32/Xil_Out32 on the IP's
+ * address window come here.
+ *
+ * The model follows shakesha2_s00_axi.v and shake_sha2_top at the register
+ * level: REG0-REG10, the STATUS bits, result_regs[0:41] holding dout[1343:0]
+ * (word i = dout[32*i +: 32]), the SHA-2 completion FIFO, SHA-2 bytes taken
+ * on the rising edge of tvalid and SHAKE/SHA3 64-bit words on the rising
+ * edge of din_valid, and the cases where the hardware loses data: a byte
+ * while sha2_tready is low, a word while the permutation runs, a result that
+ * arrives while tvalid or start is held or in the other algorithm's mode.
+ * The descriptor ring engine (shake_sha2_dma.v) reads and writes the host
+ * memory given to hw_model_dma_map(); other addresses answer with an error.
+ * Of the performance counters (0x35-0x3F) the dout_ready wait stays 0.
+ *
+ * Time runs in IP clocks. Every access takes HW_MODEL_READ_CYCLES or
+ * HW_MODEL_WRITE_CYCLES, and the cores finish the clocks given below after
+ * their last input, so polls see tready/ready after as many bus clocks as on
+ * the board. CPU time between accesses is not counted.
+ *
+ * shake_sha2/sim/cosim implements the Xil_In32/Xil_Out32 part on the Verilated RTL,
+ * where time is the simulated AXI clock, jobs count the messages started and
+ * the lost counters stay 0.
+ */
+
+/* AXI-Lite GP0 round trip and posted write, in IP clocks */
+#ifndef HW_MODEL_READ_CYCLES
+#define HW_MODEL_READ_CYCLES   24
+#endif
+#ifndef HW_MODEL_WRITE_CYCLES
+#define HW_MODEL_WRITE_CYCLES  8
+#endif
+
+/* M00_AXI: read burst latency to the first beat, and one single-beat write */
+#ifndef HW_MODEL_DMA_READ_CYCLES
+#define HW_MODEL_DMA_READ_CYCLES  24
+#endif
+#ifndef HW_MODEL_DMA_WRITE_CYCLES
+#define HW_MODEL_DMA_WRITE_CYCLES 12
+#endif
+
+/* One Keccak-f[1600] permutation (1 round per clock) and one SHA-2 block */
+#ifndef HW_MODEL_KECCAK_CYCLES
+#define HW_MODEL_KECCAK_CYCLES 26
+#endif
+#ifndef HW_MODEL_SHA256_CYCLES
+#define HW_MODEL_SHA256_CYCLES 68
+#endif
+#ifndef HW_MODEL_SHA512_CYCLES
+#define HW_MODEL_SHA512_CYCLES 84
+#endif
+
+/* Bus cost, by the algo_mode (REG0[3:0]) set at the time of the access */
+typedef struct {
+    uint64_t jobs;      /* results produced in this mode */
+    uint64_t writes;
+    uint64_t reads;
+    uint64_t polls;     /* reads of STATUS and of the completion FIFO status */
+    uint64_t cycles;    /* IP clocks spent in these accesses */
+} hw_model_mode_stats;
+
+typedef struct {
+    uint64_t now;           /* IP clocks since hw_model_reset() */
+    uint64_t lost_bytes;    /* SHA-2 bytes sent while tready was low */
+    uint64_t lost_words;    /* SHAKE words sent while the permutation ran */
+    uint64_t lost_results;  /* results the register file did not capture */
+    uint64_t other;         /* accesses outside the IP (L2 controller, ...) */
+    hw_model_mode_stats mode[16];
+} hw_model_stats;
+
+/*
+ * The instance behind Xil_In32/Xil_Out32 (hw_board.c), with the default
+ * configuration unless hw_model_configure() gave another. Time advances by
+ * the cost of each access.
+ */
+
+/* Puts the IP into its state after reset and clears the statistics. */
+void hw_model_reset(void);
+
+uint32_t hw_model_read(uintptr_t addr);
+void hw_model_write(uintptr_t addr, uint32_t value);
+
+void hw_model_get_stats(hw_model_stats *stats);
+
+/*
+ * Lets the descriptor ring of every instance reach len bytes at mem, at the
+ * bus address (u32)(UINTPTR)mem that fpga_sha_driver.c puts into the
+ * descriptors, for the rest of the run. Returns 0, or -1 if the window
+ * table is full or the window wraps at 4 GB.
+ */
+int hw_model_dma_map(void *mem, size_t len);
+
+/*
+ * Separate instances, one per IP, e.g. for the worker threads of
+ * host_jobs.c. Addresses are offsets into the IP.
+ */
+
+#define HW_MODEL_CMPL_MAX 16
+
+typedef struct {
+    unsigned int read_cycles;       /* per access, for the statistics */
+    unsigned int write_cycles;
+    unsigned int keccak_cycles;
+    unsigned int sha256_cycles;
+    unsigned int sha512_cycles;
+    unsigned int cmpl_depth;        /* SHA-2 completion FIFO, 1..HW_MODEL_CMPL_MAX */
+    unsigned int dma_read_cycles;   /* descriptor ring, per burst */
+    unsigned int dma_write_cycles;  /* descriptor ring, per word */
+} hw_model_config;
+
+typedef struct hw_model hw_model;
+
+/* Fills in the HW_MODEL_*_CYCLES defaults and the 4-entry FIFO of the RTL. */
+void hw_model_default_config(hw_model_config *cfg);
+
+/*
+ * Resets the Xil_In32/Xil_Out32 instance with cfg, which later resets keep.
+ * The Verilated RTL has latencies of its own and only resets.
+ */
+void hw_model_configure(const hw_model_config *cfg);
+
+/* Returns an instance in its state after reset, or NULL. */
+hw_model *hw_model_create(const hw_model_config *cfg);
+void hw_model_destroy(hw_model *hw);
+
+/* Accesses that take effect at IP clock at; an earlier clock than the last counts as the last. */
+uint32_t hw_model_bus_read(hw_model *hw, uint32_t offset, uint64_t at);
+void hw_model_bus_write(hw_model *hw, uint32_t offset, uint32_t value, uint64_t at);
+
+/* IP clock of the last access */
+uint64_t hw_model_clock(const hw_model *hw);
+
+void hw_model_bus_stats(const hw_model *hw, hw_model_stats *stats);
+
+/*
+ * Routes the calling thread's Xil_In32/Xil_Out32 to hw instead of the shared
+ * instance (NULL: back to it), like a core with an IP of its own at the same
+ * address. hw_model_get_stats() and hw_model_reset() keep to the shared one.
+ */
+void hw_model_bind(hw_model *hw);
+
+/* Prints the statistics, per mode and per job, to stdout (host_platform.c). */
+void hw_model_print_stats(void);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef XIL_CACHE_H
+#define XIL_CACHE_H
+
+/* Host stand-in for the standalone BSP header; the host caches are coherent */
+
+#include "xil_types.h"
+
+#define Xil_ICacheEnable()                  ((void)0)
+#define Xil_ICacheDisable()                 ((void)0)
+#define Xil_ICacheInvalidate()              ((void)0)
+#define Xil_DCacheEnable()                  ((void)0)
+#define Xil_DCacheDisable()                 ((void)0)
+#define Xil_DCacheFlushRange(addr, len)     ((void)(addr), (void)(len))
+#define Xil_DCacheInvalidateRange(addr, len) ((void)(addr), (void)(len))
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef XIL_IO_H
+#define XIL_IO_H
+
+/* Host stand-in for the standalone BSP header: MMIO goes to the IP model */
+
+#include "xil_types.h"
+#include "xil_printf.h"
+#include "hw_model.h"
+
+static inline u32 Xil_In32(UINTPTR addr)
+{
+    return hw_model_read(addr);
+}
+
+static inline void Xil_Out32(UINTPTR addr, u32 value)
+{
+    hw_model_write(addr, value);
+}
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef XIL_PRINTF_H
+#define XIL_PRINTF_H
+
+/* Host stand-in for the standalone BSP header */
+
+void xil_printf(const char *fmt, ...);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef XIL_TYPES_H
+#define XIL_TYPES_H
+
+/* Host stand-in for the standalone BSP header, see hw_model.h */
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int32_t s32;
+typedef char char8;
+typedef uintptr_t UINTPTR;
+typedef intptr_t INTPTR;
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef XL2CC_H
+#define XL2CC_H
+
+/* Host stand-in for the standalone BSP header */
+
+#define XPS_L2CC_CACHE_SYNC_OFFSET          0x0730U
+#define XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET 0x0900U
+#define XPS_L2CC_CACHE_ILCKDWN_0_WAY_OFFSET 0x0904U
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef XPARAMETERS_PS_H
+#define XPARAMETERS_PS_H
+
+/* Host stand-in for the standalone BSP header; accesses here miss the IP model */
+
+#define XPS_L2CC_BASEADDR 0xF8F02000U
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef XPSEUDO_ASM_H
+#define XPSEUDO_ASM_H
+
+/* Host stand-in for the standalone BSP header */
+
+#define dsb() __sync_synchronize()
+
+#endif
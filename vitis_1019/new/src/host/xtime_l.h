@@ -0,0 +1,14 @@
+#ifndef XTIME_L_H
+#define XTIME_L_H
+
+/* Host stand-in for the standalone BSP header: XTime counts nanoseconds */
+
+#include "xil_types.h"
+
+typedef u64 XTime;
+
+#define COUNTS_PER_SECOND 1000000000U
+
+void XTime_GetTime(XTime *xtime);
+
+#endif
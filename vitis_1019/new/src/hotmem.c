@@ -0,0 +1,115 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "hotmem.h"
+#include "xil_io.h"
+#include "xil_cache.h"
+#include "xl2cc.h"
+#include "xparameters_ps.h"
+
+#define L2_LINE_BYTES 32
+#define L2_WAY_BYTES  (64 * 1024)  /* 512 KB, 8 ways */
+#define L2_WAYS       8
+
+/* Provided by lscript.ld / lscript_ocm.ld. */
+extern uint8_t __spx_hot_start[], __spx_hot_end[], __spx_hot_load[];
+extern uint8_t __spx_scratch_start[], __spx_scratch_end[];
+
+void spx_hot_init(void)
+{
+    size_t len = (size_t)(__spx_hot_end - __spx_hot_start);
+
+    if (!spx_hot_in_ocm()) {
+        return;
+    }
+    memcpy(__spx_hot_start, __spx_hot_load, len);
+    Xil_DCacheFlushRange((INTPTR)__spx_hot_start, (u32)len);
+    Xil_ICacheInvalidate();
+}
+
+int spx_hot_in_ocm(void)
+{
+    return (uintptr_t)__spx_hot_load != (uintptr_t)__spx_hot_start;
+}
+
+/*
+ * Sets the lockdown-by-way registers of both CPUs (masters 0 and 1): a set
+ * bit keeps the CPU from allocating into that way.
+ */
+static void l2_set_lockdown(u32 mask)
+{
+    u32 master;
+
+    for (master = 0; master < 2; master++) {
+        Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET
+                  + master * 8U, mask);
+        Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_ILCKDWN_0_WAY_OFFSET
+                  + master * 8U, mask);
+    }
+    Xil_Out32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_SYNC_OFFSET, 0x0U);
+}
+
+int spx_l2_lock(const void *start, size_t len, unsigned int first_way)
+{
+    uintptr_t addr = (uintptr_t)start & ~(uintptr_t)(L2_LINE_BYTES - 1);
+    uintptr_t end = (uintptr_t)start + len;
+    uintptr_t chunk, p;
+    unsigned int ways = (unsigned int)((end - addr + L2_WAY_BYTES - 1) / L2_WAY_BYTES);
+    unsigned int way = first_way;
+    u32 locked;
+
+    if (len == 0) {
+        return 0;
+    }
+    if (first_way >= L2_WAYS || ways > first_way + 1) {
+        return -1;
+    }
+
+    locked = Xil_In32(XPS_L2CC_BASEADDR + XPS_L2CC_CACHE_DLCKDWN_0_WAY_OFFSET);
+
+    /* Out of both cache levels first, so that every read below allocates. */
+    Xil_DCacheFlushRange((INTPTR)addr, (u32)(end - addr));
+
+    /* Fill one way at a time: with all other ways locked, a miss can only
+       allocate into 'way'. A 64 KB chunk maps to each set exactly once. */
+    for (chunk = addr; chunk < end; chunk += L2_WAY_BYTES, way--) {
+        l2_set_lockdown(0xFFU & ~(1U << way));
+        for (p = chunk; p < end && p < chunk + L2_WAY_BYTES; p += L2_LINE_BYTES) {
+            (void)*(volatile const u32 *)p;
+        }
+        locked |= 1U << way;
+    }
+    l2_set_lockdown(locked);
+
+    return (int)ways;
+}
+
+int spx_l2_lock_hot(void)
+{
+    int text_ways, arena_ways;
+
+    if (spx_hot_in_ocm()) {
+        return -1;
+    }
+
+    text_ways = spx_l2_lock(__spx_hot_start,
+                            (size_t)(__spx_hot_end - __spx_hot_start),
+                            L2_WAYS - 1);
+    if (text_ways < 0 || text_ways >= L2_WAYS) {
+        spx_l2_unlock();
+        return -1;
+    }
+    arena_ways = spx_l2_lock(__spx_scratch_start,
+                             (size_t)(__spx_scratch_end - __spx_scratch_start),
+                             (unsigned int)(L2_WAYS - 1 - text_ways));
+    if (arena_ways < 0) {
+        spx_l2_unlock();
+        return -1;
+    }
+    return text_ways + arena_ways;
+}
+
+void spx_l2_unlock(void)
+{
+    l2_set_lockdown(0x0U);
+}
@@ -0,0 +1,51 @@
+#ifndef SPX_HOTMEM_H
+#define SPX_HOTMEM_H
+
+#include <stddef.h>
+
+#include "params.h"
+
+/*
+ * Placement of the SPHINCS+ hot working set on the board.
+ *
+ * Both linker scripts collect the hot path (thash, Keccak/SHA-2 and driver
+ * code, WOTS, FORS, treehash and the scheduler, with their constants) into
+ * one group, and the scratch arena (scratch.h) into another:
+ *
+ *   lscript.ld      everything in DDR; the groups can be locked into L2
+ *   lscript_ocm.ld  hot path, arena and stacks in OCM
+ */
+
+/*
+ * Copies the hot path from its load address in DDR to OCM when linked with
+ * lscript_ocm.ld; does nothing with lscript.ld. Must run before the first
+ * call into any of the hot objects.
+ */
+#define spx_hot_init SPX_NAMESPACE(spx_hot_init)
+void spx_hot_init(void);
+
+/* Returns 1 if the hot path runs from OCM, 0 otherwise. */
+#define spx_hot_in_ocm SPX_NAMESPACE(spx_hot_in_ocm)
+int spx_hot_in_ocm(void);
+
+/*
+ * Loads [start, start + len) into the PL310 L2 and locks it there, one way
+ * (64 KB) at a time from first_way downwards, for both CPUs. The locked ways
+ * are no longer available to anything else. Returns the number of ways
+ * used, or -1 if the range does not fit into ways first_way..0.
+ */
+#define spx_l2_lock SPX_NAMESPACE(spx_l2_lock)
+int spx_l2_lock(const void *start, size_t len, unsigned int first_way);
+
+/*
+ * Locks the hot path and the scratch arena (DDR profile only; OCM is not
+ * cached in L2) starting at way 7. Returns the number of ways used, or -1.
+ */
+#define spx_l2_lock_hot SPX_NAMESPACE(spx_l2_lock_hot)
+int spx_l2_lock_hot(void);
+
+/* Releases all lockdown ways. */
+#define spx_l2_unlock SPX_NAMESPACE(spx_l2_unlock)
+void spx_l2_unlock(void);
+
+#endif
@@ -13,9 +13,128 @@
 #include "api.h"         // SPHINCS+ API
 // #include "params.h"      // ]ጵ SPX_ALG }
 #include "randombytes.h" // ϢSC
+#ifdef SPX_SCRATCH_ARENA
+#include "scratch.h"     // arena high-water mark
+#endif
+#include "hotmem.h"      // OCM / L2 placement of the hot path
+#include "bench.h"       // signing latency and jitter
+#if defined(SPX_HW_RING) || defined(SPX_HW_SHA2_TAGS)
+#include "fpga_sha_driver.h" // descriptor ring, tagged SHA-2 jobs
+#endif
+#ifdef SPX_HOST_MODEL
+#include "hw_model.h"     // bus statistics of the host model
+#endif
 
 #define MLEN 32
 
+/* Define SPX_BENCH_RUNS (e.g. 20) to time that many signatures and one
+   crypto_sign_many() batch of SPX_BENCH_MANY signatures at the end,
+   SPX_L2_LOCK to lock the hot path into L2 (DDR profile, lscript.ld) and
+   SPX_HW_RING to check the descriptor ring against the register driver and
+   SPX_HW_SHA2_TAGS to check interleaved tagged SHA-2 jobs against it. */
+static int l2_locked_ways;
+
+#ifdef SPX_HW_RING
+#define RING_ORDER 3
+#define RING_JOBS  8
+
+/* One batch of thash-shaped SHAKE256 jobs (seed || ADRS || input of growing
+   length, including empty) through the ring, compared with shake256_hw(). */
+static int hw_ring_self_test(void)
+{
+    static HwHashDesc desc[1 << RING_ORDER];
+    static volatile u32 cmpl[8] __attribute__((aligned(32)));
+    static uint8_t seed[32], adrs[32], in[300], ref_in[64 + 300];
+    static uint8_t out[RING_JOBS][64] __attribute__((aligned(32)));
+    static const size_t inlen[RING_JOBS] = { 0, 1, 7, 8, 9, 32, 136, 300 };
+    HwHashRing ring;
+    uint8_t ref[32];
+    size_t i;
+
+    randombytes(seed, sizeof(seed));
+    randombytes(adrs, sizeof(adrs));
+    randombytes(in, sizeof(in));
+
+#ifdef SPX_HOST_MODEL
+    /* What the M00_AXI master of the model may reach */
+    if (hw_model_dma_map(desc, sizeof(desc)) || hw_model_dma_map((void *)cmpl, sizeof(cmpl)) ||
+            hw_model_dma_map(seed, sizeof(seed)) || hw_model_dma_map(in, sizeof(in)) ||
+            hw_model_dma_map(out, sizeof(out))) {
+        return -1;
+    }
+#endif
+    if (hw_ring_init(&ring, desc, RING_ORDER, cmpl)) {
+        return -1;
+    }
+    for (i = 0; i < RING_JOBS; i++) {
+        adrs[31] = (uint8_t)i;
+        if (hw_ring_queue(&ring, HW_MODE_SHAKE_256, out[i], 32, seed, 32,
+                          adrs, 32, in, inlen[i])) {
+            return -1;
+        }
+    }
+    hw_ring_submit(&ring);
+    if (hw_ring_wait(&ring)) {
+        return -1;
+    }
+
+    memcpy(ref_in, seed, 32);
+    memcpy(ref_in + 64, in, sizeof(in));
+    for (i = 0; i < RING_JOBS; i++) {
+        memcpy(ref_in + 32, adrs, 32);
+        ref_in[63] = (uint8_t)i;
+        shake256_hw(ref, 32, ref_in, 64 + inlen[i]);
+        if (memcmp(ref, out[i], 32) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+#endif
+
+#ifdef SPX_HW_SHA2_TAGS
+#define TAG_JOBS 8
+
+/* TAG_JOBS SHA-256 messages of mixed length with up to SHA2_CMPL_DEPTH in
+   flight, harvested as they finish, compared with sha256_hw(). */
+static int hw_sha2_tags_self_test(void)
+{
+    static const size_t inlen[TAG_JOBS] = { 1, 55, 56, 64, 3, 119, 200, 32 };
+    static uint8_t in[200], out[TAG_JOBS][32];
+    HwSha2Queue q;
+    uint8_t ref[32];
+    size_t i;
+
+    randombytes(in, sizeof(in));
+    if (hw_sha2_queue_init(&q, HW_MODE_SHA2_256)) {
+        return -1;
+    }
+    for (i = 0; i < TAG_JOBS; i++) {
+        while (q.inflight == SHA2_CMPL_DEPTH) {
+            if (hw_sha2_harvest(&q) < 0) {
+                return -1;
+            }
+        }
+        in[0] = (uint8_t)i;
+        if (hw_sha2_submit(&q, out[i], in, inlen[i]) < 0) {
+            return -1;
+        }
+    }
+    if (hw_sha2_drain(&q)) {
+        return -1;
+    }
+
+    for (i = 0; i < TAG_JOBS; i++) {
+        in[0] = (uint8_t)i;
+        sha256_hw(ref, in, inlen[i]);
+        if (memcmp(ref, out[i], 32) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+#endif
+
 // ԭ
 void print_hex(const char *label, const unsigned char *data, size_t len);
 void init_platform();
@@ -129,12 +248,72 @@ int main()
         printf(" - HW Verification:         %.3f ms\r\n", (double)hw_verify_ticks / (CPU_FREQ_MHZ * 1000.0));
     #endif
 
+    #ifdef SPX_SCRATCH_ARENA
+        xil_printf(" - Scratch arena high-water: %u of %u bytes\r\n",
+                   (unsigned int)spx_scratch_high_water(), (unsigned int)SPX_SCRATCH_BYTES);
+    #endif
+
+    #ifdef SPX_BENCH_RUNS
+    {
+        spx_bench_result bench;
+
+        xil_printf("\r\n--- Signing Latency (%d runs, hot path in %s) ---\r\n",
+                   SPX_BENCH_RUNS, spx_hot_in_ocm() ? "OCM" :
+                   (l2_locked_ways > 0 ? "DDR, locked in L2" : "DDR"));
+        if (spx_bench_sign(&bench, sk_hw, SPX_BENCH_RUNS)) {
+            xil_printf("  [FAIL] Benchmark signature failed.\r\n");
+            final_status = XST_FAILURE;
+        } else {
+            print_llu(" - Min:   ", bench.min);
+            print_llu(" - Max:   ", bench.max);
+            print_llu(" - Mean:  ", bench.mean);
+            print_llu(" - Stddev:", bench.stddev);
+        }
+    }
+    {
+        spx_bench_throughput tput;
+
+        xil_printf("\r\n--- Signing Throughput (crypto_sign_many) ---\r\n");
+        if (spx_bench_sign_many(&tput, sk_hw, SPX_BENCH_MANY)) {
+            xil_printf("  [FAIL] Batch signing failed.\r\n");
+            final_status = XST_FAILURE;
+        } else {
+            print_llu(" - Batch: ", tput.ticks);
+            xil_printf(" - %u signatures, %u.%03u signatures/s\r\n",
+                       (unsigned int)tput.sigs,
+                       (unsigned int)(tput.sigs_per_ksec / 1000),
+                       (unsigned int)(tput.sigs_per_ksec % 1000));
+        }
+    }
+    #endif
+
+    #ifdef SPX_HW_RING
+        if (hw_ring_self_test() != 0) {
+            xil_printf("  [FAIL] Descriptor ring results differ from the register driver.\r\n");
+            final_status = XST_FAILURE;
+        } else {
+            xil_printf(" - Descriptor ring: %d jobs in one batch match.\r\n", RING_JOBS);
+        }
+    #endif
+
+    #ifdef SPX_HW_SHA2_TAGS
+        if (hw_sha2_tags_self_test() != 0) {
+            xil_printf("  [FAIL] Tagged SHA-2 results differ from the register driver.\r\n");
+            final_status = XST_FAILURE;
+        } else {
+            xil_printf(" - Tagged SHA-2: %d interleaved jobs match.\r\n", TAG_JOBS);
+        }
+    #endif
+
     if (final_status == XST_SUCCESS) {
         xil_printf("\r\n[FINAL CONCLUSION: PASSED] SHA-2 HW Functionality is correct.\r\n");
     } else {
         xil_printf("\r\n[FINAL CONCLUSION: FAILED] A SHA-2 HW functional verification step failed.\r\n");
     }
 
+#ifdef SPX_HOST_MODEL
+    hw_model_print_stats();
+#endif
     cleanup_platform();
     return final_status;
 }
@@ -177,10 +356,18 @@ void print_hex(const char *label, const unsigned char *data, size_t len) {
 void init_platform() {
     Xil_ICacheEnable();
     Xil_DCacheEnable();
+    spx_hot_init();
+#ifdef SPX_L2_LOCK
+    l2_locked_ways = spx_l2_lock_hot();
+    xil_printf("Hot path locked into %d L2 ways\r\n", l2_locked_ways);
+#endif
     xil_printf("Platform initialized (Caches Enabled)\r\n");
 }
 
 void cleanup_platform() {
+    if (l2_locked_ways > 0) {
+        spx_l2_unlock();
+    }
     Xil_DCacheDisable();
     Xil_ICacheDisable();
     xil_printf("Platform cleaned up (Caches Disabled)\r\n");
@@ -7,6 +7,7 @@
 #include "wotsx1.h"
 #include "merkle.h"
 #include "address.h"
+#include "thash.h"
 #include "params.h"
 
 /*
@@ -42,13 +43,81 @@ void merkle_sign(uint8_t *sig, unsigned char *root,
                 tree_addr, &info);
 }
 
+/*
+ * Computes the authentication path for idx_leaf and the root of the subtree
+ * addressed by tree_addr (layer and tree set), without a WOTS signature.
+ * Unlike merkle_sign() this does not depend on the message being signed, so
+ * all layers of a signature can be built independently of each other.
+ */
+void merkle_gen_auth(unsigned char *auth_path, unsigned char *root,
+                     const spx_ctx *ctx,
+                     uint32_t tree_addr[8], uint32_t idx_leaf)
+{
+    struct leaf_info_x1 info = { 0 };
+    unsigned steps[ SPX_WOTS_LEN ] = { 0 };
+
+    info.wots_steps = steps;
+
+    set_type(&tree_addr[0], SPX_ADDR_TYPE_HASHTREE);
+    set_type(&info.pk_addr[0], SPX_ADDR_TYPE_WOTSPK);
+    copy_subtree_addr(&info.leaf_addr[0], tree_addr);
+    copy_subtree_addr(&info.pk_addr[0], tree_addr);
+
+    /* ~0 turns the signature logic in wots_gen_leafx1 off. */
+    info.wots_sign_leaf = ~0u;
+
+    treehashx1(root, auth_path, ctx,
+                idx_leaf, 0,
+                SPX_TREE_HEIGHT,
+                wots_gen_leafx1,
+                tree_addr, &info);
+}
+
+/*
+ * Computes the root of subtree (layer, tree) from its part of a hypertree
+ * signature (WOTS signature followed by the auth path) and the message that
+ * part signs, i.e. the root of the layer below. root and msg may coincide.
+ */
+void merkle_root_from_sig(unsigned char *root, const unsigned char *sig,
+                          const unsigned char *msg, const spx_ctx *ctx,
+                          uint32_t layer, uint64_t tree, uint32_t idx_leaf)
+{
+    SPX_VLA(unsigned char, wots_pk, SPX_WOTS_BYTES);
+    unsigned char leaf[SPX_N];
+    uint32_t wots_addr[8] = {0};
+    uint32_t tree_addr[8] = {0};
+    uint32_t wots_pk_addr[8] = {0};
+
+    set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
+    set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
+    set_type(wots_pk_addr, SPX_ADDR_TYPE_WOTSPK);
+
+    set_layer_addr(tree_addr, layer);
+    set_tree_addr(tree_addr, tree);
+
+    copy_subtree_addr(wots_addr, tree_addr);
+    set_keypair_addr(wots_addr, idx_leaf);
+
+    copy_keypair_addr(wots_pk_addr, wots_addr);
+
+    /* The WOTS public key is only correct if the signature was correct. */
+    wots_pk_from_sig(wots_pk, sig, msg, ctx, wots_addr);
+
+    /* Compute the leaf node using the WOTS public key. */
+    thash(leaf, wots_pk, SPX_WOTS_LEN, ctx, wots_pk_addr);
+
+    /* Compute the root node of this subtree. */
+    compute_root(root, leaf, idx_leaf, 0, sig + SPX_WOTS_BYTES,
+                 SPX_TREE_HEIGHT, ctx, tree_addr);
+}
+
 /* Compute root node of the top-most subtree. */
 void merkle_gen_root(unsigned char *root, const spx_ctx *ctx)
 {
     /* We do not need the auth path in key generation, but it simplifies the
        code to have just one treehash routine that computes both root and path
        in one function. */
-    unsigned char auth_path[SPX_TREE_HEIGHT * SPX_N + SPX_WOTS_BYTES];
+    SPX_VLA(unsigned char, auth_path, SPX_TREE_HEIGHT * SPX_N + SPX_WOTS_BYTES);
     uint32_t top_tree_addr[8] = {0};
     uint32_t wots_addr[8] = {0};
 
@@ -11,6 +11,19 @@ void merkle_sign(uint8_t *sig, unsigned char *root,
         uint32_t wots_addr[8], uint32_t tree_addr[8],
         uint32_t idx_leaf);
 
+/* Compute the authentication path and root of a subtree, without the */
+/* WOTS signature */
+#define merkle_gen_auth SPX_NAMESPACE(merkle_gen_auth)
+void merkle_gen_auth(unsigned char *auth_path, unsigned char *root,
+        const spx_ctx* ctx,
+        uint32_t tree_addr[8], uint32_t idx_leaf);
+
+/* Compute the root of a subtree from its part of a hypertree signature */
+#define merkle_root_from_sig SPX_NAMESPACE(merkle_root_from_sig)
+void merkle_root_from_sig(unsigned char *root, const unsigned char *sig,
+        const unsigned char *msg, const spx_ctx* ctx,
+        uint32_t layer, uint64_t tree, uint32_t idx_leaf);
+
 /* Compute the root node of the top-most subtree. */
 #define merkle_gen_root SPX_NAMESPACE(merkle_gen_root)
 void merkle_gen_root(unsigned char *root, const spx_ctx* ctx);
@@ -0,0 +1,28 @@
+#include "params.h"
+#include "parallel.h"
+
+static spx_job_runner job_runner;
+
+void spx_set_job_runner(spx_job_runner runner)
+{
+    job_runner = runner;
+}
+
+void spx_run_jobs(spx_job_fn fn, void *arg, unsigned int njobs)
+{
+    unsigned int job;
+
+    if (job_runner) {
+        job_runner(fn, arg, njobs);
+        return;
+    }
+
+    for (job = 0; job < njobs; job++) {
+        fn(arg, job);
+    }
+}
+
+int spx_jobs_serial(void)
+{
+    return job_runner == 0;
+}
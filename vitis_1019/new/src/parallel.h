@@ -0,0 +1,39 @@
+#ifndef SPX_PARALLEL_H
+#define SPX_PARALLEL_H
+
+/*
+ * Job dispatch for work that has no ordering constraints (e.g. the FORS
+ * trees and hypertree subtrees of one signature).
+ *
+ * A job function is called exactly once for every index in 0..njobs-1 and
+ * writes only to its own outputs, so a runner may execute the calls in any
+ * order and concurrently (second core, additional IP instances, ...). The
+ * default runner executes them serially on the calling core.
+ *
+ * A concurrent runner is only correct if every job can reach a hash backend
+ * of its own: the single-IP driver in fpga_sha_driver.c is not reentrant.
+ * The same holds for the scratch arena of SPX_SCRATCH_ARENA builds.
+ * host/host_jobs.c is such a runner for the host build, with one IP model
+ * per thread (test/jobs.c); the board has none yet and runs jobs serially.
+ */
+typedef void (*spx_job_fn)(void *arg, unsigned int job);
+typedef void (*spx_job_runner)(spx_job_fn fn, void *arg, unsigned int njobs);
+
+/*
+ * Installs runner for all subsequent spx_run_jobs() calls (NULL restores
+ * the serial runner). The runner must return only once all jobs are done.
+ */
+#define spx_set_job_runner SPX_NAMESPACE(spx_set_job_runner)
+void spx_set_job_runner(spx_job_runner runner);
+
+#define spx_run_jobs SPX_NAMESPACE(spx_run_jobs)
+void spx_run_jobs(spx_job_fn fn, void *arg, unsigned int njobs);
+
+/*
+ * Returns 1 while the serial runner is in use. Callers whose split into jobs
+ * costs extra work then take their sequential path instead.
+ */
+#define spx_jobs_serial SPX_NAMESPACE(spx_jobs_serial)
+int spx_jobs_serial(void);
+
+#endif
@@ -0,0 +1,322 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "precomp.h"
+#include "params.h"
+#include "utils.h"
+#include "wotsx1.h"
+#include "hash.h"
+#include "thash.h"
+#include "address.h"
+
+#ifdef SPX_PRECOMP_FATFS
+#include "ff.h"
+#endif
+
+static const uint8_t *precomp_blob;
+
+/* Number of trees stored before layer block j (block 0 is the top layer). */
+static uint64_t trees_before(unsigned int j)
+{
+    uint64_t count = 0;
+    unsigned int i;
+
+    for (i = 0; i < j; i++) {
+        count += (uint64_t)1 << (SPX_TREE_HEIGHT * i);
+    }
+    return count;
+}
+
+/* Offset of level 'level' inside a stored tree, in nodes. */
+static uint32_t level_offset(uint32_t level)
+{
+    return ((uint32_t)2 << SPX_TREE_HEIGHT) - ((uint32_t)2 << (SPX_TREE_HEIGHT - level));
+}
+
+static const uint8_t *tree_ptr(const uint8_t *blob, uint32_t layer,
+                               uint64_t tree)
+{
+    unsigned int j = SPX_D - 1 - layer;
+
+    return blob + SPX_PRECOMP_HEADER_BYTES
+                + (size_t)(trees_before(j) + tree) * SPX_PRECOMP_TREE_BYTES;
+}
+
+size_t spx_precomp_bytes(unsigned int layers)
+{
+    uint64_t bytes;
+
+    if (layers == 0 || layers > SPX_D ||
+            SPX_TREE_HEIGHT * (layers - 1) >= 32) {
+        return 0;
+    }
+    bytes = SPX_PRECOMP_HEADER_BYTES
+          + trees_before(layers) * SPX_PRECOMP_TREE_BYTES + SPX_N;
+    if (bytes != (size_t)bytes) {
+        return 0;
+    }
+    return (size_t)bytes;
+}
+
+/* Builds all nodes of one subtree into out (see precomp.h for the layout). */
+static void gen_tree(uint8_t *out, const spx_ctx *ctx,
+                     uint32_t layer, uint64_t tree)
+{
+    struct leaf_info_x1 info = { 0 };
+    unsigned steps[SPX_WOTS_LEN] = { 0 };
+    uint32_t tree_addr[8] = {0};
+    uint32_t level, idx;
+
+    set_layer_addr(tree_addr, layer);
+    set_tree_addr(tree_addr, tree);
+
+    /* Leaves; wots_sign_leaf = ~0 turns off the signature logic. */
+    info.wots_sign_leaf = ~0u;
+    info.wots_steps = steps;
+    copy_subtree_addr(info.leaf_addr, tree_addr);
+    copy_subtree_addr(info.pk_addr, tree_addr);
+    set_type(info.pk_addr, SPX_ADDR_TYPE_WOTSPK);
+
+    for (idx = 0; idx < (1u << SPX_TREE_HEIGHT); idx++) {
+        wots_gen_leafx1(out + idx * SPX_N, ctx, idx, &info);
+    }
+
+    /* Internal nodes, addressed exactly as treehashx1 does. */
+    set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
+    for (level = 1; level <= SPX_TREE_HEIGHT; level++) {
+        const uint8_t *below = out + level_offset(level - 1) * SPX_N;
+        uint8_t *nodes = out + level_offset(level) * SPX_N;
+
+        set_tree_height(tree_addr, level);
+        for (idx = 0; idx < (1u << (SPX_TREE_HEIGHT - level)); idx++) {
+            set_tree_index(tree_addr, idx);
+            thash(nodes + idx * SPX_N, below + 2 * idx * SPX_N, 2,
+                  ctx, tree_addr);
+        }
+    }
+}
+
+/* MAC over the first bytes - SPX_N bytes of a blob, keyed with SK_PRF. */
+static void precomp_mac(unsigned char *mac, const uint8_t *blob, size_t bytes,
+                        const unsigned char *sk_prf, const spx_ctx *ctx)
+{
+    unsigned char tag[SPX_N] = { 0 };
+
+    /* Sets the MAC apart from the R of a signature on the same bytes. */
+    memcpy(tag, "SPXA precomp MAC", SPX_N < 16 ? SPX_N : 16);
+    gen_message_random(mac, sk_prf, tag, blob, bytes - SPX_N, ctx);
+}
+
+/* Writes the header and the trees; the caller adds the MAC. */
+static int precomp_fill(uint8_t *blob, size_t bloblen, unsigned int layers,
+                        const spx_ctx *ctx, const unsigned char *pk)
+{
+    size_t bytes = spx_precomp_bytes(layers);
+    unsigned int j;
+    uint64_t tree;
+
+    if (bytes == 0 || bloblen < bytes) {
+        return -1;
+    }
+
+    u32_to_bytes(blob + 0, SPX_PRECOMP_MAGIC);
+    u32_to_bytes(blob + 4, SPX_PRECOMP_VERSION);
+    u32_to_bytes(blob + 8, SPX_N);
+    u32_to_bytes(blob + 12, SPX_FULL_HEIGHT);
+    u32_to_bytes(blob + 16, SPX_D);
+    u32_to_bytes(blob + 20, SPX_WOTS_W);
+    u32_to_bytes(blob + 24, layers);
+    u32_to_bytes(blob + 28, 0);
+    memcpy(blob + 32, pk, SPX_PK_BYTES);
+
+    for (j = 0; j < layers; j++) {
+        for (tree = 0; tree < ((uint64_t)1 << (SPX_TREE_HEIGHT * j)); tree++) {
+            gen_tree((uint8_t *)tree_ptr(blob, SPX_D - 1 - j, tree),
+                     ctx, SPX_D - 1 - j, tree);
+        }
+    }
+
+    return 0;
+}
+
+int spx_precomp_gen(uint8_t *blob, size_t bloblen, unsigned int layers,
+                    const spx_ctx *ctx, const unsigned char *sk)
+{
+    size_t bytes = spx_precomp_bytes(layers);
+
+    if (precomp_fill(blob, bloblen, layers, ctx, sk + 2*SPX_N)) {
+        return -1;
+    }
+    precomp_mac(blob + bytes - SPX_N, blob, bytes, sk + SPX_N, ctx);
+
+    return 0;
+}
+
+int spx_precomp_seed_keypair(unsigned char *pk, unsigned char *sk,
+                             const unsigned char *seed,
+                             uint8_t *blob, size_t bloblen,
+                             unsigned int layers)
+{
+    spx_ctx ctx;
+
+    /* Initialize SK_SEED, SK_PRF and PUB_SEED from seed. */
+    memcpy(sk, seed, 3*SPX_N);
+
+    memcpy(pk, sk + 2*SPX_N, SPX_N);
+
+    memcpy(ctx.pub_seed, pk, SPX_N);
+    memcpy(ctx.sk_seed, sk, SPX_N);
+
+    initialize_hash_function(&ctx);
+
+    /* The root is not known yet; it is filled in below, header included. */
+    memset(pk + SPX_N, 0, SPX_N);
+    if (precomp_fill(blob, bloblen, layers, &ctx, pk)) {
+        return -1;
+    }
+
+    /* The root of the top-most subtree is the last node of the first tree. */
+    memcpy(pk + SPX_N, tree_ptr(blob, SPX_D - 1, 0)
+                       + level_offset(SPX_TREE_HEIGHT) * SPX_N, SPX_N);
+    memcpy(sk + 3*SPX_N, pk + SPX_N, SPX_N);
+    memcpy(blob + 32 + SPX_N, pk + SPX_N, SPX_N);
+    precomp_mac(blob + spx_precomp_bytes(layers) - SPX_N, blob,
+                spx_precomp_bytes(layers), sk + SPX_N, &ctx);
+
+    return 0;
+}
+
+int spx_precomp_check(const uint8_t *blob, size_t bloblen,
+                      const unsigned char *sk)
+{
+    unsigned char mac[SPX_N];
+    unsigned char diff = 0;
+    unsigned int layers, i;
+    size_t bytes;
+    spx_ctx ctx;
+
+    if (bloblen < SPX_PRECOMP_HEADER_BYTES ||
+            bytes_to_ull(blob + 0, 4) != SPX_PRECOMP_MAGIC ||
+            bytes_to_ull(blob + 4, 4) != SPX_PRECOMP_VERSION ||
+            bytes_to_ull(blob + 8, 4) != SPX_N ||
+            bytes_to_ull(blob + 12, 4) != SPX_FULL_HEIGHT ||
+            bytes_to_ull(blob + 16, 4) != SPX_D ||
+            bytes_to_ull(blob + 20, 4) != SPX_WOTS_W) {
+        return -1;
+    }
+
+    layers = (unsigned int)bytes_to_ull(blob + 24, 4);
+    bytes = spx_precomp_bytes(layers);
+    if (bytes == 0 || bloblen < bytes ||
+            memcmp(blob + 32, sk + 2*SPX_N, SPX_PK_BYTES)) {
+        return -1;
+    }
+
+    memcpy(ctx.pub_seed, sk + 2*SPX_N, SPX_N);
+    memcpy(ctx.sk_seed, sk, SPX_N);
+    initialize_hash_function(&ctx);
+
+    precomp_mac(mac, blob, bytes, sk + SPX_N, &ctx);
+
+    /* The tag is keyed by SK_PRF: compare all of it, whatever differs. */
+    for (i = 0; i < SPX_N; i++) {
+        diff |= (unsigned char)(mac[i] ^ blob[bytes - SPX_N + i]);
+    }
+    if (diff != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int spx_precomp_attach(const uint8_t *blob, size_t bloblen,
+                       const unsigned char *sk)
+{
+    if (spx_precomp_check(blob, bloblen, sk)) {
+        return -1;
+    }
+
+    precomp_blob = blob;
+
+    return 0;
+}
+
+void spx_precomp_detach(void)
+{
+    precomp_blob = 0;
+}
+
+const uint8_t *spx_precomp_attached(void)
+{
+    return precomp_blob;
+}
+
+int spx_precomp_auth_path(const uint8_t *blob,
+                          unsigned char *auth_path, unsigned char *root,
+                          const unsigned char *pk,
+                          uint32_t layer, uint64_t tree, uint32_t idx_leaf)
+{
+    const uint8_t *nodes;
+    uint32_t h;
+
+    if (blob == 0 || layer + bytes_to_ull(blob + 24, 4) < SPX_D ||
+            memcmp(blob + 32, pk, SPX_PK_BYTES)) {
+        return -1;
+    }
+
+    nodes = tree_ptr(blob, layer, tree);
+
+    for (h = 0; h < SPX_TREE_HEIGHT; h++) {
+        memcpy(auth_path + h * SPX_N,
+               nodes + (level_offset(h) + ((idx_leaf >> h) ^ 1)) * SPX_N,
+               SPX_N);
+    }
+    memcpy(root, nodes + level_offset(SPX_TREE_HEIGHT) * SPX_N, SPX_N);
+
+    return 0;
+}
+
+#ifdef SPX_PRECOMP_FATFS
+static FATFS precomp_fatfs;
+
+int spx_precomp_save(const char *path, const uint8_t *blob, size_t bloblen)
+{
+    FIL fil;
+    UINT written;
+    FRESULT res;
+
+    if (f_mount(&precomp_fatfs, "0:/", 0) != FR_OK) {
+        return -1;
+    }
+    if (f_open(&fil, path, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+        return -1;
+    }
+    res = f_write(&fil, blob, (UINT)bloblen, &written);
+    if (f_close(&fil) != FR_OK || res != FR_OK || written != bloblen) {
+        return -1;
+    }
+    return 0;
+}
+
+int spx_precomp_load(const char *path, uint8_t *blob, size_t bloblen,
+                     size_t *readlen)
+{
+    FIL fil;
+    UINT nread;
+    FRESULT res;
+
+    if (f_mount(&precomp_fatfs, "0:/", 0) != FR_OK) {
+        return -1;
+    }
+    if (f_open(&fil, path, FA_READ) != FR_OK) {
+        return -1;
+    }
+    res = f_read(&fil, blob, (UINT)bloblen, &nread);
+    f_close(&fil);
+    if (res != FR_OK) {
+        return -1;
+    }
+    *readlen = nread;
+    return 0;
+}
+#endif
@@ -0,0 +1,106 @@
+#ifndef SPX_PRECOMP_H
+#define SPX_PRECOMP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "params.h"
+#include "context.h"
+
+/*
+ * Signing accelerator blob: every node (leaves, i.e. compressed WOTS public
+ * keys, and all internal nodes) of the top 'layers' hypertree layers of one
+ * key pair, computed once at key generation time.
+ *
+ * Layout (all integers big-endian):
+ *   header  [magic || version || n || full_height || d || w || layers || 0]
+ *           followed by the public key [PUB_SEED || root]
+ *   trees   layer d-1 first, then d-2, ...; within a layer in tree order.
+ *           Each tree stores level 0 (2^h leaves) up to level h (the root).
+ *   mac     n bytes, PRF_msg(SK_PRF, tag, everything before it)
+ *
+ * The nodes are copied into signatures and the roots signed with WOTS, so a
+ * blob with a wrong node would make the signer use a one-time key twice.
+ * The MAC is checked when a blob is attached; it needs the secret key.
+ */
+#define SPX_PRECOMP_MAGIC 0x53505841 /* "SPXA" */
+#define SPX_PRECOMP_VERSION 2
+#define SPX_PRECOMP_HEADER_BYTES (8 * 4 + SPX_PK_BYTES)
+#define SPX_PRECOMP_TREE_BYTES ((((uint32_t)2 << SPX_TREE_HEIGHT) - 1) * SPX_N)
+
+/*
+ * Returns the size of a blob covering the top 'layers' layers, or 0 if that
+ * many layers cannot be addressed (too many trees).
+ */
+#define spx_precomp_bytes SPX_NAMESPACE(spx_precomp_bytes)
+size_t spx_precomp_bytes(unsigned int layers);
+
+/*
+ * Fills blob with the top 'layers' layers of the key described by ctx and sk.
+ * Returns 0 on success, -1 if bloblen is too small or layers is invalid.
+ */
+#define spx_precomp_gen SPX_NAMESPACE(spx_precomp_gen)
+int spx_precomp_gen(uint8_t *blob, size_t bloblen, unsigned int layers,
+                    const spx_ctx *ctx, const unsigned char *sk);
+
+/*
+ * Generates an SPX key pair given a seed (see crypto_sign_seed_keypair) and
+ * writes the signing accelerator blob for it. The root in pk is taken from
+ * the precomputed top tree, so this costs no more than the blob itself.
+ */
+#define spx_precomp_seed_keypair SPX_NAMESPACE(spx_precomp_seed_keypair)
+int spx_precomp_seed_keypair(unsigned char *pk, unsigned char *sk,
+                             const unsigned char *seed,
+                             uint8_t *blob, size_t bloblen,
+                             unsigned int layers);
+
+/*
+ * Checks that blob is a complete accelerator blob for the compiled parameter
+ * set, made for the key pair of sk and not modified since. Hashes the whole
+ * blob. Returns 0 if so, -1 otherwise.
+ */
+#define spx_precomp_check SPX_NAMESPACE(spx_precomp_check)
+int spx_precomp_check(const uint8_t *blob, size_t bloblen,
+                      const unsigned char *sk);
+
+/*
+ * Makes a blob available to crypto_sign_signature() (and every signing
+ * context initialized afterwards). The blob is used in place (not copied)
+ * and must stay valid, and unmodified, until spx_precomp_detach().
+ * Returns 0 if spx_precomp_check() accepts it for sk, -1 otherwise.
+ */
+#define spx_precomp_attach SPX_NAMESPACE(spx_precomp_attach)
+int spx_precomp_attach(const uint8_t *blob, size_t bloblen,
+                       const unsigned char *sk);
+
+#define spx_precomp_detach SPX_NAMESPACE(spx_precomp_detach)
+void spx_precomp_detach(void);
+
+#define spx_precomp_attached SPX_NAMESPACE(spx_precomp_attached)
+const uint8_t *spx_precomp_attached(void);
+
+/*
+ * Looks up the authentication path for idx_leaf and the root of the given
+ * subtree (the output of merkle_gen_auth()). Returns -1 (and does nothing) if
+ * blob is NULL, belongs to a different public key or does not cover layer.
+ */
+#define spx_precomp_auth_path SPX_NAMESPACE(spx_precomp_auth_path)
+int spx_precomp_auth_path(const uint8_t *blob,
+                          unsigned char *auth_path, unsigned char *root,
+                          const unsigned char *pk,
+                          uint32_t layer, uint64_t tree, uint32_t idx_leaf);
+
+#ifdef SPX_PRECOMP_FATFS
+/*
+ * Stores / loads a blob on the SD card through the xilffs (FatFs) library.
+ * Requires xilffs to be enabled in the BSP. Return 0 on success, -1 on error.
+ */
+#define spx_precomp_save SPX_NAMESPACE(spx_precomp_save)
+int spx_precomp_save(const char *path, const uint8_t *blob, size_t bloblen);
+
+#define spx_precomp_load SPX_NAMESPACE(spx_precomp_load)
+int spx_precomp_load(const char *path, uint8_t *blob, size_t bloblen,
+                     size_t *readlen);
+#endif
+
+#endif
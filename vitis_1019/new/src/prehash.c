@@ -0,0 +1,98 @@
+#include <stddef.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "api.h"
+#include "params.h"
+#include "prehash.h"
+#include "hashtrace.h"
+#ifdef SPX_SHA2
+#include "context.h"
+#include "sha2.h"
+#else
+#include "fips202.h"
+#endif
+
+#define PH_MSG_BYTES(ctxlen) (2 + (ctxlen) + SPX_PH_OID_BYTES + SPX_PH_BYTES)
+
+/* DER object identifiers from FIPS 205, Section 10.2. */
+#ifdef SPX_SHA2
+static const uint8_t ph_oid[SPX_PH_OID_BYTES] = {
+    0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03
+};
+#else
+static const uint8_t ph_oid[SPX_PH_OID_BYTES] = {
+    0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x0C
+};
+#endif
+
+void spx_prehash(uint8_t *digest, const uint8_t *m, size_t mlen)
+{
+    SPX_TRACE_SITE(SPX_SITE_PREHASH);
+#ifdef SPX_SHA2
+    sha512(digest, m, mlen);
+#else
+    shake256(digest, SPX_PH_BYTES, m, mlen);
+#endif
+}
+
+/* Builds M' into buf and returns its length. */
+static size_t ph_message(uint8_t *buf, const uint8_t *digest,
+                         const uint8_t *ctx, size_t ctxlen)
+{
+    buf[0] = 0x01;
+    buf[1] = (uint8_t)ctxlen;
+    memcpy(buf + 2, ctx, ctxlen);
+    memcpy(buf + 2 + ctxlen, ph_oid, SPX_PH_OID_BYTES);
+    memcpy(buf + 2 + ctxlen + SPX_PH_OID_BYTES, digest, SPX_PH_BYTES);
+
+    return PH_MSG_BYTES(ctxlen);
+}
+
+int spx_sign_prehashed(uint8_t *sig, size_t *siglen,
+                       const uint8_t *digest,
+                       const uint8_t *ctx, size_t ctxlen, const uint8_t *sk)
+{
+    uint8_t buf[PH_MSG_BYTES(SPX_PH_MAX_CTX)];
+    size_t len;
+
+    if (ctxlen > SPX_PH_MAX_CTX) {
+        return -1;
+    }
+    len = ph_message(buf, digest, ctx, ctxlen);
+    return crypto_sign_signature(sig, siglen, buf, len, sk);
+}
+
+int spx_verify_prehashed(const uint8_t *sig, size_t siglen,
+                         const uint8_t *digest,
+                         const uint8_t *ctx, size_t ctxlen, const uint8_t *pk)
+{
+    uint8_t buf[PH_MSG_BYTES(SPX_PH_MAX_CTX)];
+    size_t len;
+
+    if (ctxlen > SPX_PH_MAX_CTX) {
+        return -1;
+    }
+    len = ph_message(buf, digest, ctx, ctxlen);
+    return crypto_sign_verify(sig, siglen, buf, len, pk);
+}
+
+int spx_sign_prehash(uint8_t *sig, size_t *siglen,
+                     const uint8_t *m, size_t mlen,
+                     const uint8_t *ctx, size_t ctxlen, const uint8_t *sk)
+{
+    uint8_t digest[SPX_PH_BYTES];
+
+    spx_prehash(digest, m, mlen);
+    return spx_sign_prehashed(sig, siglen, digest, ctx, ctxlen, sk);
+}
+
+int spx_verify_prehash(const uint8_t *sig, size_t siglen,
+                       const uint8_t *m, size_t mlen,
+                       const uint8_t *ctx, size_t ctxlen, const uint8_t *pk)
+{
+    uint8_t digest[SPX_PH_BYTES];
+
+    spx_prehash(digest, m, mlen);
+    return spx_verify_prehashed(sig, siglen, digest, ctx, ctxlen, pk);
+}
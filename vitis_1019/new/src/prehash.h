@@ -0,0 +1,57 @@
+#ifndef SPX_PREHASH_H
+#define SPX_PREHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "params.h"
+
+/*
+ * Pre-hash signing in the style of FIPS 205 HashSLH-DSA, for large messages:
+ * M is digested once with PH and only
+ *
+ *   M' = 0x01 || len(ctx) || ctx || OID(PH) || PH(M)
+ *
+ * goes through crypto_sign_signature(), instead of M being read by both
+ * gen_message_random() and hash_message(). PH is the family's hash, so it
+ * runs on the accelerator: SHA-512 for SHA-2 parameter sets and SHAKE256
+ * (64 bytes) for SHAKE ones. The leading 0x01 keeps pre-hash signatures
+ * apart from those made with a plain crypto_sign_signature() call only if
+ * the key never signs raw messages starting with 0x01.
+ */
+
+#define SPX_PH_BYTES 64
+#define SPX_PH_OID_BYTES 11
+#define SPX_PH_MAX_CTX 255
+
+/* Computes PH(m). */
+#define spx_prehash SPX_NAMESPACE(spx_prehash)
+void spx_prehash(uint8_t *digest, const uint8_t *m, size_t mlen);
+
+/*
+ * Signs a digest already computed with spx_prehash() (or with PH elsewhere,
+ * e.g. through the descriptor ring) under context string ctx of at most
+ * SPX_PH_MAX_CTX bytes. Returns 0 on success, -1 otherwise.
+ */
+#define spx_sign_prehashed SPX_NAMESPACE(spx_sign_prehashed)
+int spx_sign_prehashed(uint8_t *sig, size_t *siglen,
+                       const uint8_t *digest,
+                       const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
+
+#define spx_verify_prehashed SPX_NAMESPACE(spx_verify_prehashed)
+int spx_verify_prehashed(const uint8_t *sig, size_t siglen,
+                         const uint8_t *digest,
+                         const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
+
+/* spx_prehash() followed by spx_sign_prehashed() / spx_verify_prehashed(). */
+#define spx_sign_prehash SPX_NAMESPACE(spx_sign_prehash)
+int spx_sign_prehash(uint8_t *sig, size_t *siglen,
+                     const uint8_t *m, size_t mlen,
+                     const uint8_t *ctx, size_t ctxlen, const uint8_t *sk);
+
+#define spx_verify_prehash SPX_NAMESPACE(spx_verify_prehash)
+int spx_verify_prehash(const uint8_t *sig, size_t siglen,
+                       const uint8_t *m, size_t mlen,
+                       const uint8_t *ctx, size_t ctxlen, const uint8_t *pk);
+
+#endif
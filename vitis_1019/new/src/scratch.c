@@ -0,0 +1,46 @@
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "scratch.h"
+
+static uint8_t scratch_arena[(SPX_SCRATCH_BYTES + SPX_SCRATCH_ALIGN - 1)
+                             & ~(size_t)(SPX_SCRATCH_ALIGN - 1)]
+    __attribute__((section(".bss.spx_scratch"), aligned(SPX_SCRATCH_ALIGN)));
+static size_t scratch_top;
+static size_t scratch_high;
+
+void *spx_scratch_alloc(size_t bytes)
+{
+    size_t top = scratch_top;
+
+    bytes = (bytes + SPX_SCRATCH_ALIGN - 1) & ~(size_t)(SPX_SCRATCH_ALIGN - 1);
+    if (bytes > sizeof(scratch_arena) - top) {
+        abort();
+    }
+
+    scratch_top = top + bytes;
+    if (scratch_top > scratch_high) {
+        scratch_high = scratch_top;
+    }
+    return scratch_arena + top;
+}
+
+void spx_scratch_free(void *p)
+{
+    scratch_top = (size_t)((uint8_t *)p - scratch_arena);
+}
+
+void spx_scratch_release(void *var)
+{
+    spx_scratch_free(*(void **)var);
+}
+
+size_t spx_scratch_high_water(void)
+{
+    return scratch_high;
+}
+
+void spx_scratch_reset_high_water(void)
+{
+    scratch_high = scratch_top;
+}
@@ -0,0 +1,72 @@
+#ifndef SPX_SCRATCH_H
+#define SPX_SCRATCH_H
+
+#include <stddef.h>
+
+#include "params.h"
+#include "hashdag.h"
+
+/*
+ * Scratch arena for the temporaries of thash(), treehashx1(), the WOTS and
+ * FORS routines and merkle_gen_root().
+ *
+ * With SPX_SCRATCH_ARENA defined, SPX_VLA (see utils.h) takes its buffers
+ * from one statically sized block instead of the stack. Allocation is LIFO,
+ * which matches the scoping of the buffers; each one is released when the
+ * variable goes out of scope (GCC cleanup attribute). This bounds the stack
+ * use of a signature to a few hundred bytes per frame and puts every hot
+ * temporary into a single cache-aligned block, which the linker script can
+ * move to OCM (the block lives in section .bss.spx_scratch).
+ *
+ * There is one arena: it must not be used by two jobs running at the same
+ * time (see parallel.h).
+ */
+#ifndef SPX_SCRATCH_ALIGN
+#define SPX_SCRATCH_ALIGN 32  /* Cortex-A9 L1/L2 cache line */
+#endif
+
+/*
+ * Upper bound over keygen, signing and verification: merkle_gen_root() keeps
+ * an auth path and a WOTS signature alive over treehashx1(), whose leaves hold
+ * a WOTS public key and a thash() input of the same size; fors_pk_from_sig()
+ * holds the roots and one window of leaves, root walks and graph nodes while
+ * spx_root_walks() adds a second window of nodes. Plus one alignment unit per
+ * buffer. spx_scratch_high_water() reports what a build really needs; define
+ * SPX_SCRATCH_BYTES to that to trim the arena.
+ */
+#ifndef SPX_SCRATCH_BYTES
+#define SPX_SCRATCH_BYTES (3 * SPX_WOTS_BYTES \
+                           + (2 * SPX_TREE_HEIGHT + SPX_FORS_TREES + 4) * SPX_N \
+                           + SPX_DAG_WINDOW * (sizeof(spx_root_walk) \
+                                               + 2 * sizeof(spx_hash_node)) \
+                           + 16 * SPX_SCRATCH_ALIGN)
+#endif
+
+/*
+ * Returns bytes (rounded up to SPX_SCRATCH_ALIGN) of arena memory. Running
+ * out of arena is a configuration error; the program is aborted.
+ */
+#define spx_scratch_alloc SPX_NAMESPACE(spx_scratch_alloc)
+void *spx_scratch_alloc(size_t bytes);
+
+/*
+ * Releases p and everything allocated after it.
+ */
+#define spx_scratch_free SPX_NAMESPACE(spx_scratch_free)
+void spx_scratch_free(void *p);
+
+/* Cleanup handler for SPX_VLA; var points to the buffer pointer. */
+#define spx_scratch_release SPX_NAMESPACE(spx_scratch_release)
+void spx_scratch_release(void *var);
+
+/*
+ * Largest number of arena bytes in use since the last reset. Resetting
+ * before an operation and reading afterwards gives that operation's need.
+ */
+#define spx_scratch_high_water SPX_NAMESPACE(spx_scratch_high_water)
+size_t spx_scratch_high_water(void);
+
+#define spx_scratch_reset_high_water SPX_NAMESPACE(spx_scratch_reset_high_water)
+void spx_scratch_reset_high_water(void);
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "utils.h"
 #include "sha2.h"
+#include "hashtrace.h"
 
 // --- @һ ---
 #include "fpga_sha_driver.h"
@@ -514,6 +515,7 @@ void sha256_inc_finalize(uint8_t *out, uint8_t *state, const uint8_t *in, size_t
     uint8_t padded[128];
     uint64_t bytes = load_bigendian_64(state + 32) + inlen;
 
+    SPX_TRACE_CALL(SPX_TRACE_SHA256, (size_t)bytes, (size_t)(bytes - inlen), 32);
     crypto_hashblocks_sha256(state, in, inlen);
     in += inlen;
     inlen &= 63;
@@ -562,6 +564,7 @@ void sha512_inc_finalize(uint8_t *out, uint8_t *state, const uint8_t *in, size_t
     uint8_t padded[256];
     uint64_t bytes = load_bigendian_64(state + 64) + inlen;
 
+    SPX_TRACE_CALL(SPX_TRACE_SHA512, (size_t)bytes, (size_t)(bytes - inlen), 64);
     crypto_hashblocks_sha512(state, in, inlen);
     in += inlen;
     inlen &= 127;
@@ -626,6 +629,7 @@ void sha512(uint8_t *out, const uint8_t *in, size_t inlen) {
 void sha256(uint8_t *out, const uint8_t *in, size_t inlen)
 {
     // --- QӲ{ ---
+    SPX_TRACE_CALL(SPX_TRACE_SHA256, inlen, 0, 32);
     sha256_hw(out, in, inlen);
 
 }
@@ -633,6 +637,7 @@ void sha256(uint8_t *out, const uint8_t *in, size_t inlen)
 void sha512(uint8_t *out, const uint8_t *in, size_t inlen)
 {
     // --- QӲ{ ---
+    SPX_TRACE_CALL(SPX_TRACE_SHA512, inlen, 0, 64);
     sha512_hw(out, in, inlen);
 
 }
@@ -709,9 +714,13 @@ void seed_state(spx_ctx *ctx) {
     }
     /* block has been properly initialized for both SHA-256 and SHA-512 */
 
+    /* Traced as blocks without a digest; thash and prf_addr go on from them. */
+    SPX_TRACE_SITE(SPX_SITE_SEED);
+    SPX_TRACE_CALL(SPX_TRACE_SHA256, SPX_SHA256_BLOCK_BYTES, 0, 0);
     sha256_inc_init(ctx->state_seeded);
     sha256_inc_blocks(ctx->state_seeded, block, 1);
 #if SPX_SHA512
+    SPX_TRACE_CALL(SPX_TRACE_SHA512, SPX_SHA512_BLOCK_BYTES, 0, 0);
     sha512_inc_init(ctx->state_seeded_512);
     sha512_inc_blocks(ctx->state_seeded_512, block, 1);
 #endif
@@ -12,6 +12,11 @@
 #include "randombytes.h"
 #include "utils.h"
 #include "merkle.h"
+#include "precomp.h"
+#include "vcache.h"
+#include "sign_ctx.h"
+#include "parallel.h"
+#include "hashtrace.h"
 
 /*
  * Returns the length of a secret key, in bytes
@@ -55,6 +60,8 @@ int crypto_sign_seed_keypair(unsigned char *pk, unsigned char *sk,
 {
     spx_ctx ctx;
 
+    SPX_TRACE_MARK("keygen");
+
     /* Initialize SK_SEED, SK_PRF and PUB_SEED from seed. */
     memcpy(sk, seed, CRYPTO_SEEDBYTES);
 
@@ -89,142 +96,396 @@ int crypto_sign_keypair(unsigned char *pk, unsigned char *sk)
   return 0;
 }
 
-/**
- * Returns an array containing a detached signature.
+int spx_sign_ctx_init(spx_sign_ctx *sctx, const uint8_t *sk)
+{
+    memcpy(sctx->hash.sk_seed, sk, SPX_N);
+    memcpy(sctx->sk_prf, sk + SPX_N, SPX_N);
+    memcpy(sctx->pk, sk + 2*SPX_N, SPX_PK_BYTES);
+    memcpy(sctx->hash.pub_seed, sctx->pk, SPX_N);
+    sctx->has_sk = 1;
+
+    /* This hook allows the hash function instantiation to do whatever
+       preparation or computation it needs, based on the public seed. */
+    initialize_hash_function(&sctx->hash);
+
+    sctx->precomp = spx_precomp_attached();
+    sctx->vcache = spx_vcache_attached();
+
+    return 0;
+}
+
+int spx_verify_ctx_init(spx_sign_ctx *sctx, const uint8_t *pk)
+{
+    memset(sctx->hash.sk_seed, 0, SPX_N);
+    memset(sctx->sk_prf, 0, SPX_N);
+    memcpy(sctx->pk, pk, SPX_PK_BYTES);
+    memcpy(sctx->hash.pub_seed, pk, SPX_N);
+    sctx->has_sk = 0;
+
+    initialize_hash_function(&sctx->hash);
+
+    sctx->precomp = 0;
+    sctx->vcache = spx_vcache_attached();
+
+    return 0;
+}
+
+int spx_sign_ctx_set_precomp(spx_sign_ctx *sctx,
+                             const uint8_t *blob, size_t bloblen)
+{
+    uint8_t sk[SPX_SK_BYTES];
+    int ret = 0;
+
+    if (blob) {
+        if (!sctx->has_sk) {
+            return -1;
+        }
+        memcpy(sk, sctx->hash.sk_seed, SPX_N);
+        memcpy(sk + SPX_N, sctx->sk_prf, SPX_N);
+        memcpy(sk + 2*SPX_N, sctx->pk, SPX_PK_BYTES);
+        ret = spx_precomp_check(blob, bloblen, sk);
+        memset(sk, 0, sizeof(sk));
+        if (ret) {
+            return -1;
+        }
+    }
+    sctx->precomp = blob;
+
+    return 0;
+}
+
+void spx_sign_ctx_set_vcache(spx_sign_ctx *sctx, spx_vcache *cache)
+{
+    sctx->vcache = cache;
+}
+
+/*
+ * Everything a signature needs apart from the WOTS signatures depends only
+ * on the message digest: FORS (job 0) and the auth path and root of every
+ * hypertree subtree (job 1 + layer). These are run as independent jobs;
+ * afterwards the layers are chained by signing each root with WOTS.
  */
-int crypto_sign_signature(uint8_t *sig, size_t *siglen,
-                          const uint8_t *m, size_t mlen, const uint8_t *sk)
+struct sign_jobs {
+    const spx_sign_ctx *sctx;
+    uint8_t *sig;
+    const unsigned char *mhash;
+    uint64_t tree[SPX_D];
+    uint32_t idx_leaf[SPX_D];
+    unsigned char roots[SPX_D + 1][SPX_N];
+};
+
+static void sign_job(void *arg, unsigned int job)
 {
-    spx_ctx ctx;
+    struct sign_jobs *jobs = (struct sign_jobs *)arg;
+    const spx_ctx *ctx = &jobs->sctx->hash;
+    uint32_t addr[8] = {0};
+    uint32_t layer;
+    uint8_t *auth_path;
+
+    if (job == 0) {
+        set_type(addr, SPX_ADDR_TYPE_WOTS);
+        set_tree_addr(addr, jobs->tree[0]);
+        set_keypair_addr(addr, jobs->idx_leaf[0]);
+
+        fors_sign(jobs->sig + SPX_N, jobs->roots[0], jobs->mhash, ctx, addr);
+        return;
+    }
 
-    const unsigned char *sk_prf = sk + SPX_N;
-    const unsigned char *pk = sk + 2*SPX_N;
+    layer = job - 1;
+    auth_path = jobs->sig + SPX_N + SPX_FORS_BYTES
+              + layer * (SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N)
+              + SPX_WOTS_BYTES;
+
+    /* Layers covered by an attached accelerator blob are lookups. */
+    if (spx_precomp_auth_path(jobs->sctx->precomp, auth_path,
+                              jobs->roots[job], jobs->sctx->pk, layer,
+                              jobs->tree[layer], jobs->idx_leaf[layer])) {
+        set_layer_addr(addr, layer);
+        set_tree_addr(addr, jobs->tree[layer]);
+        merkle_gen_auth(auth_path, jobs->roots[job], ctx, addr,
+                        jobs->idx_leaf[layer]);
+    }
+}
 
-    unsigned char optrand[SPX_N];
-    unsigned char mhash[SPX_FORS_MSG_BYTES];
-    unsigned char root[SPX_N];
-    uint32_t i;
+/*
+ * Computes R (into the signature) and the message digest, and from it the
+ * tree and leaf used on every layer.
+ */
+static void sign_digest(struct sign_jobs *jobs, const unsigned char *optrand,
+                        unsigned char *mhash, const uint8_t *m, size_t mlen)
+{
+    const spx_sign_ctx *sctx = jobs->sctx;
     uint64_t tree;
     uint32_t idx_leaf;
+    uint32_t i;
+
+    /* Compute the digest randomization value. */
+    gen_message_random(jobs->sig, sctx->sk_prf, optrand, m, mlen, &sctx->hash);
+
+    /* Derive the message digest and leaf index from R, PK and M. */
+    hash_message(mhash, &tree, &idx_leaf, jobs->sig, sctx->pk, m, mlen,
+                 &sctx->hash);
+
+    /* The digest fixes the tree and leaf used on every layer. */
+    for (i = 0; i < SPX_D; i++) {
+        jobs->tree[i] = tree;
+        jobs->idx_leaf[i] = idx_leaf;
+
+        idx_leaf = (tree & ((1 << SPX_TREE_HEIGHT)-1));
+        tree = tree >> SPX_TREE_HEIGHT;
+    }
+    jobs->mhash = mhash;
+}
+
+/* Signs the root of the layer below (the FORS pk for layer 0) with WOTS. */
+static void sign_wots_layer(const struct sign_jobs *jobs, uint32_t layer)
+{
     uint32_t wots_addr[8] = {0};
-    uint32_t tree_addr[8] = {0};
+    uint8_t *sig = jobs->sig + SPX_N + SPX_FORS_BYTES
+                 + layer * (SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N);
 
-    memcpy(ctx.sk_seed, sk, SPX_N);
-    memcpy(ctx.pub_seed, pk, SPX_N);
+    set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
+    set_layer_addr(wots_addr, layer);
+    set_tree_addr(wots_addr, jobs->tree[layer]);
+    set_keypair_addr(wots_addr, jobs->idx_leaf[layer]);
 
-    /* This hook allows the hash function instantiation to do whatever
-       preparation or computation it needs, based on the public seed. */
-    initialize_hash_function(&ctx);
+    wots_sign(sig, jobs->roots[layer], &jobs->sctx->hash, wots_addr);
+}
+
+/*
+ * The same signature with the layers built in order. merkle_sign() takes the
+ * WOTS signature from the chains it runs for the leaf anyway, where
+ * sign_wots_layer() would compute them a second time; with the serial runner
+ * nothing runs alongside, so this is the cheaper path.
+ */
+static void sign_layers_chained(struct sign_jobs *jobs)
+{
+    const spx_ctx *ctx = &jobs->sctx->hash;
+    uint32_t wots_addr[8] = {0};
+    uint32_t tree_addr[8] = {0};
+    uint8_t *sig = jobs->sig + SPX_N + SPX_FORS_BYTES;
+    uint32_t i;
+
+    sign_job(jobs, 0);
 
     set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
-    set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
+    for (i = 0; i < SPX_D; i++) {
+        set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
+        set_layer_addr(tree_addr, i);
+        set_tree_addr(tree_addr, jobs->tree[i]);
+
+        copy_subtree_addr(wots_addr, tree_addr);
+        set_keypair_addr(wots_addr, jobs->idx_leaf[i]);
+
+        /* Layers covered by an attached accelerator blob are lookups. */
+        if (spx_precomp_auth_path(jobs->sctx->precomp, sig + SPX_WOTS_BYTES,
+                                  jobs->roots[i + 1], jobs->sctx->pk, i,
+                                  jobs->tree[i], jobs->idx_leaf[i]) == 0) {
+            sign_wots_layer(jobs, i);
+        }
+        else {
+            memcpy(jobs->roots[i + 1], jobs->roots[i], SPX_N);
+            merkle_sign(sig, jobs->roots[i + 1], ctx, wots_addr, tree_addr,
+                        jobs->idx_leaf[i]);
+        }
+        sig += SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N;
+    }
+}
+
+int spx_sign_with_ctx(const spx_sign_ctx *sctx, uint8_t *sig, size_t *siglen,
+                      const uint8_t *m, size_t mlen)
+{
+    struct sign_jobs jobs;
+    unsigned char optrand[SPX_N];
+    unsigned char mhash[SPX_FORS_MSG_BYTES];
+    uint32_t i;
+
+    if (!sctx->has_sk) {
+        return -1;
+    }
 
     /* Optionally, signing can be made non-deterministic using optrand.
        This can help counter side-channel attacks that would benefit from
        getting a large number of traces when the signer uses the same nodes. */
     randombytes(optrand, SPX_N);
-    /* Compute the digest randomization value. */
-    gen_message_random(sig, sk_prf, optrand, m, mlen, &ctx);
 
-    /* Derive the message digest and leaf index from R, PK and M. */
-    hash_message(mhash, &tree, &idx_leaf, sig, pk, m, mlen, &ctx);
-    sig += SPX_N;
+    jobs.sctx = sctx;
+    jobs.sig = sig;
+    sign_digest(&jobs, optrand, mhash, m, mlen);
 
-    set_tree_addr(wots_addr, tree);
-    set_keypair_addr(wots_addr, idx_leaf);
+    if (spx_jobs_serial()) {
+        sign_layers_chained(&jobs);
+    }
+    else {
+        spx_run_jobs(sign_job, &jobs, 1 + SPX_D);
 
-    /* Sign the message hash using FORS. */
-    fors_sign(sig, root, mhash, &ctx, wots_addr);
-    sig += SPX_FORS_BYTES;
+        /* Chain the layers: sign each root with WOTS. */
+        for (i = 0; i < SPX_D; i++) {
+            sign_wots_layer(&jobs, i);
+        }
+    }
 
-    for (i = 0; i < SPX_D; i++) {
-        set_layer_addr(tree_addr, i);
-        set_tree_addr(tree_addr, tree);
+    *siglen = SPX_BYTES;
 
-        copy_subtree_addr(wots_addr, tree_addr);
-        set_keypair_addr(wots_addr, idx_leaf);
+    return 0;
+}
 
-        merkle_sign(sig, root, &ctx, wots_addr, tree_addr, idx_leaf);
-        sig += SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N;
+/*
+ * crypto_sign_many() keeps three signatures in flight. In every step one job
+ * batch holds the digest of message k+1, the FORS and subtree jobs of message
+ * k and the WOTS signatures of message k-1, which are all independent of each
+ * other. Slot state is static (it would not fit next to a signature on the
+ * 8 KiB stack), so crypto_sign_many() is not reentrant.
+ */
+#define SIGN_MANY_STAGES 3
 
-        /* Update the indices for the next layer. */
-        idx_leaf = (tree & ((1 << SPX_TREE_HEIGHT)-1));
-        tree = tree >> SPX_TREE_HEIGHT;
+struct sign_many_slot {
+    struct sign_jobs jobs;
+    unsigned char optrand[SPX_N];
+    unsigned char mhash[SPX_FORS_MSG_BYTES];
+    const uint8_t *m;
+    size_t mlen;
+};
+
+static struct {
+    struct sign_many_slot slot[SIGN_MANY_STAGES];
+    struct sign_many_slot *digest;   /* stage 0, or NULL */
+    struct sign_many_slot *trees;    /* stage 1, or NULL */
+    struct sign_many_slot *chains;   /* stage 2, or NULL */
+} sm;
+
+static void sign_many_job(void *arg, unsigned int job)
+{
+    (void)arg;
+
+    if (sm.digest) {
+        if (job == 0) {
+            sign_digest(&sm.digest->jobs, sm.digest->optrand,
+                        sm.digest->mhash, sm.digest->m, sm.digest->mlen);
+            return;
+        }
+        job--;
+    }
+    if (sm.trees) {
+        if (job < 1 + SPX_D) {
+            sign_job(&sm.trees->jobs, job);
+            return;
+        }
+        job -= 1 + SPX_D;
     }
+    sign_wots_layer(&sm.chains->jobs, job);
+}
 
-    *siglen = SPX_BYTES;
+int crypto_sign_many(uint8_t *const *sigs, size_t *siglens,
+                     const uint8_t *const *ms, const size_t *mlens,
+                     size_t n, const uint8_t *sk)
+{
+    spx_sign_ctx sctx;
+    struct sign_many_slot *slot;
+    unsigned int njobs;
+    size_t t;
+
+    spx_sign_ctx_init(&sctx, sk);
+
+    /* Without a concurrent runner the stages gain nothing. */
+    if (spx_jobs_serial()) {
+        for (t = 0; t < n; t++) {
+            spx_sign_with_ctx(&sctx, sigs[t], &siglens[t], ms[t], mlens[t]);
+        }
+        return 0;
+    }
+
+    for (t = 0; t < n + SIGN_MANY_STAGES - 1; t++) {
+        sm.digest = 0;
+        sm.trees = 0;
+        sm.chains = 0;
+        njobs = 0;
+
+        if (t < n) {
+            slot = &sm.slot[t % SIGN_MANY_STAGES];
+            slot->jobs.sctx = &sctx;
+            slot->jobs.sig = sigs[t];
+            slot->m = ms[t];
+            slot->mlen = mlens[t];
+            /* Drawn here, in message order: the RNG need not be shared
+               with the jobs. */
+            randombytes(slot->optrand, SPX_N);
+            sm.digest = slot;
+            njobs += 1;
+        }
+        if (t >= 1 && t - 1 < n) {
+            sm.trees = &sm.slot[(t - 1) % SIGN_MANY_STAGES];
+            njobs += 1 + SPX_D;
+        }
+        if (t >= 2 && t - 2 < n) {
+            sm.chains = &sm.slot[(t - 2) % SIGN_MANY_STAGES];
+            njobs += SPX_D;
+        }
+
+        spx_run_jobs(sign_many_job, 0, njobs);
+
+        if (sm.chains) {
+            siglens[t - 2] = SPX_BYTES;
+        }
+    }
 
     return 0;
 }
 
-/**
- * Verifies a detached signature and message under a given public key.
- */
-int crypto_sign_verify(const uint8_t *sig, size_t siglen,
-                       const uint8_t *m, size_t mlen, const uint8_t *pk)
+int spx_verify_with_ctx(const spx_sign_ctx *sctx,
+                        const uint8_t *sig, size_t siglen,
+                        const uint8_t *m, size_t mlen)
 {
-    spx_ctx ctx;
+    const spx_ctx *ctx = &sctx->hash;
+    const unsigned char *pk = sctx->pk;
     const unsigned char *pub_root = pk + SPX_N;
     unsigned char mhash[SPX_FORS_MSG_BYTES];
-    unsigned char wots_pk[SPX_WOTS_BYTES];
     unsigned char root[SPX_N];
-    unsigned char leaf[SPX_N];
     unsigned int i;
     uint64_t tree;
     uint32_t idx_leaf;
     uint32_t wots_addr[8] = {0};
-    uint32_t tree_addr[8] = {0};
-    uint32_t wots_pk_addr[8] = {0};
+    spx_vcache *vcache = sctx->vcache;
+    unsigned char vc_digests[SPX_D][SPX_N];
+    unsigned char vc_keys[SPX_D][SPX_N];
 
     if (siglen != SPX_BYTES) {
         return -1;
     }
 
-    memcpy(ctx.pub_seed, pk, SPX_N);
-
-    /* This hook allows the hash function instantiation to do whatever
-       preparation or computation it needs, based on the public seed. */
-    initialize_hash_function(&ctx);
-
     set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
-    set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
-    set_type(wots_pk_addr, SPX_ADDR_TYPE_WOTSPK);
 
     /* Derive the message digest and leaf index from R || PK || M. */
     /* The additional SPX_N is a result of the hash domain separator. */
-    hash_message(mhash, &tree, &idx_leaf, sig, pk, m, mlen, &ctx);
+    hash_message(mhash, &tree, &idx_leaf, sig, pk, m, mlen, ctx);
     sig += SPX_N;
 
     /* Layer correctly defaults to 0, so no need to set_layer_addr */
     set_tree_addr(wots_addr, tree);
     set_keypair_addr(wots_addr, idx_leaf);
 
-    fors_pk_from_sig(root, sig, mhash, &ctx, wots_addr);
+    fors_pk_from_sig(root, sig, mhash, ctx, wots_addr);
     sig += SPX_FORS_BYTES;
 
+    if (vcache) {
+        spx_vcache_digests(vc_digests, sig);
+    }
+
     /* For each subtree.. */
     for (i = 0; i < SPX_D; i++) {
-        set_layer_addr(tree_addr, i);
-        set_tree_addr(tree_addr, tree);
+        /* A known-good transition means the remaining layers verify. */
+        if (vcache) {
+            spx_vcache_key(vc_keys[i], pk, i, tree, idx_leaf, root,
+                           vc_digests[i]);
+            if (spx_vcache_lookup(vcache, vc_keys[i])) {
+                return 0;
+            }
+        }
 
-        copy_subtree_addr(wots_addr, tree_addr);
-        set_keypair_addr(wots_addr, idx_leaf);
-
-        copy_keypair_addr(wots_pk_addr, wots_addr);
-
-        /* The WOTS public key is only correct if the signature was correct. */
         /* Initially, root is the FORS pk, but on subsequent iterations it is
            the root of the subtree below the currently processed subtree. */
-        wots_pk_from_sig(wots_pk, sig, root, &ctx, wots_addr);
-        sig += SPX_WOTS_BYTES;
-
-        /* Compute the leaf node using the WOTS public key. */
-        thash(leaf, wots_pk, SPX_WOTS_LEN, &ctx, wots_pk_addr);
-
-        /* Compute the root node of this subtree. */
-        compute_root(root, leaf, idx_leaf, 0, sig, SPX_TREE_HEIGHT,
-                     &ctx, tree_addr);
-        sig += SPX_TREE_HEIGHT * SPX_N;
+        merkle_root_from_sig(root, sig, root, ctx, i, tree, idx_leaf);
+        sig += SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N;
 
         /* Update the indices for the next layer. */
         idx_leaf = (tree & ((1 << SPX_TREE_HEIGHT)-1));
@@ -236,9 +497,46 @@ int crypto_sign_verify(const uint8_t *sig, size_t siglen,
         return -1;
     }
 
+    if (vcache) {
+        for (i = 0; i < SPX_D; i++) {
+            spx_vcache_insert(vcache, vc_keys[i]);
+        }
+    }
+
     return 0;
 }
 
+/**
+ * Returns an array containing a detached signature.
+ */
+int crypto_sign_signature(uint8_t *sig, size_t *siglen,
+                          const uint8_t *m, size_t mlen, const uint8_t *sk)
+{
+    spx_sign_ctx sctx;
+
+    SPX_TRACE_MARK("sign");
+    spx_sign_ctx_init(&sctx, sk);
+
+    return spx_sign_with_ctx(&sctx, sig, siglen, m, mlen);
+}
+
+/**
+ * Verifies a detached signature and message under a given public key.
+ */
+int crypto_sign_verify(const uint8_t *sig, size_t siglen,
+                       const uint8_t *m, size_t mlen, const uint8_t *pk)
+{
+    spx_sign_ctx sctx;
+
+    if (siglen != SPX_BYTES) {
+        return -1;
+    }
+
+    SPX_TRACE_MARK("verify");
+    spx_verify_ctx_init(&sctx, pk);
+
+    return spx_verify_with_ctx(&sctx, sig, siglen, m, mlen);
+}
 
 /**
  * Returns an array containing the signature followed by the message.
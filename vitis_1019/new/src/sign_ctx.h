@@ -0,0 +1,72 @@
+#ifndef SPX_SIGN_CTX_H
+#define SPX_SIGN_CTX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "params.h"
+#include "context.h"
+#include "vcache.h"
+
+/*
+ * Per-key signing / verification context.
+ *
+ * crypto_sign_signature() and crypto_sign_verify() set up the hash function
+ * state (seed_state() for SHA-2, tweak_constants() for Haraka) on every call.
+ * A context does that once per key; spx_sign_with_ctx() and
+ * spx_verify_with_ctx() then only read it, so one context can serve any
+ * number of calls.
+ */
+typedef struct {
+    spx_ctx hash;
+    uint8_t sk_prf[SPX_N];
+    uint8_t pk[SPX_PK_BYTES];
+    int has_sk;
+
+    /* Optional attachments; NULL when not in use. */
+    const uint8_t *precomp;   /* accelerator blob, see precomp.h */
+    spx_vcache *vcache;       /* verification cache, see vcache.h */
+} spx_sign_ctx;
+
+/*
+ * Initializes a context for signing (and verifying) under sk.
+ * Blobs or caches attached globally at this point are inherited.
+ */
+#define spx_sign_ctx_init SPX_NAMESPACE(spx_sign_ctx_init)
+int spx_sign_ctx_init(spx_sign_ctx *sctx, const uint8_t *sk);
+
+/*
+ * Initializes a verification-only context for pk.
+ */
+#define spx_verify_ctx_init SPX_NAMESPACE(spx_verify_ctx_init)
+int spx_verify_ctx_init(spx_sign_ctx *sctx, const uint8_t *pk);
+
+/*
+ * Attaches (or, with blob NULL, removes) an accelerator blob.
+ * Returns -1 if spx_precomp_check() rejects the blob for the context's key
+ * (always for a verification-only context), 0 otherwise.
+ */
+#define spx_sign_ctx_set_precomp SPX_NAMESPACE(spx_sign_ctx_set_precomp)
+int spx_sign_ctx_set_precomp(spx_sign_ctx *sctx,
+                             const uint8_t *blob, size_t bloblen);
+
+#define spx_sign_ctx_set_vcache SPX_NAMESPACE(spx_sign_ctx_set_vcache)
+void spx_sign_ctx_set_vcache(spx_sign_ctx *sctx, spx_vcache *cache);
+
+/*
+ * Same as crypto_sign_signature() with the key taken from sctx.
+ * Returns -1 for a verification-only context.
+ */
+#define spx_sign_with_ctx SPX_NAMESPACE(spx_sign_with_ctx)
+int spx_sign_with_ctx(const spx_sign_ctx *sctx, uint8_t *sig, size_t *siglen,
+                      const uint8_t *m, size_t mlen);
+
+/*
+ * Same as crypto_sign_verify() with the key taken from sctx.
+ */
+#define spx_verify_with_ctx SPX_NAMESPACE(spx_verify_with_ctx)
+int spx_verify_with_ctx(const spx_sign_ctx *sctx,
+                        const uint8_t *sig, size_t siglen,
+                        const uint8_t *m, size_t mlen);
+
+#endif
@@ -0,0 +1,107 @@
+#include <stddef.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "params.h"
+#include "wots.h"
+#include "fors.h"
+#include "hash.h"
+#include "address.h"
+#include "randombytes.h"
+#include "merkle.h"
+#include "precomp.h"
+#include "utils.h"
+#include "sign_stream.h"
+
+int spx_sign_stream(const spx_sign_ctx *sctx, const uint8_t *m, size_t mlen,
+                    spx_sig_sink sink, void *arg)
+{
+    const spx_ctx *ctx = &sctx->hash;
+
+    unsigned char optrand[SPX_N];
+    unsigned char R[SPX_N];
+    unsigned char mhash[SPX_FORS_MSG_BYTES];
+    SPX_VLA(unsigned char, roots, SPX_FORS_TREES * SPX_N);
+    SPX_VLA(unsigned char, fors_part, (SPX_FORS_HEIGHT + 1) * SPX_N);
+    unsigned char root[SPX_N];
+    unsigned char next_root[SPX_N];
+    unsigned char auth_path[SPX_TREE_HEIGHT * SPX_N];
+    unsigned char chains[SPX_SIGN_STREAM_CHAINS * SPX_N];
+    unsigned int lengths[SPX_WOTS_LEN];
+    uint32_t i, j, pending;
+    uint64_t tree;
+    uint32_t idx_leaf;
+    uint32_t wots_addr[8] = {0};
+    uint32_t tree_addr[8] = {0};
+
+    if (!sctx->has_sk) {
+        return -1;
+    }
+
+    /* Optionally, signing can be made non-deterministic using optrand.
+       This can help counter side-channel attacks that would benefit from
+       getting a large number of traces when the signer uses the same nodes. */
+    randombytes(optrand, SPX_N);
+    /* Compute the digest randomization value. */
+    gen_message_random(R, sctx->sk_prf, optrand, m, mlen, ctx);
+    if (sink(arg, R, SPX_N)) {
+        return -1;
+    }
+
+    /* Derive the message digest and leaf index from R, PK and M. */
+    hash_message(mhash, &tree, &idx_leaf, R, sctx->pk, m, mlen, ctx);
+
+    set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
+    set_tree_addr(wots_addr, tree);
+    set_keypair_addr(wots_addr, idx_leaf);
+
+    /* Sign the message hash using FORS, one tree at a time. */
+    for (i = 0; i < SPX_FORS_TREES; i++) {
+        fors_sign_tree(fors_part, roots + i*SPX_N, mhash, i, ctx, wots_addr);
+        if (sink(arg, fors_part, (SPX_FORS_HEIGHT + 1) * SPX_N)) {
+            return -1;
+        }
+    }
+    fors_pk_from_roots(root, roots, ctx, wots_addr);
+
+    for (i = 0; i < SPX_D; i++) {
+        memset(tree_addr, 0, sizeof(tree_addr));
+        set_layer_addr(tree_addr, i);
+        set_tree_addr(tree_addr, tree);
+
+        memset(wots_addr, 0, sizeof(wots_addr));
+        copy_subtree_addr(wots_addr, tree_addr);
+        set_keypair_addr(wots_addr, idx_leaf);
+
+        /* The auth path is emitted after the WOTS signature, but is
+           computed first so that root can be overwritten. */
+        if (spx_precomp_auth_path(sctx->precomp, auth_path, next_root,
+                                  sctx->pk, i, tree, idx_leaf)) {
+            merkle_gen_auth(auth_path, next_root, ctx, tree_addr, idx_leaf);
+        }
+
+        /* Sign the root of the layer below (the FORS pk for layer 0). */
+        chain_lengths(lengths, root);
+        for (j = 0, pending = 0; j < SPX_WOTS_LEN; j++) {
+            wots_sign_chain(chains + pending*SPX_N, lengths, j, ctx,
+                            wots_addr);
+            pending++;
+            if (pending == SPX_SIGN_STREAM_CHAINS || j == SPX_WOTS_LEN - 1) {
+                if (sink(arg, chains, pending * SPX_N)) {
+                    return -1;
+                }
+                pending = 0;
+            }
+        }
+        if (sink(arg, auth_path, sizeof(auth_path))) {
+            return -1;
+        }
+        memcpy(root, next_root, SPX_N);
+
+        /* Update the indices for the next layer. */
+        idx_leaf = (tree & ((1 << SPX_TREE_HEIGHT)-1));
+        tree = tree >> SPX_TREE_HEIGHT;
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef SPX_SIGN_STREAM_H
+#define SPX_SIGN_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "params.h"
+#include "sign_ctx.h"
+
+/*
+ * Receives the next len bytes of a signature (e.g. a UART/DMA transmitter or
+ * a file writer). Returns 0 to continue, anything else to abort signing.
+ */
+typedef int (*spx_sig_sink)(void *arg, const uint8_t *data, size_t len);
+
+/* Number of WOTS chain values collected before they are handed to the sink. */
+#ifndef SPX_SIGN_STREAM_CHAINS
+#define SPX_SIGN_STREAM_CHAINS 8
+#endif
+
+/*
+ * Same signature as spx_sign_with_ctx(), but emitted through sink in order:
+ * R, each FORS tree, then each hypertree layer (WOTS signature, then auth
+ * path), each part as soon as it is final. Only a few hundred bytes of the
+ * signature are held at any time.
+ * Returns 0 on success, -1 for a verification-only context or if the sink
+ * aborted.
+ */
+#define spx_sign_stream SPX_NAMESPACE(spx_sign_stream)
+int spx_sign_stream(const spx_sign_ctx *sctx, const uint8_t *m, size_t mlen,
+                    spx_sig_sink sink, void *arg);
+
+#endif
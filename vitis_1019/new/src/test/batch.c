@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../api.h"
+#include "../params.h"
+#include "../randombytes.h"
+#include "../batch_sign.h"
+
+#define SPX_MLEN 32
+#define SPX_BATCH_N 4
+
+int main(void)
+{
+    int ret = 0;
+    int i;
+
+    /* Make stdout buffer more responsive. */
+    setbuf(stdout, NULL);
+
+    unsigned char pk[SPX_PK_BYTES];
+    unsigned char sk[SPX_SK_BYTES];
+    unsigned char m[SPX_BATCH_N][SPX_MLEN];
+    uint8_t *sigs[SPX_BATCH_N];
+    uint8_t *proofs[SPX_BATCH_N];
+    const uint8_t *ms[SPX_BATCH_N];
+    const uint8_t *csigs[SPX_BATCH_N];
+    const uint8_t *pks[SPX_BATCH_N];
+    size_t mlens[SPX_BATCH_N];
+    size_t siglens[SPX_BATCH_N];
+    int results[SPX_BATCH_N];
+    size_t prooflen = spx_batch_proof_bytes(SPX_BATCH_N);
+    size_t siglen;
+
+    crypto_sign_keypair(pk, sk);
+    randombytes(m[0], sizeof(m));
+    for (i = 0; i < SPX_BATCH_N; i++) {
+        sigs[i] = malloc(SPX_BYTES);
+        proofs[i] = malloc(prooflen);
+        ms[i] = m[i];
+        csigs[i] = sigs[i];
+        pks[i] = pk;
+        mlens[i] = SPX_MLEN;
+    }
+
+    printf("Testing crypto_sign_many.. ");
+    crypto_sign_many(sigs, siglens, ms, mlens, SPX_BATCH_N, sk);
+    for (i = 0; i < SPX_BATCH_N; i++) {
+        if (siglens[i] != SPX_BYTES ||
+                crypto_sign_verify(sigs[i], siglens[i], m[i], SPX_MLEN, pk)) {
+            printf("  X signature %d does not verify!\n", i);
+            ret = -1;
+        }
+    }
+    printf("done.\n");
+
+    printf("Testing crypto_sign_verify_batch.. ");
+    sigs[2][SPX_BYTES - 1] ^= 1;
+    m[1][0] ^= 1;
+    crypto_sign_verify_batch(csigs, siglens, ms, mlens, pks, SPX_BATCH_N,
+                             results);
+    for (i = 0; i < SPX_BATCH_N; i++) {
+        if (results[i] !=
+                crypto_sign_verify(sigs[i], siglens[i], m[i], SPX_MLEN, pk)) {
+            printf("  X result %d differs from crypto_sign_verify!\n", i);
+            ret = -1;
+        }
+    }
+    if (results[0] || !results[1] || !results[2] || results[3]) {
+        printf("  X unexpected batch results!\n");
+        ret = -1;
+    }
+    sigs[2][SPX_BYTES - 1] ^= 1;
+    m[1][0] ^= 1;
+    printf("done.\n");
+
+    printf("Testing batch signatures.. ");
+    if (spx_batch_sign(sigs[0], &siglen, proofs, ms, mlens, SPX_BATCH_N, sk)) {
+        printf("failed!\n");
+        return -1;
+    }
+    for (i = 0; i < SPX_BATCH_N; i++) {
+        if (spx_batch_verify(sigs[0], siglen, proofs[i], prooflen,
+                             m[i], SPX_MLEN, pk)) {
+            printf("  X message %d does not verify!\n", i);
+            ret = -1;
+        }
+    }
+    if (!spx_batch_verify(sigs[0], siglen, proofs[0], prooflen,
+                          m[1], SPX_MLEN, pk)) {
+        printf("  X proof accepted for another message!\n");
+        ret = -1;
+    }
+    proofs[1][prooflen - 1] ^= 1;
+    if (!spx_batch_verify(sigs[0], siglen, proofs[1], prooflen,
+                          m[1], SPX_MLEN, pk)) {
+        printf("  X modified proof accepted!\n");
+        ret = -1;
+    }
+    printf("done.\n");
+
+    for (i = 0; i < SPX_BATCH_N; i++) {
+        free(sigs[i]);
+        free(proofs[i]);
+    }
+
+    return ret;
+}
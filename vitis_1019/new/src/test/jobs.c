@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../api.h"
+#include "../params.h"
+#include "../randombytes.h"
+#include "../sign_ctx.h"
+#include "../host/host_jobs.h"
+
+#define SPX_MLEN 32
+#define SPX_JOBS_WORKERS 4
+#define SPX_MANY_N 5
+
+/* Jobs the workers have run so far */
+static unsigned long jobs_run(void)
+{
+    unsigned long jobs = 0;
+    unsigned int i;
+
+    for (i = 0; i < SPX_JOBS_WORKERS; i++) {
+        jobs += host_jobs_count(i);
+    }
+    return jobs;
+}
+
+int main(void)
+{
+    int ret = 0;
+    int i;
+
+    /* Make stdout buffer more responsive. */
+    setbuf(stdout, NULL);
+
+    unsigned char pk[SPX_PK_BYTES];
+    unsigned char sk[SPX_SK_BYTES];
+    unsigned char m[SPX_MANY_N][SPX_MLEN];
+    uint8_t *sigs[SPX_MANY_N];
+    const uint8_t *ms[SPX_MANY_N];
+    size_t mlens[SPX_MANY_N];
+    size_t siglens[SPX_MANY_N];
+    unsigned char *sig;
+    spx_sign_ctx sctx;
+    unsigned long jobs;
+    size_t siglen;
+
+    crypto_sign_keypair(pk, sk);
+    spx_sign_ctx_init(&sctx, sk);
+    randombytes(m[0], sizeof(m));
+    for (i = 0; i < SPX_MANY_N; i++) {
+        sigs[i] = malloc(SPX_BYTES);
+        ms[i] = m[i];
+        mlens[i] = SPX_MLEN;
+    }
+    sig = sigs[0];
+
+    if (host_jobs_start(SPX_JOBS_WORKERS)) {
+        printf("Starting %d workers failed!\n", SPX_JOBS_WORKERS);
+        return -1;
+    }
+    spx_set_job_runner(host_jobs_run);
+
+    printf("Testing signatures from %d workers.. ", SPX_JOBS_WORKERS);
+    spx_sign_with_ctx(&sctx, sig, &siglen, m[0], SPX_MLEN);
+    /* The FORS trees and one subtree per layer, as separate jobs */
+    if (jobs_run() != 1 + SPX_D) {
+        printf("  X %lu jobs ran on the workers, not %d!\n",
+               jobs_run(), 1 + SPX_D);
+        ret = -1;
+    }
+    if (siglen != SPX_BYTES ||
+            crypto_sign_verify(sig, siglen, m[0], SPX_MLEN, pk)) {
+        printf("  X signature does not verify!\n");
+        ret = -1;
+    }
+    sig[SPX_BYTES - 1] ^= 1;
+    if (!crypto_sign_verify(sig, siglen, m[0], SPX_MLEN, pk)) {
+        printf("  X modified signature accepted!\n");
+        ret = -1;
+    }
+    printf("done.\n");
+
+    printf("Testing crypto_sign_many from %d workers.. ", SPX_JOBS_WORKERS);
+    jobs = jobs_run();
+    crypto_sign_many(sigs, siglens, ms, mlens, SPX_MANY_N, sk);
+    /* Per message one digest, 1 + SPX_D tree jobs and SPX_D WOTS layers */
+    jobs = jobs_run() - jobs;
+    if (jobs != SPX_MANY_N * (2 + 2 * SPX_D)) {
+        printf("  X %lu jobs ran on the workers, not %d!\n",
+               jobs, SPX_MANY_N * (2 + 2 * SPX_D));
+        ret = -1;
+    }
+    for (i = 0; i < SPX_MANY_N; i++) {
+        if (siglens[i] != SPX_BYTES ||
+                crypto_sign_verify(sigs[i], siglens[i], m[i], SPX_MLEN, pk)) {
+            printf("  X signature %d does not verify!\n", i);
+            ret = -1;
+        }
+    }
+    printf("done.\n");
+
+    spx_set_job_runner(NULL);
+    host_jobs_stop();
+
+    for (i = 0; i < SPX_MANY_N; i++) {
+        free(sigs[i]);
+    }
+
+    return ret;
+}
@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "../api.h"
+#include "../params.h"
+#include "../randombytes.h"
+#include "../hashdag_hw.h"
+#include "../host/hw_model.h"
+
+#define SPX_MLEN 32
+#define SPX_KERNEL_SIGS 3
+
+static spx_hw_ring_area area;
+
+static unsigned char pk[SPX_KERNEL_SIGS][SPX_PK_BYTES];
+static unsigned char sk[SPX_KERNEL_SIGS][SPX_SK_BYTES];
+static unsigned char m[SPX_KERNEL_SIGS][SPX_MLEN];
+static unsigned char sig[SPX_KERNEL_SIGS][SPX_BYTES];
+
+/* IP jobs of all modes so far */
+static unsigned long long ip_jobs(void)
+{
+    unsigned long long jobs = 0;
+    hw_model_stats st;
+    unsigned int i;
+
+    hw_model_get_stats(&st);
+    for (i = 0; i < 16; i++) {
+        jobs += st.mode[i].jobs;
+    }
+    return jobs;
+}
+
+/* Verifies and signs through the installed kernel, then removes it. */
+static int check_kernel(const char *name)
+{
+    const uint8_t *sigs[SPX_KERNEL_SIGS], *ms[SPX_KERNEL_SIGS];
+    const uint8_t *pks[SPX_KERNEL_SIGS];
+    size_t siglens[SPX_KERNEL_SIGS], mlens[SPX_KERNEL_SIGS];
+    int results[SPX_KERNEL_SIGS];
+    unsigned long long jobs;
+    size_t siglen;
+    int ret = 0;
+    int i;
+
+    for (i = 0; i < SPX_KERNEL_SIGS; i++) {
+        sigs[i] = sig[i];
+        ms[i] = m[i];
+        pks[i] = pk[i];
+        siglens[i] = SPX_BYTES;
+        mlens[i] = SPX_MLEN;
+    }
+
+    printf("Testing verification through the %s.. ", name);
+    jobs = ip_jobs();
+    for (i = 0; i < SPX_KERNEL_SIGS; i++) {
+        if (crypto_sign_verify(sig[i], SPX_BYTES, m[i], SPX_MLEN, pk[i])) {
+            printf("  X signature %d does not verify!\n", i);
+            ret = -1;
+        }
+    }
+    /* Every WOTS chain step is an IP job */
+    if (ip_jobs() - jobs < SPX_KERNEL_SIGS * SPX_WOTS_LEN) {
+        printf("  X the kernel ran only %llu jobs!\n", ip_jobs() - jobs);
+        ret = -1;
+    }
+    sig[0][SPX_BYTES - 1] ^= 1;
+    if (!crypto_sign_verify(sig[0], SPX_BYTES, m[0], SPX_MLEN, pk[0])) {
+        printf("  X modified signature accepted!\n");
+        ret = -1;
+    }
+    printf("done.\n");
+
+    /* Lanes with different keys in one batch */
+    printf("Testing batch verification through the %s.. ", name);
+    if (!crypto_sign_verify_batch(sigs, siglens, ms, mlens, pks,
+                                  SPX_KERNEL_SIGS, results) ||
+            results[0] == 0 || results[1] || results[2]) {
+        printf("  X wrong results %d %d %d!\n",
+               results[0], results[1], results[2]);
+        ret = -1;
+    }
+    printf("done.\n");
+
+    printf("Testing a signature made through the %s.. ", name);
+    crypto_sign_signature(sig[0], &siglen, m[0], SPX_MLEN, sk[0]);
+    spx_set_hash_kernel(NULL, 0);
+    if (siglen != SPX_BYTES ||
+            crypto_sign_verify(sig[0], siglen, m[0], SPX_MLEN, pk[0])) {
+        printf("  X signature does not verify!\n");
+        ret = -1;
+    }
+    printf("done.\n");
+
+    return ret;
+}
+
+int main(void)
+{
+    int ret = 0;
+    size_t siglen;
+    int i;
+
+    /* Make stdout buffer more responsive. */
+    setbuf(stdout, NULL);
+
+    randombytes(m[0], sizeof(m));
+    for (i = 0; i < SPX_KERNEL_SIGS; i++) {
+        crypto_sign_keypair(pk[i], sk[i]);
+        crypto_sign_signature(sig[i], &siglen, m[i], SPX_MLEN, sk[i]);
+    }
+
+    if (hw_model_dma_map(&area, sizeof(area)) ||
+            spx_hw_ring_install(&area, 1 << SPX_HW_RING_ORDER)) {
+        printf("Setting up the descriptor ring failed!\n");
+        return -1;
+    }
+    ret |= check_kernel("descriptor ring");
+
+    if (spx_hw_sha2_tags_install() == 0) {
+        ret |= check_kernel("SHA-2 tag queue");
+    }
+
+    return ret;
+}
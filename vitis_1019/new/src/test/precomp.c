@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../api.h"
+#include "../params.h"
+#include "../randombytes.h"
+#include "../precomp.h"
+#include "../sign_ctx.h"
+
+#define SPX_MLEN 32
+#define SPX_PRECOMP_LAYERS 1
+
+int main(void)
+{
+    int ret = 0;
+
+    /* Make stdout buffer more responsive. */
+    setbuf(stdout, NULL);
+
+    unsigned char pk[SPX_PK_BYTES];
+    unsigned char sk[SPX_SK_BYTES];
+    unsigned char pk2[SPX_PK_BYTES];
+    unsigned char sk2[SPX_SK_BYTES];
+    unsigned char seed[CRYPTO_SEEDBYTES];
+    unsigned char m[SPX_MLEN];
+    unsigned char *sig = malloc(SPX_BYTES);
+    size_t bloblen = spx_precomp_bytes(SPX_PRECOMP_LAYERS);
+    uint8_t *blob = malloc(bloblen);
+    size_t siglen;
+    spx_sign_ctx sctx;
+
+    randombytes(seed, CRYPTO_SEEDBYTES);
+    randombytes(m, SPX_MLEN);
+
+    printf("Generating keypair with accelerator blob.. ");
+    if (spx_precomp_seed_keypair(pk, sk, seed, blob, bloblen,
+                                 SPX_PRECOMP_LAYERS)) {
+        printf("failed!\n");
+        return -1;
+    }
+    crypto_sign_seed_keypair(pk2, sk2, seed);
+    if (memcmp(pk, pk2, SPX_PK_BYTES) || memcmp(sk, sk2, SPX_SK_BYTES)) {
+        printf("keys differ from crypto_sign_seed_keypair!\n");
+        return -1;
+    }
+    printf("successful.\n");
+
+    if (spx_precomp_attach(blob, bloblen, sk)) {
+        printf("  X blob rejected!\n");
+        ret = -1;
+    }
+    crypto_sign_signature(sig, &siglen, m, SPX_MLEN, sk);
+    if (crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X signature with blob does not verify!\n");
+        ret = -1;
+    }
+    else {
+        printf("    signature with blob verifies.\n");
+    }
+    spx_precomp_detach();
+
+    /* A changed node (e.g. edited on the SD card) must be caught. */
+    blob[SPX_PRECOMP_HEADER_BYTES + SPX_N] ^= 1;
+    if (!spx_precomp_check(blob, bloblen, sk) ||
+            !spx_precomp_attach(blob, bloblen, sk) ||
+            spx_precomp_attached()) {
+        printf("  X corrupted blob accepted!\n");
+        ret = -1;
+    }
+    else {
+        printf("    corrupted blob rejected.\n");
+    }
+    blob[SPX_PRECOMP_HEADER_BYTES + SPX_N] ^= 1;
+
+    /* The first and the last byte of the MAC, with the others intact. */
+    blob[bloblen - SPX_N] ^= 1;
+    if (!spx_precomp_check(blob, bloblen, sk)) {
+        printf("  X blob with a wrong MAC accepted!\n");
+        ret = -1;
+    }
+    blob[bloblen - SPX_N] ^= 1;
+    blob[bloblen - 1] ^= 1;
+    if (!spx_precomp_check(blob, bloblen, sk)) {
+        printf("  X blob with a wrong MAC accepted!\n");
+        ret = -1;
+    }
+    blob[bloblen - 1] ^= 1;
+
+    /* A blob belongs to one key only. */
+    sk2[0] ^= 1;
+    sk2[SPX_N] ^= 1;
+    if (!spx_precomp_check(blob, bloblen, sk2)) {
+        printf("  X blob accepted for another secret key!\n");
+        ret = -1;
+    }
+    if (!spx_precomp_check(blob, bloblen - 1, sk)) {
+        printf("  X truncated blob accepted!\n");
+        ret = -1;
+    }
+
+    spx_verify_ctx_init(&sctx, pk);
+    if (!spx_sign_ctx_set_precomp(&sctx, blob, bloblen)) {
+        printf("  X blob accepted by a verification-only context!\n");
+        ret = -1;
+    }
+    spx_sign_ctx_init(&sctx, sk);
+    if (spx_sign_ctx_set_precomp(&sctx, blob, bloblen) ||
+            spx_sign_with_ctx(&sctx, sig, &siglen, m, SPX_MLEN) ||
+            crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X signing context with blob failed!\n");
+        ret = -1;
+    }
+    else {
+        printf("    signing context with blob verifies.\n");
+    }
+
+    free(sig);
+    free(blob);
+
+    return ret;
+}
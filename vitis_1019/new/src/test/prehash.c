@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../api.h"
+#include "../params.h"
+#include "../randombytes.h"
+#include "../prehash.h"
+
+#define SPX_MLEN 100
+
+int main(void)
+{
+    int ret = 0;
+
+    /* Make stdout buffer more responsive. */
+    setbuf(stdout, NULL);
+
+    unsigned char pk[SPX_PK_BYTES];
+    unsigned char sk[SPX_SK_BYTES];
+    unsigned char m[SPX_MLEN];
+    unsigned char *sig = malloc(SPX_BYTES);
+    uint8_t digest[SPX_PH_BYTES];
+    const uint8_t ctx[] = "test";
+    size_t siglen;
+
+    crypto_sign_keypair(pk, sk);
+    randombytes(m, SPX_MLEN);
+
+    printf("Testing pre-hash signatures.. ");
+    if (spx_sign_prehash(sig, &siglen, m, SPX_MLEN, ctx, 4, sk)) {
+        printf("failed!\n");
+        return -1;
+    }
+    spx_prehash(digest, m, SPX_MLEN);
+    if (spx_verify_prehash(sig, siglen, m, SPX_MLEN, ctx, 4, pk) ||
+            spx_verify_prehashed(sig, siglen, digest, ctx, 4, pk)) {
+        printf("  X does not verify!\n");
+        ret = -1;
+    }
+    if (!spx_verify_prehash(sig, siglen, m, SPX_MLEN, ctx, 3, pk)) {
+        printf("  X verifies under another context!\n");
+        ret = -1;
+    }
+    if (!crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X verifies as a pure signature!\n");
+        ret = -1;
+    }
+    m[0] ^= 1;
+    if (!spx_verify_prehash(sig, siglen, m, SPX_MLEN, ctx, 4, pk)) {
+        printf("  X modified message accepted!\n");
+        ret = -1;
+    }
+    if (!spx_sign_prehash(sig, &siglen, m, SPX_MLEN, ctx,
+                          SPX_PH_MAX_CTX + 1, sk)) {
+        printf("  X oversized context accepted!\n");
+        ret = -1;
+    }
+    printf("done.\n");
+
+    free(sig);
+
+    return ret;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../api.h"
+#include "../params.h"
+#include "../randombytes.h"
+#include "../sign_ctx.h"
+#include "../sign_stream.h"
+#include "../verify_stream.h"
+
+#define SPX_MLEN 32
+#define SPX_CHUNK 97
+
+typedef struct {
+    uint8_t *sig;
+    size_t len;
+} sig_buf;
+
+static int collect(void *arg, const uint8_t *data, size_t len)
+{
+    sig_buf *b = arg;
+
+    if (b->len + len > SPX_BYTES) {
+        return -1;
+    }
+    memcpy(b->sig + b->len, data, len);
+    b->len += len;
+    return 0;
+}
+
+/* Feeds R, the message and then the rest of sig in SPX_CHUNK byte pieces. */
+static int verify_streamed(const uint8_t *sig, size_t siglen,
+                           const uint8_t *m, size_t mlen, const uint8_t *pk)
+{
+    static spx_verify_state state;
+    size_t i;
+
+    spx_verify_init(&state, pk);
+    spx_verify_update_sig(&state, sig, SPX_N);
+    spx_verify_update_msg(&state, m, mlen / 2);
+    spx_verify_update_msg(&state, m + mlen / 2, mlen - mlen / 2);
+    for (i = SPX_N; i < siglen; i += SPX_CHUNK) {
+        size_t len = siglen - i < SPX_CHUNK ? siglen - i : SPX_CHUNK;
+        if (spx_verify_update_sig(&state, sig + i, len)) {
+            return -1;
+        }
+    }
+    return spx_verify_final(&state);
+}
+
+int main(void)
+{
+    int ret = 0;
+
+    /* Make stdout buffer more responsive. */
+    setbuf(stdout, NULL);
+
+    unsigned char pk[SPX_PK_BYTES];
+    unsigned char sk[SPX_SK_BYTES];
+    unsigned char m[SPX_MLEN];
+    unsigned char *sig = malloc(SPX_BYTES);
+    size_t siglen;
+    spx_sign_ctx sctx;
+    sig_buf b;
+
+    crypto_sign_keypair(pk, sk);
+    randombytes(m, SPX_MLEN);
+    spx_sign_ctx_init(&sctx, sk);
+
+    printf("Testing streamed signing.. ");
+    b.sig = malloc(SPX_BYTES);
+    b.len = 0;
+    if (spx_sign_stream(&sctx, m, SPX_MLEN, collect, &b) ||
+            b.len != SPX_BYTES) {
+        printf("failed!\n");
+        return -1;
+    }
+    if (crypto_sign_verify(b.sig, b.len, m, SPX_MLEN, pk)) {
+        printf("  X does not verify!\n");
+        ret = -1;
+    }
+    printf("done.\n");
+
+    printf("Testing streamed verification.. ");
+    crypto_sign_signature(sig, &siglen, m, SPX_MLEN, sk);
+    if (verify_streamed(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X valid signature rejected!\n");
+        ret = -1;
+    }
+    sig[SPX_N + SPX_FORS_BYTES + 3] ^= 1;
+    if (verify_streamed(sig, siglen, m, SPX_MLEN, pk) !=
+            crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk) ||
+            !verify_streamed(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X modified signature accepted!\n");
+        ret = -1;
+    }
+    sig[SPX_N + SPX_FORS_BYTES + 3] ^= 1;
+    m[SPX_MLEN - 1] ^= 1;
+    if (!verify_streamed(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X modified message accepted!\n");
+        ret = -1;
+    }
+    m[SPX_MLEN - 1] ^= 1;
+    if (!verify_streamed(sig, siglen - 1, m, SPX_MLEN, pk)) {
+        printf("  X truncated signature accepted!\n");
+        ret = -1;
+    }
+    printf("done.\n");
+
+    free(sig);
+    free(b.sig);
+
+    return ret;
+}
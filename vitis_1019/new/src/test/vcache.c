@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../api.h"
+#include "../params.h"
+#include "../randombytes.h"
+#include "../vcache.h"
+
+#define SPX_MLEN 32
+
+static spx_vcache cache;
+
+int main(void)
+{
+    int ret = 0;
+    uint32_t hits;
+
+    /* Make stdout buffer more responsive. */
+    setbuf(stdout, NULL);
+
+    unsigned char pk[SPX_PK_BYTES];
+    unsigned char sk[SPX_SK_BYTES];
+    unsigned char m[SPX_MLEN];
+    unsigned char *sig = malloc(SPX_BYTES);
+    size_t siglen;
+    size_t top = SPX_BYTES - SPX_TREE_HEIGHT * SPX_N;
+
+    randombytes(m, SPX_MLEN);
+    crypto_sign_keypair(pk, sk);
+    crypto_sign_signature(sig, &siglen, m, SPX_MLEN, sk);
+
+    spx_vcache_init(&cache);
+    spx_vcache_attach(&cache);
+
+    printf("Testing the verification cache.. \n");
+    if (crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk) || cache.hits) {
+        printf("  X first verification failed or hit!\n");
+        ret = -1;
+    }
+    if (crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk) || !cache.hits) {
+        printf("  X second verification failed or missed!\n");
+        ret = -1;
+    }
+    else {
+        printf("    repeated signature verifies from the cache.\n");
+    }
+
+    /* Changing a layer that a cached entry covers must not hit. */
+    hits = cache.hits;
+    sig[top] ^= 1;
+    if (!crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk) ||
+            cache.hits != hits) {
+        printf("  X modified top layer accepted or hit!\n");
+        ret = -1;
+    }
+    sig[top] ^= 1;
+
+    sig[SPX_N + SPX_FORS_BYTES] ^= 1;
+    if (!crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X modified bottom layer accepted!\n");
+        ret = -1;
+    }
+    sig[SPX_N + SPX_FORS_BYTES] ^= 1;
+
+    m[0] ^= 1;
+    if (!crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X modified message accepted!\n");
+        ret = -1;
+    }
+    m[0] ^= 1;
+    if (ret == 0) {
+        printf("    modified signatures are rejected.\n");
+    }
+
+    spx_vcache_attach(0);
+    free(sig);
+
+    return ret;
+}
@@ -6,6 +6,7 @@
 #include "params.h"
 #include "utils.h"
 #include "sha2.h"
+#include "hashtrace.h"
 
 #if SPX_SHA512
 static void thash_512(unsigned char *out, const unsigned char *in, unsigned int inblocks,
@@ -18,6 +19,8 @@ static void thash_512(unsigned char *out, const unsigned char *in, unsigned int
 void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
            const spx_ctx *ctx, uint32_t addr[8])
 {
+    SPX_TRACE_SITE(SPX_SITE_THASH);
+
 #if SPX_SHA512
     if (inblocks > 1) {
 	thash_512(out, in, inblocks, ctx, addr);
@@ -7,6 +7,7 @@
 #include "utils.h"
 
 #include "fips202.h"
+#include "hashtrace.h"
 
 /**
  * Takes an array of inblocks concatenated arrays of SPX_N bytes.
@@ -16,6 +17,7 @@ void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
 {
     SPX_VLA(uint8_t, buf, SPX_N + SPX_ADDR_BYTES + inblocks*SPX_N);
 
+    SPX_TRACE_SITE(SPX_SITE_THASH);
     memcpy(buf, ctx->pub_seed, SPX_N);
     memcpy(buf + SPX_N, addr, SPX_ADDR_BYTES);
     memcpy(buf + SPX_N + SPX_ADDR_BYTES, in, inblocks * SPX_N);
@@ -13,6 +13,12 @@
 /* Note: _malloca(), which is recommended over deprecated _alloca,
    requires that you call _freea(). So we stick with _alloca */ 
 # define SPX_VLA(__t,__x,__s) __t *__x = (__t*)_alloca((__s)*sizeof(__t))
+#elif defined(SPX_SCRATCH_ARENA)
+/* Buffers come from the scratch arena and go back at the end of the scope. */
+# include "scratch.h"
+# define SPX_VLA(__t,__x,__s) \
+    __t *__x __attribute__((cleanup(spx_scratch_release))) = \
+        (__t*)spx_scratch_alloc((__s)*sizeof(__t))
 #else
 # define SPX_VLA(__t,__x,__s) __t __x[__s]
 #endif
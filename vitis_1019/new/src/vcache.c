@@ -0,0 +1,109 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "vcache.h"
+#include "params.h"
+#include "utils.h"
+#include "hashtrace.h"
+
+#ifdef SPX_SHA2
+#include "sha2.h"
+#else
+#include "fips202.h"
+#endif
+
+static spx_vcache *attached_cache;
+
+/* Digest used for cache keys only; any collision-resistant hash will do. */
+static void vcache_hash(unsigned char *out, const unsigned char *in,
+                        size_t inlen)
+{
+    SPX_TRACE_SITE(SPX_SITE_VCACHE);
+#ifdef SPX_SHA2
+    unsigned char outbuf[SPX_SHA256_OUTPUT_BYTES];
+
+    sha256(outbuf, in, inlen);
+    memcpy(out, outbuf, SPX_N);
+#else
+    shake256(out, SPX_N, in, inlen);
+#endif
+}
+
+static uint32_t vcache_slot(const unsigned char *key)
+{
+    return (uint32_t)(key[0] | (key[1] << 8)) % SPX_VCACHE_ENTRIES;
+}
+
+void spx_vcache_init(spx_vcache *cache)
+{
+    memset(cache, 0, sizeof(spx_vcache));
+}
+
+void spx_vcache_attach(spx_vcache *cache)
+{
+    attached_cache = cache;
+}
+
+spx_vcache *spx_vcache_attached(void)
+{
+    return attached_cache;
+}
+
+void spx_vcache_digests(unsigned char digests[SPX_D][SPX_N],
+                        const unsigned char *sig_ht)
+{
+    const size_t layer_bytes = SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N;
+    unsigned char buf[2 * SPX_N];
+    int i;
+
+    /* Chain from the top layer down: digest_i = H(H(layer_i) || digest_i+1) */
+    for (i = SPX_D - 1; i >= 0; i--) {
+        vcache_hash(buf, sig_ht + (size_t)i * layer_bytes, layer_bytes);
+        if (i == SPX_D - 1) {
+            memset(buf + SPX_N, 0, SPX_N);
+        } else {
+            memcpy(buf + SPX_N, digests[i + 1], SPX_N);
+        }
+        vcache_hash(digests[i], buf, 2 * SPX_N);
+    }
+}
+
+void spx_vcache_key(unsigned char *key, const unsigned char *pk,
+                    uint32_t layer, uint64_t tree, uint32_t idx_leaf,
+                    const unsigned char *root_in,
+                    const unsigned char *digest)
+{
+    unsigned char buf[SPX_PK_BYTES + 16 + 2 * SPX_N];
+    unsigned char *p = buf;
+
+    memcpy(p, pk, SPX_PK_BYTES);
+    p += SPX_PK_BYTES;
+    u32_to_bytes(p, layer);
+    ull_to_bytes(p + 4, 8, tree);
+    u32_to_bytes(p + 12, idx_leaf);
+    p += 16;
+    memcpy(p, root_in, SPX_N);
+    memcpy(p + SPX_N, digest, SPX_N);
+
+    vcache_hash(key, buf, sizeof(buf));
+}
+
+int spx_vcache_lookup(spx_vcache *cache, const unsigned char *key)
+{
+    uint32_t slot = vcache_slot(key);
+
+    if (cache->valid[slot] && !memcmp(cache->key[slot], key, SPX_N)) {
+        cache->hits++;
+        return 1;
+    }
+    cache->misses++;
+    return 0;
+}
+
+void spx_vcache_insert(spx_vcache *cache, const unsigned char *key)
+{
+    uint32_t slot = vcache_slot(key);
+
+    memcpy(cache->key[slot], key, SPX_N);
+    cache->valid[slot] = 1;
+}
@@ -0,0 +1,68 @@
+#ifndef SPX_VCACHE_H
+#define SPX_VCACHE_H
+
+#include <stdint.h>
+
+#include "params.h"
+#include "context.h"
+
+/*
+ * Opt-in verification cache for signatures under a few long-lived keys.
+ *
+ * An entry records that, for a given public key, hypertree layer i of some
+ * signature (tree, idx_leaf, incoming root and the signature bytes of layers
+ * i..d-1) verified all the way up to the public root. When a later signature
+ * hits such an entry, the remaining layers are known to verify and are
+ * skipped. Since the key covers every remaining signature byte, accept and
+ * reject decisions are exactly those of the uncached verifier.
+ */
+#ifndef SPX_VCACHE_ENTRIES
+#define SPX_VCACHE_ENTRIES 256
+#endif
+
+typedef struct {
+    uint8_t key[SPX_VCACHE_ENTRIES][SPX_N];
+    uint8_t valid[SPX_VCACHE_ENTRIES];
+    uint32_t hits;
+    uint32_t misses;
+} spx_vcache;
+
+#define spx_vcache_init SPX_NAMESPACE(spx_vcache_init)
+void spx_vcache_init(spx_vcache *cache);
+
+/*
+ * Makes crypto_sign_verify() use cache (NULL turns caching off again).
+ */
+#define spx_vcache_attach SPX_NAMESPACE(spx_vcache_attach)
+void spx_vcache_attach(spx_vcache *cache);
+
+#define spx_vcache_attached SPX_NAMESPACE(spx_vcache_attached)
+spx_vcache *spx_vcache_attached(void);
+
+/*
+ * Computes, for every layer i, a digest of the hypertree part of the
+ * signature from layer i upwards. sig_ht points just past the FORS signature.
+ */
+#define spx_vcache_digests SPX_NAMESPACE(spx_vcache_digests)
+void spx_vcache_digests(unsigned char digests[SPX_D][SPX_N],
+                        const unsigned char *sig_ht);
+
+/*
+ * Derives the cache key for one layer transition.
+ */
+#define spx_vcache_key SPX_NAMESPACE(spx_vcache_key)
+void spx_vcache_key(unsigned char *key, const unsigned char *pk,
+                    uint32_t layer, uint64_t tree, uint32_t idx_leaf,
+                    const unsigned char *root_in,
+                    const unsigned char *digest);
+
+/*
+ * Returns 1 if key was recorded as known-good, 0 otherwise.
+ */
+#define spx_vcache_lookup SPX_NAMESPACE(spx_vcache_lookup)
+int spx_vcache_lookup(spx_vcache *cache, const unsigned char *key);
+
+#define spx_vcache_insert SPX_NAMESPACE(spx_vcache_insert)
+void spx_vcache_insert(spx_vcache *cache, const unsigned char *key);
+
+#endif
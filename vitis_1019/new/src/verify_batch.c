@@ -0,0 +1,198 @@
+#include <stddef.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "api.h"
+#include "params.h"
+#include "wots.h"
+#include "fors.h"
+#include "hash.h"
+#include "thash.h"
+#include "address.h"
+#include "utils.h"
+#include "sign_ctx.h"
+#include "hashdag.h"
+
+/* Number of signatures advanced in lock-step. */
+#ifndef SPX_VERIFY_BATCH
+#define SPX_VERIFY_BATCH 4
+#endif
+
+/*
+ * Per-group state. This is several WOTS public keys large, so it is kept out
+ * of the 8 KiB stack; crypto_sign_verify_batch() is therefore not reentrant.
+ */
+static struct {
+    spx_sign_ctx sctx[SPX_VERIFY_BATCH];
+    const unsigned char *sig[SPX_VERIFY_BATCH];
+    uint64_t tree[SPX_VERIFY_BATCH];
+    uint32_t idx_leaf[SPX_VERIFY_BATCH];
+    uint32_t wots_addr[SPX_VERIFY_BATCH][8];
+    unsigned char root[SPX_VERIFY_BATCH][SPX_N];
+    unsigned char leaf[SPX_VERIFY_BATCH][SPX_N];
+    unsigned char wots_pk[SPX_VERIFY_BATCH][SPX_WOTS_BYTES];
+    unsigned int lengths[SPX_VERIFY_BATCH][SPX_WOTS_LEN];
+    spx_root_walk walks[SPX_VERIFY_BATCH];
+    size_t slot[SPX_VERIFY_BATCH];
+} vb;
+
+/*
+ * Runs the WOTS chains of all g signatures on the current layer; chains of
+ * different signatures share the scheduler windows.
+ */
+static void batch_wots_chains(unsigned int g)
+{
+    SPX_VLA(spx_hash_node, nodes, SPX_DAG_WINDOW);
+    spx_hash_dag dag;
+    unsigned int total = g * SPX_WOTS_LEN;
+    unsigned int k = 0;
+    unsigned int first;
+
+    while (k < total) {
+        spx_dag_init(&dag, nodes, SPX_DAG_WINDOW);
+        for (first = k; k < total && k - first < SPX_DAG_WINDOW; k++) {
+            unsigned int s = k % g;
+            unsigned int i = k / g;
+            int idx;
+
+            set_chain_addr(vb.wots_addr[s], i);
+            idx = spx_dag_add_chain(&dag, vb.wots_pk[s] + i*SPX_N,
+                                    vb.sig[s] + i*SPX_N, vb.lengths[s][i],
+                                    SPX_WOTS_W - 1 - vb.lengths[s][i],
+                                    vb.wots_addr[s]);
+            dag.nodes[idx].ctx = &vb.sctx[s].hash;
+        }
+        spx_dag_run(&dag, 0);
+    }
+}
+
+/* Computes the leaf nodes of all g signatures from their WOTS public keys. */
+static void batch_leaves(unsigned int g)
+{
+    SPX_VLA(spx_hash_node, nodes, SPX_VERIFY_BATCH);
+    spx_hash_dag dag;
+    uint32_t wots_pk_addr[8];
+    unsigned int s;
+    int idx;
+
+    spx_dag_init(&dag, nodes, SPX_VERIFY_BATCH);
+    for (s = 0; s < g; s++) {
+        memset(wots_pk_addr, 0, sizeof(wots_pk_addr));
+        set_type(wots_pk_addr, SPX_ADDR_TYPE_WOTSPK);
+        copy_keypair_addr(wots_pk_addr, vb.wots_addr[s]);
+
+        idx = spx_dag_add(&dag, vb.leaf[s], vb.wots_pk[s], SPX_WOTS_LEN,
+                          wots_pk_addr);
+        dag.nodes[idx].ctx = &vb.sctx[s].hash;
+    }
+    spx_dag_run(&dag, 0);
+}
+
+/* Verifies g signatures whose indices were stored in vb.slot. */
+static void verify_group(unsigned int g,
+                         const uint8_t *const *sigs,
+                         const uint8_t *const *ms, const size_t *mlens,
+                         const uint8_t *const *pks, int *results)
+{
+    unsigned char mhash[SPX_FORS_MSG_BYTES];
+    uint32_t tree_addr[8];
+    unsigned int s, i;
+
+    for (s = 0; s < g; s++) {
+        size_t j = vb.slot[s];
+        const spx_ctx *ctx = &vb.sctx[s].hash;
+
+        spx_verify_ctx_init(&vb.sctx[s], pks[j]);
+        vb.sig[s] = sigs[j];
+
+        /* Derive the message digest and leaf index from R || PK || M. */
+        hash_message(mhash, &vb.tree[s], &vb.idx_leaf[s], vb.sig[s], pks[j],
+                     ms[j], mlens[j], ctx);
+        vb.sig[s] += SPX_N;
+
+        memset(vb.wots_addr[s], 0, sizeof(vb.wots_addr[s]));
+        set_type(vb.wots_addr[s], SPX_ADDR_TYPE_WOTS);
+        set_tree_addr(vb.wots_addr[s], vb.tree[s]);
+        set_keypair_addr(vb.wots_addr[s], vb.idx_leaf[s]);
+
+        fors_pk_from_sig(vb.root[s], vb.sig[s], mhash, ctx, vb.wots_addr[s]);
+        vb.sig[s] += SPX_FORS_BYTES;
+    }
+
+    for (i = 0; i < SPX_D; i++) {
+        for (s = 0; s < g; s++) {
+            set_layer_addr(vb.wots_addr[s], i);
+            set_tree_addr(vb.wots_addr[s], vb.tree[s]);
+            set_keypair_addr(vb.wots_addr[s], vb.idx_leaf[s]);
+            set_type(vb.wots_addr[s], SPX_ADDR_TYPE_WOTS);
+
+            chain_lengths(vb.lengths[s], vb.root[s]);
+        }
+
+        /* The WOTS public keys are only correct if the signatures were. */
+        batch_wots_chains(g);
+
+        /* Compute the leaf nodes using the WOTS public keys. */
+        batch_leaves(g);
+
+        /* Compute the root nodes of these subtrees. */
+        for (s = 0; s < g; s++) {
+            vb.sig[s] += SPX_WOTS_BYTES;
+
+            memset(tree_addr, 0, sizeof(tree_addr));
+            set_layer_addr(tree_addr, i);
+            set_tree_addr(tree_addr, vb.tree[s]);
+            set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
+
+            spx_root_walk_init(&vb.walks[s], vb.root[s], vb.leaf[s],
+                               vb.idx_leaf[s], 0, vb.sig[s],
+                               &vb.sctx[s].hash, tree_addr);
+            vb.sig[s] += SPX_TREE_HEIGHT * SPX_N;
+        }
+        spx_root_walks(vb.walks, g, SPX_TREE_HEIGHT);
+
+        /* Update the indices for the next layer. */
+        for (s = 0; s < g; s++) {
+            vb.idx_leaf[s] = (vb.tree[s] & ((1 << SPX_TREE_HEIGHT)-1));
+            vb.tree[s] = vb.tree[s] >> SPX_TREE_HEIGHT;
+        }
+    }
+
+    /* Check if the root nodes equal the root nodes in the public keys. */
+    for (s = 0; s < g; s++) {
+        size_t j = vb.slot[s];
+
+        results[j] = memcmp(vb.root[s], pks[j] + SPX_N, SPX_N) ? -1 : 0;
+    }
+}
+
+int crypto_sign_verify_batch(const uint8_t *const *sigs, const size_t *siglens,
+                             const uint8_t *const *ms, const size_t *mlens,
+                             const uint8_t *const *pks, size_t n,
+                             int *results)
+{
+    unsigned int g = 0;
+    size_t j;
+    int ret = 0;
+
+    for (j = 0; j < n; j++) {
+        if (siglens[j] != SPX_BYTES) {
+            results[j] = -1;
+        }
+        else {
+            vb.slot[g++] = j;
+        }
+        if (g == SPX_VERIFY_BATCH || (j == n - 1 && g > 0)) {
+            verify_group(g, sigs, ms, mlens, pks, results);
+            g = 0;
+        }
+    }
+
+    for (j = 0; j < n; j++) {
+        if (results[j]) {
+            ret = -1;
+        }
+    }
+
+    return ret;
+}
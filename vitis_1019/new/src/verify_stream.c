@@ -0,0 +1,145 @@
+#include <stddef.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "params.h"
+#include "fors.h"
+#include "hash.h"
+#include "address.h"
+#include "merkle.h"
+#include "verify_stream.h"
+
+#define STREAM_PHASE_R 0
+#define STREAM_PHASE_MSG 1
+#define STREAM_PHASE_SIG 2
+#define STREAM_PHASE_FAILED 3
+
+/* Unit 0 is R, units 1..k the FORS trees, then the hypertree layers. */
+#define STREAM_UNITS (1 + SPX_FORS_TREES + SPX_D)
+
+static size_t unit_bytes(unsigned int unit)
+{
+    if (unit == 0) {
+        return SPX_N;
+    }
+    if (unit <= SPX_FORS_TREES) {
+        return (SPX_FORS_HEIGHT + 1) * SPX_N;
+    }
+    return SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N;
+}
+
+static void process_unit(spx_verify_state *state, const unsigned char *data)
+{
+    const spx_ctx *ctx = &state->sctx.hash;
+    unsigned int unit = state->unit;
+    uint32_t layer;
+
+    if (unit == 0) {
+        hash_message_init(&state->hmsg, data, state->sctx.pk, ctx);
+        state->phase = STREAM_PHASE_MSG;
+        state->unit++;
+        return;
+    }
+
+    if (state->phase == STREAM_PHASE_MSG) {
+        /* The rest of the signature has started: the message is complete. */
+        hash_message_final(state->mhash, &state->tree, &state->idx_leaf,
+                           &state->hmsg, ctx);
+
+        memset(state->fors_addr, 0, sizeof(state->fors_addr));
+        set_type(state->fors_addr, SPX_ADDR_TYPE_WOTS);
+        set_tree_addr(state->fors_addr, state->tree);
+        set_keypair_addr(state->fors_addr, state->idx_leaf);
+        state->phase = STREAM_PHASE_SIG;
+    }
+
+    if (unit <= SPX_FORS_TREES) {
+        fors_tree_root_from_sig(state->fors_roots + (unit - 1) * SPX_N, data,
+                                state->mhash, unit - 1, ctx,
+                                state->fors_addr);
+        if (unit == SPX_FORS_TREES) {
+            fors_pk_from_roots(state->root, state->fors_roots, ctx,
+                               state->fors_addr);
+        }
+    }
+    else {
+        layer = unit - 1 - SPX_FORS_TREES;
+        merkle_root_from_sig(state->root, data, state->root, ctx,
+                             layer, state->tree, state->idx_leaf);
+
+        /* Update the indices for the next layer. */
+        state->idx_leaf = (state->tree & ((1 << SPX_TREE_HEIGHT)-1));
+        state->tree = state->tree >> SPX_TREE_HEIGHT;
+    }
+    state->unit++;
+}
+
+void spx_verify_init(spx_verify_state *state, const uint8_t *pk)
+{
+    spx_verify_ctx_init(&state->sctx, pk);
+    state->unit = 0;
+    state->phase = STREAM_PHASE_R;
+    state->buflen = 0;
+}
+
+int spx_verify_update_msg(spx_verify_state *state,
+                          const uint8_t *m, size_t mlen)
+{
+    if (state->phase != STREAM_PHASE_MSG) {
+        return -1;
+    }
+    hash_message_update(&state->hmsg, m, mlen);
+
+    return 0;
+}
+
+int spx_verify_update_sig(spx_verify_state *state,
+                          const uint8_t *chunk, size_t len)
+{
+    size_t need;
+
+    while (len > 0) {
+        if (state->phase == STREAM_PHASE_FAILED ||
+                state->unit == STREAM_UNITS) {
+            state->phase = STREAM_PHASE_FAILED;
+            return -1;
+        }
+        need = unit_bytes(state->unit) - state->buflen;
+
+        /* A unit that is complete in the chunk is used in place. */
+        if (state->buflen == 0 && len >= need) {
+            process_unit(state, chunk);
+        }
+        else {
+            if (need > len) {
+                need = len;
+            }
+            memcpy(state->buf + state->buflen, chunk, need);
+            state->buflen += need;
+            if (state->buflen < unit_bytes(state->unit)) {
+                return 0;
+            }
+            process_unit(state, state->buf);
+            state->buflen = 0;
+        }
+        chunk += need;
+        len -= need;
+    }
+
+    return 0;
+}
+
+int spx_verify_final(spx_verify_state *state)
+{
+    if (state->phase == STREAM_PHASE_FAILED ||
+            state->unit != STREAM_UNITS) {
+        return -1;
+    }
+
+    /* Check if the root node equals the root node in the public key. */
+    if (memcmp(state->root, state->sctx.pk + SPX_N, SPX_N)) {
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#ifndef SPX_VERIFY_STREAM_H
+#define SPX_VERIFY_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "params.h"
+#include "context.h"
+#include "hash.h"
+#include "sign_ctx.h"
+
+/*
+ * Streaming verifier for signatures that arrive over a slow link.
+ *
+ * The signature is consumed in units: R, then every FORS tree, then every
+ * hypertree layer. Each unit is processed as soon as its last byte arrives,
+ * so at most one unit is buffered and verification overlaps the transfer.
+ *
+ * Since the message digest is H(R || PK || M), the expected order is:
+ *   spx_verify_update_sig()   at least the first SPX_N bytes (R)
+ *   spx_verify_update_msg()   the whole message, in any number of pieces
+ *   spx_verify_update_sig()   the rest of the signature, in any pieces
+ *   spx_verify_final()
+ * The message is closed by the first signature byte after R; bytes that
+ * follow R in the same chunk close it as well.
+ *
+ * The state is a few KiB (one hypertree layer plus the FORS roots); keep it
+ * out of the stack on the board.
+ */
+#define SPX_VERIFY_UNIT_BYTES (SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N)
+
+typedef struct {
+    spx_sign_ctx sctx;
+    spx_hmsg_state hmsg;
+    unsigned char mhash[SPX_FORS_MSG_BYTES];
+    unsigned char fors_roots[SPX_FORS_TREES * SPX_N];
+    unsigned char root[SPX_N];
+    uint64_t tree;
+    uint32_t idx_leaf;
+    uint32_t fors_addr[8];
+    unsigned int unit;      /* units done: R, FORS trees, layers */
+    int phase;
+    unsigned char buf[SPX_VERIFY_UNIT_BYTES];
+    size_t buflen;
+} spx_verify_state;
+
+#define spx_verify_init SPX_NAMESPACE(spx_verify_init)
+void spx_verify_init(spx_verify_state *state, const uint8_t *pk);
+
+/*
+ * Absorbs part of the message. Returns -1 if R has not been received yet or
+ * the message has already been closed, 0 otherwise.
+ */
+#define spx_verify_update_msg SPX_NAMESPACE(spx_verify_update_msg)
+int spx_verify_update_msg(spx_verify_state *state,
+                          const uint8_t *m, size_t mlen);
+
+/*
+ * Consumes the next len signature bytes. Returns -1 once more than
+ * SPX_BYTES signature bytes have been supplied, 0 otherwise.
+ */
+#define spx_verify_update_sig SPX_NAMESPACE(spx_verify_update_sig)
+int spx_verify_update_sig(spx_verify_state *state,
+                          const uint8_t *chunk, size_t len);
+
+/*
+ * Returns 0 if exactly SPX_BYTES signature bytes were supplied and they form
+ * a valid signature on the message, -1 otherwise (as crypto_sign_verify()).
+ */
+#define spx_verify_final SPX_NAMESPACE(spx_verify_final)
+int spx_verify_final(spx_verify_state *state);
+
+#endif
@@ -9,6 +9,7 @@
 #include "wotsx1.h"
 #include "address.h"
 #include "params.h"
+#include "hashdag.h"
 
 // TODO clarify address expectations, and make them more uniform.
 // TODO i.e. do we expect types to be set already?
@@ -90,6 +91,68 @@ void chain_lengths(unsigned int *lengths, const unsigned char *msg)
     wots_checksum(lengths + SPX_WOTS_LEN1, lengths);
 }
 
+/* Computes the signature value of one chain; see wots.h. */
+void wots_sign_chain(unsigned char *sig, const unsigned int *lengths,
+                     uint32_t chain, const spx_ctx *ctx, uint32_t addr[8])
+{
+    unsigned char sk[SPX_N];
+
+    set_chain_addr(addr, chain);
+    set_hash_addr(addr, 0);
+    set_type(addr, SPX_ADDR_TYPE_WOTSPRF);
+    prf_addr(sk, ctx, addr);
+
+    set_type(addr, SPX_ADDR_TYPE_WOTS);
+    gen_chain(sig, sk, 0, lengths[chain], ctx, addr);
+}
+
+/**
+ * Takes an n-byte message and computes a WOTS signature that is placed at
+ * 'sig', deriving the chain secrets from the sk_seed in ctx.
+ *
+ * Expects addr to contain the layer, tree and keypair of the WOTS key; the
+ * chain, hash and type fields are overwritten.  Used when the Merkle tree
+ * around the key does not need to be rebuilt (e.g. a precomputed layer).
+ */
+void wots_sign(unsigned char *sig, const unsigned char *msg,
+               const spx_ctx *ctx, uint32_t addr[8])
+{
+    unsigned int lengths[SPX_WOTS_LEN];
+    uint32_t i;
+
+    chain_lengths(lengths, msg);
+
+    for (i = 0; i < SPX_WOTS_LEN; i++) {
+        wots_sign_chain(sig + i*SPX_N, lengths, i, ctx, addr);
+    }
+}
+
+/**
+ * Runs every chain from position start[i] (0 if start is NULL) to the end,
+ * reading the chain values from 'in' and writing the last ones to 'out'.
+ */
+void wots_chains(unsigned char *out, const unsigned char *in,
+                 const unsigned int *start,
+                 const spx_ctx *ctx, uint32_t addr[8])
+{
+    SPX_VLA(spx_hash_node, nodes, SPX_DAG_WINDOW);
+    spx_hash_dag dag;
+    unsigned int first;
+    uint32_t i;
+
+    for (i = 0; i < SPX_WOTS_LEN; ) {
+        spx_dag_init(&dag, nodes, SPX_DAG_WINDOW);
+        for (first = i; i < SPX_WOTS_LEN && i - first < SPX_DAG_WINDOW; i++) {
+            unsigned int pos = start ? start[i] : 0;
+
+            set_chain_addr(addr, i);
+            spx_dag_add_chain(&dag, out + i*SPX_N, in + i*SPX_N,
+                              pos, SPX_WOTS_W - 1 - pos, addr);
+        }
+        spx_dag_run(&dag, ctx);
+    }
+}
+
 /**
  * Takes a WOTS signature and an n-byte message, computes a WOTS public key.
  *
@@ -100,13 +163,8 @@ void wots_pk_from_sig(unsigned char *pk,
                       const spx_ctx *ctx, uint32_t addr[8])
 {
     unsigned int lengths[SPX_WOTS_LEN];
-    uint32_t i;
 
     chain_lengths(lengths, msg);
 
-    for (i = 0; i < SPX_WOTS_LEN; i++) {
-        set_chain_addr(addr, i);
-        gen_chain(pk + i*SPX_N, sig + i*SPX_N,
-                  lengths[i], SPX_WOTS_W - 1 - lengths[i], ctx, addr);
-    }
+    wots_chains(pk, sig, lengths, ctx, addr);
 }
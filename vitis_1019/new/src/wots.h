@@ -6,6 +6,23 @@
 #include "params.h"
 #include "context.h"
 
+/**
+ * Takes an n-byte message and computes the WOTS signature of the key pair
+ * selected by addr, without building the surrounding Merkle tree.
+ */
+#define wots_sign SPX_NAMESPACE(wots_sign)
+void wots_sign(unsigned char *sig, const unsigned char *msg,
+               const spx_ctx *ctx, uint32_t addr[8]);
+
+/**
+ * Computes the signature value of a single chain (SPX_N bytes at 'sig');
+ * lengths is the output of chain_lengths() for the message. wots_sign() is
+ * this for every chain.
+ */
+#define wots_sign_chain SPX_NAMESPACE(wots_sign_chain)
+void wots_sign_chain(unsigned char *sig, const unsigned int *lengths,
+                     uint32_t chain, const spx_ctx *ctx, uint32_t addr[8]);
+
 /**
  * Takes a WOTS signature and an n-byte message, computes a WOTS public key.
  *
@@ -16,6 +33,17 @@ void wots_pk_from_sig(unsigned char *pk,
                       const unsigned char *sig, const unsigned char *msg,
                       const spx_ctx *ctx, uint32_t addr[8]);
 
+/**
+ * Runs chain i from position start[i] (0 if start is NULL) to the top, for
+ * all SPX_WOTS_LEN chains; out and in are SPX_WOTS_BYTES and may coincide.
+ * The chains are independent and go through the hash-call scheduler.
+ * Expects addr to contain the keypair address with type SPX_ADDR_TYPE_WOTS.
+ */
+#define wots_chains SPX_NAMESPACE(wots_chains)
+void wots_chains(unsigned char *out, const unsigned char *in,
+                 const unsigned int *start,
+                 const spx_ctx *ctx, uint32_t addr[8]);
+
 /*
  * Compute the chain lengths needed for a given message hash
  */
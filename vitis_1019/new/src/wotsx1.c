@@ -21,7 +21,7 @@ void wots_gen_leafx1(unsigned char *dest,
     uint32_t *leaf_addr = info->leaf_addr;
     uint32_t *pk_addr = info->pk_addr;
     unsigned int i, k;
-    unsigned char pk_buffer[ SPX_WOTS_BYTES ];
+    SPX_VLA(unsigned char, pk_buffer, SPX_WOTS_BYTES);
     unsigned char *buffer;
     uint32_t wots_k_mask;
 
@@ -37,6 +37,23 @@ void wots_gen_leafx1(unsigned char *dest,
     set_keypair_addr( leaf_addr, leaf_idx );
     set_keypair_addr( pk_addr, leaf_idx );
 
+    if (wots_k_mask) {
+        /* No signature to capture: derive all secrets, then hand the */
+        /* independent chains to the scheduler in one go */
+        for (i = 0, buffer = pk_buffer; i < SPX_WOTS_LEN; i++, buffer += SPX_N) {
+            set_chain_addr(leaf_addr, i);
+            set_hash_addr(leaf_addr, 0);
+            set_type(leaf_addr, SPX_ADDR_TYPE_WOTSPRF);
+
+            prf_addr(buffer, ctx, leaf_addr);
+        }
+        set_type(leaf_addr, SPX_ADDR_TYPE_WOTS);
+        wots_chains(pk_buffer, pk_buffer, 0, ctx, leaf_addr);
+
+        thash(dest, pk_buffer, SPX_WOTS_LEN, ctx, pk_addr);
+        return;
+    }
+
     for (i = 0, buffer = pk_buffer; i < SPX_WOTS_LEN; i++, buffer += SPX_N) {
         uint32_t wots_k = info->wots_steps[i] | wots_k_mask; /* Set wots_k to */
             /* the step if we're generating a signature, ~0 if we're not */